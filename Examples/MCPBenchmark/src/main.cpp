@@ -0,0 +1,193 @@
+/**
+ * @file main.cpp
+ * @brief MCP性能基准程序
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include "IMCPServer.h"
+#include "IMCPResourceService.h"
+#include "MCPBase64Encoder.h"
+#include "MCPResourceUpdatedParams.h"
+
+/**
+ * @brief 资源更新通知代价基准
+ *
+ * 对不同大小的文件资源，分别测量两种 notifications/resources/updated 的构建和序列化耗时：
+ * - 仅URI（默认模式）：{"method", "params": {"uri"}}
+ * - 内联内容（resourceUpdateInlineContent=true）：每次变化都 resources/read 并把内容放进通知
+ *
+ * 参数由资源通知处理器使用的 MCPResourceUpdatedParams 构建。内联模式首次读取未命中内容缓存，
+ * 单独统计；之后的迭代由缓存提供编码结果，只反映构建和序列化的代价。
+ * 二进制资源需要Base64编码，内联模式的代价随资源大小线性增长，仅URI模式与资源大小无关。
+ */
+static void benchResourceUpdatedNotification(IMCPResourceService* pResourceService, const QString& strDir, QTextStream& out)
+{
+    const int arrSizes[] = { 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024 };
+    const int nIterations = 20;
+
+    out << "notifications/resources/updated cost (" << nIterations << " iterations each)\n";
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+        .arg("size", 10).arg("uri-only us", 14).arg("uri-only B", 12)
+        .arg("inline 1st us", 14).arg("inline us", 14).arg("inline B", 12);
+
+    for (int nSize : arrSizes)
+    {
+        // 生成二进制文件资源
+        QString strFilePath = QString("%1/bench_%2.bin").arg(strDir).arg(nSize);
+        QFile file(strFilePath);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            out << "cannot create " << strFilePath << "\n";
+            continue;
+        }
+        QByteArray data(nSize, Qt::Uninitialized);
+        for (int i = 0; i < nSize; ++i)
+        {
+            data[i] = static_cast<char>((i * 131) & 0xFF);
+        }
+        file.write(data);
+        file.close();
+
+        QString strUri = QString("file:///bench/%1.bin").arg(nSize);
+        pResourceService->add(strUri, strUri, "benchmark resource", strFilePath, "application/octet-stream");
+
+        // 元数据与 resources/list 中的条目一致
+        QJsonObject metadata;
+        for (const QJsonValue& value : pResourceService->list(strUri))
+        {
+            if (value.toObject().value("uri").toString() == strUri)
+            {
+                metadata = value.toObject();
+                break;
+            }
+        }
+
+        auto buildNotificationSize = [&](bool bInlineContent)
+        {
+            QJsonObject notification;
+            notification["method"] = "notifications/resources/updated";
+            notification["params"] = MCPResourceUpdatedParams::build(pResourceService, strUri, metadata, bInlineContent);
+            return QJsonDocument(notification).toJson(QJsonDocument::Compact).size();
+        };
+
+        // 仅URI
+        QElapsedTimer timer;
+        qint64 nUriOnlyBytes = 0;
+        timer.start();
+        for (int i = 0; i < nIterations; ++i)
+        {
+            nUriOnlyBytes = buildNotificationSize(false);
+        }
+        double dUriOnlyUs = timer.nsecsElapsed() / 1000.0 / nIterations;
+
+        // 内联内容：首次读取文件并编码
+        qint64 nInlineBytes = 0;
+        timer.restart();
+        nInlineBytes = buildNotificationSize(true);
+        double dInlineFirstUs = timer.nsecsElapsed() / 1000.0;
+
+        // 内联内容：后续迭代命中内容缓存
+        timer.restart();
+        for (int i = 0; i < nIterations; ++i)
+        {
+            nInlineBytes = buildNotificationSize(true);
+        }
+        double dInlineUs = timer.nsecsElapsed() / 1000.0 / nIterations;
+
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+            .arg(nSize, 10).arg(dUriOnlyUs, 14, 'f', 1).arg(nUriOnlyBytes, 12)
+            .arg(dInlineFirstUs, 14, 'f', 1).arg(dInlineUs, 14, 'f', 1).arg(nInlineBytes, 12);
+        out.flush();
+
+        pResourceService->remove(strUri);
+    }
+}
+
+/**
+ * @brief Base64编码基准
+ *
+ * 对比QByteArray::toBase64()（标量，每次分配输出）与MCPBase64Encoder（SIMD，写入预分配缓冲区）的吞吐量，
+ * 并逐字节校验两者输出一致。
+ */
+static void benchBase64Encoder(QTextStream& out)
+{
+    const int arrSizes[] = { 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024 };
+    const qint64 nTargetBytes = 256 * 1024 * 1024;
+
+    out << "\nbase64 encode throughput (backend: " << MCPBase64Encoder::getBackendName() << ")\n";
+    out << QString("%1 %2 %3 %4 %5\n")
+        .arg("size", 10).arg("iterations", 12).arg("Qt MB/s", 12).arg("MCP MB/s", 12).arg("match", 8);
+
+    for (int nSize : arrSizes)
+    {
+        QByteArray data(nSize, Qt::Uninitialized);
+        for (int i = 0; i < nSize; ++i)
+        {
+            data[i] = static_cast<char>((i * 131 + (i >> 7)) & 0xFF);
+        }
+        const int nIterations = static_cast<int>(qMax<qint64>(1, nTargetBytes / nSize));
+
+        // Qt实现
+        QElapsedTimer timer;
+        qint64 nQtChecksum = 0;
+        timer.start();
+        for (int i = 0; i < nIterations; ++i)
+        {
+            QByteArray encoded = data.toBase64();
+            nQtChecksum += encoded.at(i % encoded.size());
+        }
+        const qint64 nQtNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+        // SIMD实现，输出缓冲区只分配一次
+        QByteArray arrBuffer(static_cast<int>(MCPBase64Encoder::encodedSize(nSize)), Qt::Uninitialized);
+        qint64 nMcpChecksum = 0;
+        timer.restart();
+        for (int i = 0; i < nIterations; ++i)
+        {
+            MCPBase64Encoder::encode(data.constData(), nSize, arrBuffer.data());
+            nMcpChecksum += arrBuffer.at(i % arrBuffer.size());
+        }
+        const qint64 nMcpNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+        const bool bMatch = (arrBuffer == data.toBase64()) && (nQtChecksum == nMcpChecksum);
+        const double dTotalMb = static_cast<double>(nSize) * nIterations / (1024.0 * 1024.0);
+        out << QString("%1 %2 %3 %4 %5\n")
+            .arg(nSize, 10).arg(nIterations, 12)
+            .arg(dTotalMb * 1e9 / nQtNs, 12, 'f', 1)
+            .arg(dTotalMb * 1e9 / nMcpNs, 12, 'f', 1)
+            .arg(bMatch ? "yes" : "NO", 8);
+        out.flush();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("MCPBenchmark");
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid())
+    {
+        return 1;
+    }
+
+    // 服务器不启动，资源服务在当前线程直接执行
+    IMCPServer* pServer = IMCPServer::createServer();
+    QTextStream out(stdout);
+
+    benchResourceUpdatedNotification(pServer->getResourceService(), tempDir.path(), out);
+    benchBase64Encoder(out);
+
+    IMCPServer::destroyServer(pServer);
+    return 0;
+}
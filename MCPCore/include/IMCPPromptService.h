@@ -101,6 +101,25 @@ public:
      */
     virtual QJsonArray list() const = 0;
     
+    /**
+     * @brief 批量修改提示词
+     * @param fun 批量操作，在服务线程中一次执行，内部调用add/remove等方法时不再逐个跨线程调用
+     * 
+     * 期间的所有注册/注销只发送一次 notifications/prompts/list_changed
+     * 
+     * 使用示例：
+     * @code
+     * pPromptService->batchUpdate([&]()
+     * {
+     *     for (const QJsonObject& jsonPrompt : lstPrompts)
+     *     {
+     *         pPromptService->addFromJson(jsonPrompt);
+     *     }
+     * });
+     * @endcode
+     */
+    virtual void batchUpdate(const std::function<void()>& fun) = 0;
+    
     /**
      * @brief 获取提示词内容
      * @param strName 提示词名称
@@ -12,6 +12,7 @@
 #include <QString>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QMap>
 #include <functional>
 
 /**
@@ -105,6 +106,27 @@ public:
      */
     virtual QJsonArray list(const QString& strUriPrefix = QString()) const = 0;
     
+    /**
+     * @brief 批量修改资源
+     * @param fun 批量操作，在服务线程中一次执行，内部调用add/remove等方法时不再逐个跨线程调用
+     * 
+     * 期间的所有注册/注销只发送一次 notifications/resources/list_changed；
+     * 新注册资源的内容变化通知在结束时统一发送，且只针对有订阅者的URI
+     * 
+     * 使用示例：
+     * @code
+     * pResourceService->batchUpdate([&]()
+     * {
+     *     for (const QFileInfo& fileInfo : QDir(strDir).entryInfoList(QDir::Files))
+     *     {
+     *         pResourceService->add(QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString(),
+     *                               fileInfo.fileName(), QString(), fileInfo.absoluteFilePath());
+     *     }
+     * });
+     * @endcode
+     */
+    virtual void batchUpdate(const std::function<void()>& fun) = 0;
+    
     /**
      * @brief 读取资源内容
      * @param strUri 资源URI
@@ -124,8 +146,9 @@ public:
      *   "name": "资源名称",
      *   "description": "资源描述",
      *   "mimeType": "MIME类型（可选，默认text/plain）",
-     *   "type": "资源类型：file/wrapper/content（可选，默认content）",
+     *   "type": "资源类型：file/wrapper/content/directory（可选，默认content）",
      *   "filePath": "文件路径（file类型必需）",
+     *   "directoryPath": "目录路径（directory类型必需，uri作为URI前缀）",
      *   "content": "静态内容（content类型必需）",
      *   "handlerName": "Handler名称（wrapper类型必需）",
      *   "annotations": { ... }（可选）
@@ -143,6 +166,70 @@ public:
      */
     virtual bool addFromJson(const QJsonObject& jsonResource, QObject* pSearchRoot = nullptr) = 0;
     
+    /**
+     * @brief 注册资源模板（RFC 6570 URI模板）
+     * @param strUriTemplate URI模板，例如 "db://table/{id}"、"file:///logs/{+path}"、"search://items{?q,limit}"
+     * @param strName 模板名称
+     * @param strDescription 模板描述
+     * @param strMimeType MIME类型
+     * @param contentProvider 内容提供函数，参数为从URI中解析出的变量（已做百分号解码）
+     * @return true表示注册成功，false表示模板语法错误或与已有模板冲突
+     * 
+     * resources/read 的URI没有对应的已注册资源时按模板匹配，多个模板匹配时字面部分最长的优先。
+     * 
+     * 使用示例：
+     * @code
+     * pResourceService->addTemplate("db://table/{id}", "Table Row", "A row by id", "application/json",
+     *     [](const QMap<QString, QString>& dictVariables) -> QString
+     *     {
+     *         return loadRowAsJson(dictVariables.value("id"));
+     *     });
+     * @endcode
+     */
+    virtual bool addTemplate(const QString& strUriTemplate,
+                             const QString& strName,
+                             const QString& strDescription,
+                             const QString& strMimeType,
+                             std::function<QString(const QMap<QString, QString>&)> contentProvider) = 0;
+    
+    /**
+     * @brief 注销资源模板
+     * @param strUriTemplate URI模板（与注册时一致）
+     * @return true表示注销成功，false表示不存在
+     */
+    virtual bool removeTemplate(const QString& strUriTemplate) = 0;
+    
+    /**
+     * @brief 获取资源模板列表
+     * @return 资源模板列表（resources/templates/list格式）
+     */
+    virtual QJsonArray listTemplates() const = 0;
+    
+    /**
+     * @brief 将目录子树挂载为资源
+     * @param strUriPrefix URI前缀，前缀加上文件的相对路径即文件的资源URI（不以'/'结尾时自动补上）
+     * @param strDirectoryPath 目录路径
+     * @return true表示挂载成功，false表示目录不存在或前缀已挂载
+     * 
+     * 不为每个文件创建资源对象，注册时不遍历目录：resources/list 翻页时才列出经过的目录，
+     * resources/read 时才打开文件；列出过的目录和读取过的文件通过文件系统监听发送变化通知。
+     * 同一URI已单独注册资源时，单独注册的资源优先。
+     * 
+     * 使用示例：
+     * @code
+     * pResourceService->addDirectory("file:///project/", "/home/user/project");
+     * // 读取 file:///project/src/main.cpp 即读取 /home/user/project/src/main.cpp
+     * @endcode
+     */
+    virtual bool addDirectory(const QString& strUriPrefix, const QString& strDirectoryPath) = 0;
+    
+    /**
+     * @brief 取消目录挂载
+     * @param strUriPrefix URI前缀（与挂载时一致）
+     * @return true表示取消成功，false表示不存在
+     */
+    virtual bool removeDirectory(const QString& strUriPrefix) = 0;
+    
 signals:
     /**
      * @brief 资源列表变化信号
@@ -9,6 +9,7 @@
 #pragma once
 #include <QObject>
 #include <QString>
+#include <QJsonObject>
 #include "MCPCore_global.h.h"
 
 class IMCPServerConfig;
@@ -73,6 +74,21 @@ public:
      */
     virtual bool isRunning() = 0;
 
+    /**
+     * @brief 获取运行统计
+     * @return 统计信息（JSON对象），格式如下：
+     * @code
+     * {
+     *   "sessions": { "liveSessions": 3, "evictedSessions": 12, "idleEvictedSessions": 10, "disconnectEvictedSessions": 2, ... },
+     *   "outbound": { "totalQueuedBytes": 0, "totalQueuedFrames": 0, "backpressuredConnections": 0, "connections": [...] }
+     * }
+     * @endcode
+     * 
+     * sessions 为当前会话数和累计淘汰的会话数（空闲超时、SSE断开），outbound 为各连接出站队列的深度、峰值和合并次数。
+     * 可在任意线程调用，统计在所属线程内读取。
+     */
+    virtual QJsonObject getStatistics() = 0;
+
 public:
     /**
      * @brief 获取配置对象
@@ -83,6 +83,69 @@ public:
     virtual void setInstructions(const QString& strInstructions) = 0;
     virtual QString getInstructions() const = 0;
     
+    /**
+     * @brief 会话空闲超时（毫秒），超过该时间没有任何请求的会话会被移除，0表示不淘汰
+     */
+    virtual void setSessionIdleTimeout(qint64 nTimeoutMs) = 0;
+    virtual qint64 getSessionIdleTimeout() const = 0;
+    
+    /**
+     * @brief 每个会话待发送资源变化通知的URI上限，超出后合并为一条resources/list_changed，0表示不限制
+     */
+    virtual void setSessionMaxPendingUris(int nMaxUris) = 0;
+    virtual int getSessionMaxPendingUris() const = 0;
+    
+    /**
+     * @brief 资源变化通知的全局合并窗口（毫秒），窗口内同一资源的多次变化只通知一次，0表示立即通知
+     */
+    virtual void setResourceNotifyDebounce(int nDebounceMs) = 0;
+    virtual int getResourceNotifyDebounce() const = 0;
+    
+    /**
+     * @brief notifications/resources/updated 是否内联资源内容
+     *
+     * 默认false：按MCP规范只携带uri，客户端收到后自行调用resources/read；
+     * 设为true时携带完整的资源内容和元数据（每次变化都要读取资源，大文件代价很高）
+     */
+    virtual void setResourceUpdateInlineContent(bool bInline) = 0;
+    virtual bool isResourceUpdateInlineContent() const = 0;
+    
+    /**
+     * @brief 文件资源内容缓存的内存预算（字节），按LRU淘汰，0表示不缓存
+     */
+    virtual void setFileContentCacheBytes(int nMaxBytes) = 0;
+    virtual int getFileContentCacheBytes() const = 0;
+    
+    /**
+     * @brief 文件资源流式发送阈值（字节），不小于该值的文件读取时不进入内存，发送响应时通过mmap直接编码，0表示不流式发送
+     */
+    virtual void setFileStreamThreshold(qint64 nThresholdBytes) = 0;
+    virtual qint64 getFileStreamThreshold() const = 0;
+    
+    /**
+     * @brief tools/list、resources/list、prompts/list 每页的条目数，超出时返回nextCursor分页，0表示不分页
+     */
+    virtual void setListPageSize(int nPageSize) = 0;
+    virtual int getListPageSize() const = 0;
+    
+    /**
+     * @brief 连接出站高水位（字节），套接字待写数据超过该值后新消息进入出站队列，0表示不排队
+     */
+    virtual void setOutboundHighWatermark(qint64 nBytes) = 0;
+    virtual qint64 getOutboundHighWatermark() const = 0;
+    
+    /**
+     * @brief 连接出站低水位（字节），待写数据回落到该值后继续写出排队消息
+     */
+    virtual void setOutboundLowWatermark(qint64 nBytes) = 0;
+    virtual qint64 getOutboundLowWatermark() const = 0;
+    
+    /**
+     * @brief 连接出站队列上限（字节），超出后断开该连接，0表示不限制
+     */
+    virtual void setOutboundMaxQueuedBytes(qint64 nBytes) = 0;
+    virtual qint64 getOutboundMaxQueuedBytes() const = 0;
+    
 signals:
     /**
      * @brief 配置加载完成信号
@@ -11,7 +11,9 @@
 #include <QObject>
 #include <QString>
 #include <QJsonObject>
+#include <QStringList>
 #include <functional>
+#include "MCPTypedTool.h"
 
 /**
  * @brief MCP工具服务接口
@@ -42,6 +44,11 @@ protected:
      */
     virtual ~IMCPToolService() {}
     
+    /**
+     * @brief 记录addTyped参数名数量与函数签名不匹配（在库内实现，通过库的日志输出）
+     */
+    static void logTypedArgCountMismatch(const QString& strName);
+    
 public:
     /**
      * @brief 注册工具
@@ -92,6 +99,70 @@ public:
                      const QJsonObject& jsonOutputSchema,
                      std::function<QJsonObject()> execFun) = 0;
     
+    /**
+     * @brief 注册工具（使用带参数的函数）
+     * @param strName 工具名称
+     * @param strTitle 工具标题
+     * @param strDescription 工具描述
+     * @param jsonInputSchema 输入Schema（JSON格式）
+     * @param jsonOutputSchema 输出Schema（JSON格式）
+     * @param execFun 执行函数，参数为调用时传入的 arguments 对象
+     * @return true表示注册成功，false表示失败
+     * 
+     * 执行函数返回 {"error": {"code": ..., "message": ...}} 时，会作为JSON-RPC错误返回给客户端。
+     */
+    virtual bool addWithArgs(const QString& strName,
+                             const QString& strTitle,
+                             const QString& strDescription,
+                             const QJsonObject& jsonInputSchema,
+                             const QJsonObject& jsonOutputSchema,
+                             std::function<QJsonObject(const QJsonObject&)> execFun) = 0;
+    
+    /**
+     * @brief 注册类型化工具（仅头文件模板，不经过QVariant）
+     * @tparam Signature 函数签名，例如 int(int, int)
+     * @param strName 工具名称
+     * @param callable 可调用对象（函数、lambda、仿函数）
+     * @param lstArgNames 参数名列表，顺序与签名中的参数一一对应
+     * @param strTitle 工具标题（为空时使用工具名称）
+     * @param strDescription 工具描述
+     * @return true表示注册成功，false表示失败
+     * 
+     * 输入/输出Schema根据C++类型自动生成，调用时JSON参数直接解码为类型化参数。
+     * 返回值为 QJsonObject 时作为 structuredContent 原样返回，
+     * 其他类型包装为 {"result": value}。
+     * 
+     * 使用示例：
+     * @code
+     * pToolService->addTyped<double(double, double)>("add",
+     *     [](double a, double b) { return a + b; },
+     *     QStringList() << "a" << "b", "Add", "Add two numbers");
+     * @endcode
+     */
+    template<typename Signature, typename Callable>
+    bool addTyped(const QString& strName,
+                  Callable callable,
+                  const QStringList& lstArgNames,
+                  const QString& strTitle = QString(),
+                  const QString& strDescription = QString())
+    {
+        typedef MCPTypedToolDetail::TypedSignature<Signature> TypedSignatureType;
+        if (lstArgNames.size() != TypedSignatureType::ArgCount)
+        {
+            logTypedArgCountMismatch(strName);
+            return false;
+        }
+        return addWithArgs(strName,
+                           strTitle.isEmpty() ? strName : strTitle,
+                           strDescription,
+                           TypedSignatureType::inputSchema(lstArgNames),
+                           TypedSignatureType::outputSchema(),
+                           [callable, lstArgNames](const QJsonObject& jsonArguments) -> QJsonObject
+                           {
+                               return TypedSignatureType::invoke(callable, lstArgNames, jsonArguments);
+                           });
+    }
+    
     /**
      * @brief 注销工具
      * @param strName 工具名称
@@ -105,6 +176,25 @@ public:
      */
     virtual QJsonArray list() const = 0;
     
+    /**
+     * @brief 批量修改工具
+     * @param fun 批量操作，在服务线程中一次执行，内部调用add/remove等方法时不再逐个跨线程调用
+     * 
+     * 期间的所有注册/注销只发送一次 notifications/tools/list_changed
+     * 
+     * 使用示例：
+     * @code
+     * pToolService->batchUpdate([&]()
+     * {
+     *     for (const QJsonObject& jsonTool : lstTools)
+     *     {
+     *         pToolService->addFromJson(jsonTool);
+     *     }
+     * });
+     * @endcode
+     */
+    virtual void batchUpdate(const std::function<void()>& fun) = 0;
+    
     /**
      * @brief 从JSON对象添加工具
      * @param jsonTool JSON对象，包含工具的配置信息
@@ -120,7 +210,9 @@ public:
      *   "outputSchema": { ... },
      *   "execHandler": "Handler名称",
      *   "execMethod": "处理方法名",
-     *   "annotations": { ... }（可选）
+     *   "annotations": { ... }（可选）,
+     *   "cache": { "enabled": true, "ttlMs": 30000, "maxBytes": 4194304 }（可选）,
+     *   "singleFlight": true（可选，合并并发的相同调用）
      * }
      * 
      * 使用示例：
@@ -135,6 +227,21 @@ public:
      */
     virtual bool addFromJson(const QJsonObject& jsonTool, QObject* pSearchRoot = nullptr) = 0;
     
+    /**
+     * @brief 获取工具结果缓存统计
+     * @return 以工具名为键的统计对象，仅包含启用了缓存的工具
+     * 
+     * 统计格式：
+     * {
+     *   "toolName": { "hits": 10, "misses": 2, "entries": 2, "bytes": 512, "maxBytes": 4194304, "ttlMs": 30000 }
+     * }
+     * 
+     * 缓存启用方式：工具 annotations 中 readOnlyHint/idempotentHint 为 true，
+     * 或工具JSON中包含 "cache": { "enabled": true, "ttlMs": 30000, "maxBytes": 4194304 }。
+     * 工具重新注册时缓存随旧工具对象一起丢弃。
+     */
+    virtual QJsonObject getCacheStatistics() const = 0;
+    
 signals:
     /**
      * @brief 工具列表变化信号
@@ -0,0 +1,491 @@
+/**
+ * @file MCPTypedTool.h
+ * @brief MCP类型安全工具注册辅助模板（仅头文件）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QJsonDocument>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief C++类型与JSON之间的转换特性
+ *
+ * 职责：
+ * - 根据C++类型生成JSON Schema片段
+ * - 将JSON值直接解码为C++类型（不经过QVariant）
+ * - 将C++类型编码为JSON值
+ *
+ * 支持的类型：bool、整数、浮点数、QString、std::string、QStringList、
+ * QJsonObject、QJsonArray、QJsonValue，以及元素为上述类型的 QList/QVector/std::vector。
+ * 其他类型可通过特化 MCPTypedValue 扩展。
+ *
+ * 编码规范：
+ * - 静态方法，无需实例化
+ * - { 和 } 要单独一行
+ */
+template<typename T, typename Enable = void>
+struct MCPTypedValue;
+
+template<>
+struct MCPTypedValue<bool>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject{{"type", "boolean"}};
+    }
+    static bool fromJson(const QJsonValue& jsonValue, bool& bValue)
+    {
+        if (!jsonValue.isBool())
+        {
+            return false;
+        }
+        bValue = jsonValue.toBool();
+        return true;
+    }
+    static QJsonValue toJson(bool bValue)
+    {
+        return QJsonValue(bValue);
+    }
+};
+
+template<typename T>
+struct MCPTypedValue<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject{{"type", "integer"}};
+    }
+    static bool fromJson(const QJsonValue& jsonValue, T& nValue)
+    {
+        if (!jsonValue.isDouble())
+        {
+            return false;
+        }
+        // 上界用2^digits（不含）：64位整数的max()转为double会进位到2^digits，不能作为闭区间上界
+        double dValue = jsonValue.toDouble();
+        if (dValue != std::floor(dValue)
+            || dValue < static_cast<double>(std::numeric_limits<T>::lowest())
+            || dValue >= std::ldexp(1.0, std::numeric_limits<T>::digits))
+        {
+            return false;
+        }
+        nValue = static_cast<T>(dValue);
+        return true;
+    }
+    static QJsonValue toJson(T nValue)
+    {
+        return QJsonValue(static_cast<double>(nValue));
+    }
+};
+
+template<typename T>
+struct MCPTypedValue<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject{{"type", "number"}};
+    }
+    static bool fromJson(const QJsonValue& jsonValue, T& dValue)
+    {
+        if (!jsonValue.isDouble())
+        {
+            return false;
+        }
+        dValue = static_cast<T>(jsonValue.toDouble());
+        return true;
+    }
+    static QJsonValue toJson(T dValue)
+    {
+        return QJsonValue(static_cast<double>(dValue));
+    }
+};
+
+template<>
+struct MCPTypedValue<QString>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject{{"type", "string"}};
+    }
+    static bool fromJson(const QJsonValue& jsonValue, QString& strValue)
+    {
+        if (!jsonValue.isString())
+        {
+            return false;
+        }
+        strValue = jsonValue.toString();
+        return true;
+    }
+    static QJsonValue toJson(const QString& strValue)
+    {
+        return QJsonValue(strValue);
+    }
+};
+
+template<>
+struct MCPTypedValue<std::string>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject{{"type", "string"}};
+    }
+    static bool fromJson(const QJsonValue& jsonValue, std::string& strValue)
+    {
+        if (!jsonValue.isString())
+        {
+            return false;
+        }
+        strValue = jsonValue.toString().toStdString();
+        return true;
+    }
+    static QJsonValue toJson(const std::string& strValue)
+    {
+        return QJsonValue(QString::fromStdString(strValue));
+    }
+};
+
+template<>
+struct MCPTypedValue<QJsonObject>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject{{"type", "object"}};
+    }
+    static bool fromJson(const QJsonValue& jsonValue, QJsonObject& jsonObject)
+    {
+        if (!jsonValue.isObject())
+        {
+            return false;
+        }
+        jsonObject = jsonValue.toObject();
+        return true;
+    }
+    static QJsonValue toJson(const QJsonObject& jsonObject)
+    {
+        return QJsonValue(jsonObject);
+    }
+};
+
+template<>
+struct MCPTypedValue<QJsonArray>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject{{"type", "array"}};
+    }
+    static bool fromJson(const QJsonValue& jsonValue, QJsonArray& jsonArray)
+    {
+        if (!jsonValue.isArray())
+        {
+            return false;
+        }
+        jsonArray = jsonValue.toArray();
+        return true;
+    }
+    static QJsonValue toJson(const QJsonArray& jsonArray)
+    {
+        return QJsonValue(jsonArray);
+    }
+};
+
+template<>
+struct MCPTypedValue<QJsonValue>
+{
+    static QJsonObject schema()
+    {
+        return QJsonObject();
+    }
+    static bool fromJson(const QJsonValue& jsonValue, QJsonValue& outValue)
+    {
+        outValue = jsonValue;
+        return true;
+    }
+    static QJsonValue toJson(const QJsonValue& jsonValue)
+    {
+        return jsonValue;
+    }
+};
+
+namespace MCPTypedToolDetail
+{
+    /**
+     * @brief 序列容器（QList/QVector/std::vector/QStringList）的转换实现
+     */
+    template<typename Container, typename Item>
+    struct SequenceValue
+    {
+        static QJsonObject schema()
+        {
+            return QJsonObject{{"type", "array"}, {"items", MCPTypedValue<Item>::schema()}};
+        }
+        static bool fromJson(const QJsonValue& jsonValue, Container& container)
+        {
+            if (!jsonValue.isArray())
+            {
+                return false;
+            }
+            const QJsonArray jsonArray = jsonValue.toArray();
+            Container result;
+            result.reserve(jsonArray.size());
+            for (const auto& jsonItem : jsonArray)
+            {
+                Item item;
+                if (!MCPTypedValue<Item>::fromJson(jsonItem, item))
+                {
+                    return false;
+                }
+                result.push_back(item);
+            }
+            container.swap(result);
+            return true;
+        }
+        static QJsonValue toJson(const Container& container)
+        {
+            QJsonArray jsonArray;
+            for (const auto& item : container)
+            {
+                jsonArray.append(MCPTypedValue<Item>::toJson(item));
+            }
+            return QJsonValue(jsonArray);
+        }
+    };
+}
+
+template<>
+struct MCPTypedValue<QStringList> : MCPTypedToolDetail::SequenceValue<QStringList, QString>
+{
+};
+
+template<typename Item>
+struct MCPTypedValue<QList<Item>> : MCPTypedToolDetail::SequenceValue<QList<Item>, Item>
+{
+};
+
+template<typename Item>
+struct MCPTypedValue<QVector<Item>> : MCPTypedToolDetail::SequenceValue<QVector<Item>, Item>
+{
+};
+
+template<typename Item>
+struct MCPTypedValue<std::vector<Item>> : MCPTypedToolDetail::SequenceValue<std::vector<Item>, Item>
+{
+};
+
+namespace MCPTypedToolDetail
+{
+    template<int... N>
+    struct IndexSequence
+    {
+    };
+
+    template<int N, int... S>
+    struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, S...>
+    {
+    };
+
+    template<int... S>
+    struct MakeIndexSequence<0, S...>
+    {
+        typedef IndexSequence<S...> Type;
+    };
+
+    /**
+     * @brief 把单个JSON参数解码到类型化存储中
+     * @return 解码失败或之前已有参数失败时返回false，错误信息写入 strError
+     */
+    template<typename T>
+    inline bool decodeArgument(const QJsonObject& jsonArguments, const QString& strArgName, T& value, QString& strError)
+    {
+        if (!strError.isEmpty())
+        {
+            return false;
+        }
+        auto it = jsonArguments.constFind(strArgName);
+        if (it == jsonArguments.constEnd())
+        {
+            strError = QString("Missing required argument: %1").arg(strArgName);
+            return false;
+        }
+        if (!MCPTypedValue<T>::fromJson(it.value(), value))
+        {
+            strError = QString("Invalid type for argument: %1").arg(strArgName);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 生成参数错误结果（{"error": {...}} 会被作为 Invalid params 错误返回给客户端）
+     */
+    inline QJsonObject makeInvalidParamsResult(const QString& strError)
+    {
+        return QJsonObject
+        {
+            {"error", QJsonObject{{"code", -32602}, {"message", strError}}}
+        };
+    }
+
+    /**
+     * @brief 把结构化结果包装为工具调用结果（content + structuredContent）
+     */
+    inline QJsonObject makeToolResult(const QJsonObject& jsonStructuredContent)
+    {
+        QJsonObject jsonText;
+        jsonText["type"] = "text";
+        jsonText["text"] = QString::fromUtf8(QJsonDocument(jsonStructuredContent).toJson(QJsonDocument::Compact));
+        QJsonObject jsonResult;
+        jsonResult["content"] = QJsonArray{jsonText};
+        jsonResult["structuredContent"] = jsonStructuredContent;
+        return jsonResult;
+    }
+
+    /**
+     * @brief 返回值处理：非对象类型包装为 {"result": value}，QJsonObject 原样作为结构化结果
+     */
+    template<typename R>
+    struct ResultValue
+    {
+        static QJsonObject outputSchema()
+        {
+            return QJsonObject
+            {
+                {"type", "object"},
+                {"properties", QJsonObject{{"result", MCPTypedValue<R>::schema()}}},
+                {"required", QJsonArray{"result"}}
+            };
+        }
+        static QJsonObject toToolResult(const R& value)
+        {
+            return makeToolResult(QJsonObject{{"result", MCPTypedValue<R>::toJson(value)}});
+        }
+    };
+
+    template<>
+    struct ResultValue<QJsonObject>
+    {
+        static QJsonObject outputSchema()
+        {
+            return QJsonObject{{"type", "object"}};
+        }
+        static QJsonObject toToolResult(const QJsonObject& jsonValue)
+        {
+            return makeToolResult(jsonValue);
+        }
+    };
+
+    template<typename R>
+    struct ResultInvoker
+    {
+        template<typename Callable, typename Tuple, int... N>
+        static QJsonObject invoke(Callable& callable, Tuple& tupleValues, IndexSequence<N...>)
+        {
+            return ResultValue<R>::toToolResult(callable(std::get<N>(tupleValues)...));
+        }
+    };
+
+    template<>
+    struct ResultInvoker<void>
+    {
+        template<typename Callable, typename Tuple, int... N>
+        static QJsonObject invoke(Callable& callable, Tuple& tupleValues, IndexSequence<N...>)
+        {
+            callable(std::get<N>(tupleValues)...);
+            return makeToolResult(QJsonObject());
+        }
+    };
+
+    template<typename Signature>
+    struct TypedSignature;
+
+    /**
+     * @brief 函数签名 R(Args...) 的类型化调用实现
+     */
+    template<typename R, typename... Args>
+    struct TypedSignature<R(Args...)>
+    {
+        enum
+        {
+            ArgCount = sizeof...(Args)
+        };
+        typedef std::tuple<typename std::decay<Args>::type...> ArgTuple;
+        typedef typename std::decay<R>::type ResultType;
+
+        static QJsonObject inputSchema(const QStringList& lstArgNames)
+        {
+            QList<QJsonObject> lstSchemas{MCPTypedValue<typename std::decay<Args>::type>::schema()...};
+            QJsonObject jsonProperties;
+            QJsonArray jsonRequired;
+            for (int i = 0; i < lstSchemas.size() && i < lstArgNames.size(); ++i)
+            {
+                jsonProperties[lstArgNames[i]] = lstSchemas[i];
+                jsonRequired.append(lstArgNames[i]);
+            }
+            return QJsonObject
+            {
+                {"type", "object"},
+                {"properties", jsonProperties},
+                {"required", jsonRequired}
+            };
+        }
+
+        static QJsonObject outputSchema()
+        {
+            return OutputSchema<ResultType>::get();
+        }
+
+        template<typename Callable>
+        static QJsonObject invoke(Callable& callable, const QStringList& lstArgNames, const QJsonObject& jsonArguments)
+        {
+            return invokeImpl(callable, lstArgNames, jsonArguments, typename MakeIndexSequence<ArgCount>::Type());
+        }
+
+    private:
+        template<typename T, typename Dummy = void>
+        struct OutputSchema
+        {
+            static QJsonObject get()
+            {
+                return ResultValue<T>::outputSchema();
+            }
+        };
+
+        template<typename Dummy>
+        struct OutputSchema<void, Dummy>
+        {
+            static QJsonObject get()
+            {
+                return QJsonObject{{"type", "object"}};
+            }
+        };
+
+        template<typename Callable, int... N>
+        static QJsonObject invokeImpl(Callable& callable, const QStringList& lstArgNames, const QJsonObject& jsonArguments, IndexSequence<N...> indexes)
+        {
+            ArgTuple tupleValues;
+            QString strError;
+            bool arrDecoded[] = {true, decodeArgument(jsonArguments, lstArgNames[N], std::get<N>(tupleValues), strError)...};
+            Q_UNUSED(arrDecoded);
+            if (!strError.isEmpty())
+            {
+                return makeInvalidParamsResult(strError);
+            }
+            return ResultInvoker<ResultType>::invoke(callable, tupleValues, indexes);
+        }
+    };
+}
@@ -41,11 +41,21 @@ QJsonObject MCPResourceConfig::toJson() const
         json["filePath"] = strFilePath;
     }
     
+    if (!strDirectoryPath.isEmpty())
+    {
+        json["directoryPath"] = strDirectoryPath;
+    }
+    
     if (!strHandlerName.isEmpty())
     {
         json["handlerName"] = strHandlerName;
     }
     
+    if (nNotifyDebounceMs >= 0)
+    {
+        json["notifyDebounceMs"] = nNotifyDebounceMs;
+    }
+    
     // 添加 annotations（如果存在）
     if (!annotations.isEmpty())
     {
@@ -65,6 +75,7 @@ MCPResourceConfig MCPResourceConfig::fromJson(const QJsonObject& json)
     config.strType = json["type"].toString("content");  // 默认为content类型
     config.strContent = json["content"].toString();
     config.strFilePath = json["filePath"].toString();
+    config.strDirectoryPath = json["directoryPath"].toString();
     config.strHandlerName = json["handlerName"].toString();
     
     // 解析 annotations（如果存在）
@@ -73,6 +84,8 @@ MCPResourceConfig MCPResourceConfig::fromJson(const QJsonObject& json)
         config.annotations = json["annotations"].toObject();
     }
     
+    config.nNotifyDebounceMs = json["notifyDebounceMs"].toInt(-1);
+    
     return config;
 }
 
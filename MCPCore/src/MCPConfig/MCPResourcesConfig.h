@@ -22,15 +22,18 @@ struct MCPResourceConfig
     QString strName;          // 资源名称
     QString strDescription;   // 资源描述
     QString strMimeType;      // MIME类型
-    QString strType;          // 资源类型："file"（文件资源）、"wrapper"（包装资源）、"content"（内容资源，默认）
+    QString strType;          // 资源类型："file"（文件资源）、"wrapper"（包装资源）、"directory"（目录资源）、"content"（内容资源，默认）
     QString strContent;       // 静态内容（可选，用于content类型）
     QString strFilePath;      // 文件路径（可选，用于file类型）
+    QString strDirectoryPath; // 目录路径（可选，用于directory类型，strUri作为URI前缀）
     QString strHandlerName;  // Handler名称（可选，用于wrapper类型，通过MCPResourceHandlerName属性查找QObject）
     
     // 资源注解（Annotations），根据 MCP 协议规范，可选
     QJsonObject annotations;   // 包含 audience、priority、lastModified 等字段
     
-    MCPResourceConfig() : strMimeType("text/plain"), strType("content") {}
+    int nNotifyDebounceMs;     // 变化通知合并窗口（毫秒），-1表示使用服务器全局配置
+    
+    MCPResourceConfig() : strMimeType("text/plain"), strType("content"), nNotifyDebounceMs(-1) {}
     
     QJsonObject toJson() const;
     static MCPResourceConfig fromJson(const QJsonObject& json);
@@ -28,6 +28,16 @@ MCPServerConfig::MCPServerConfig(QObject* pParent)
     , m_strServerTitle("C++ MCP Server Implementation")
     , m_strServerVersion("1.0.0")
     , m_strInstructions("这是一个使用C++和Qt实现的MCP服务器，支持工具、资源和提示词功能")
+    , m_nSessionIdleTimeoutMs(30 * 60 * 1000)
+    , m_nSessionMaxPendingUris(1024)
+    , m_nResourceNotifyDebounceMs(100)
+    , m_bResourceUpdateInlineContent(false)
+    , m_nFileContentCacheBytes(64 * 1024 * 1024)
+    , m_nFileStreamThresholdBytes(1024 * 1024)
+    , m_nListPageSize(1000)
+    , m_nOutboundHighWatermarkBytes(1024 * 1024)
+    , m_nOutboundLowWatermarkBytes(256 * 1024)
+    , m_nOutboundMaxQueuedBytes(16 * 1024 * 1024)
 {
 }
 
@@ -143,6 +153,62 @@ bool MCPServerConfig::loadFromJson(const QJsonObject& jsonConfig)
     {
         m_strInstructions = jsonConfig["instructions"].toString();
     }
+    
+    // 读取会话空闲超时
+    if (jsonConfig.contains("sessionIdleTimeoutMs"))
+    {
+        m_nSessionIdleTimeoutMs = static_cast<qint64>(jsonConfig["sessionIdleTimeoutMs"].toDouble());
+    }
+    
+    // 读取会话待发送URI上限
+    if (jsonConfig.contains("sessionMaxPendingUris"))
+    {
+        m_nSessionMaxPendingUris = qMax(0, jsonConfig["sessionMaxPendingUris"].toInt());
+    }
+    
+    // 读取资源变化通知合并窗口
+    if (jsonConfig.contains("resourceNotifyDebounceMs"))
+    {
+        m_nResourceNotifyDebounceMs = qMax(0, jsonConfig["resourceNotifyDebounceMs"].toInt());
+    }
+    
+    // 读取资源更新通知是否内联内容
+    if (jsonConfig.contains("resourceUpdateInlineContent"))
+    {
+        m_bResourceUpdateInlineContent = jsonConfig["resourceUpdateInlineContent"].toBool();
+    }
+    
+    // 读取文件资源内容缓存预算
+    if (jsonConfig.contains("fileContentCacheBytes"))
+    {
+        m_nFileContentCacheBytes = qMax(0, jsonConfig["fileContentCacheBytes"].toInt());
+    }
+    
+    // 读取文件资源流式发送阈值
+    if (jsonConfig.contains("fileStreamThresholdBytes"))
+    {
+        m_nFileStreamThresholdBytes = qMax<qint64>(0, static_cast<qint64>(jsonConfig["fileStreamThresholdBytes"].toDouble()));
+    }
+    
+    // 读取列表分页大小
+    if (jsonConfig.contains("listPageSize"))
+    {
+        m_nListPageSize = qMax(0, jsonConfig["listPageSize"].toInt());
+    }
+    
+    // 读取连接出站队列水位
+    if (jsonConfig.contains("outboundHighWatermarkBytes"))
+    {
+        m_nOutboundHighWatermarkBytes = qMax<qint64>(0, static_cast<qint64>(jsonConfig["outboundHighWatermarkBytes"].toDouble()));
+    }
+    if (jsonConfig.contains("outboundLowWatermarkBytes"))
+    {
+        m_nOutboundLowWatermarkBytes = qMax<qint64>(0, static_cast<qint64>(jsonConfig["outboundLowWatermarkBytes"].toDouble()));
+    }
+    if (jsonConfig.contains("outboundMaxQueuedBytes"))
+    {
+        m_nOutboundMaxQueuedBytes = qMax<qint64>(0, static_cast<qint64>(jsonConfig["outboundMaxQueuedBytes"].toDouble()));
+    }
 
     MCP_CORE_LOG_INFO() << "MCPXServerConfig: 主配置加载成功 - 端口:" << m_nPort 
                         << ", 服务器:" << m_strServerName;
@@ -187,6 +253,16 @@ QJsonObject MCPServerConfig::toJson() const
     json["serverInfo"] = serverInfo;
     
     json["instructions"] = m_strInstructions;
+    json["sessionIdleTimeoutMs"] = static_cast<double>(m_nSessionIdleTimeoutMs);
+    json["sessionMaxPendingUris"] = m_nSessionMaxPendingUris;
+    json["resourceNotifyDebounceMs"] = m_nResourceNotifyDebounceMs;
+    json["resourceUpdateInlineContent"] = m_bResourceUpdateInlineContent;
+    json["fileContentCacheBytes"] = m_nFileContentCacheBytes;
+    json["fileStreamThresholdBytes"] = static_cast<double>(m_nFileStreamThresholdBytes);
+    json["listPageSize"] = m_nListPageSize;
+    json["outboundHighWatermarkBytes"] = static_cast<double>(m_nOutboundHighWatermarkBytes);
+    json["outboundLowWatermarkBytes"] = static_cast<double>(m_nOutboundLowWatermarkBytes);
+    json["outboundMaxQueuedBytes"] = static_cast<double>(m_nOutboundMaxQueuedBytes);
     
     return json;
 }
@@ -241,3 +317,102 @@ QString MCPServerConfig::getInstructions() const
     return m_strInstructions;
 }
 
+void MCPServerConfig::setSessionIdleTimeout(qint64 nTimeoutMs)
+{
+    m_nSessionIdleTimeoutMs = nTimeoutMs;
+}
+
+qint64 MCPServerConfig::getSessionIdleTimeout() const
+{
+    return m_nSessionIdleTimeoutMs;
+}
+
+void MCPServerConfig::setSessionMaxPendingUris(int nMaxUris)
+{
+    m_nSessionMaxPendingUris = qMax(0, nMaxUris);
+}
+
+int MCPServerConfig::getSessionMaxPendingUris() const
+{
+    return m_nSessionMaxPendingUris;
+}
+
+void MCPServerConfig::setResourceNotifyDebounce(int nDebounceMs)
+{
+    m_nResourceNotifyDebounceMs = qMax(0, nDebounceMs);
+}
+
+int MCPServerConfig::getResourceNotifyDebounce() const
+{
+    return m_nResourceNotifyDebounceMs;
+}
+
+void MCPServerConfig::setResourceUpdateInlineContent(bool bInline)
+{
+    m_bResourceUpdateInlineContent = bInline;
+}
+
+bool MCPServerConfig::isResourceUpdateInlineContent() const
+{
+    return m_bResourceUpdateInlineContent;
+}
+
+void MCPServerConfig::setFileContentCacheBytes(int nMaxBytes)
+{
+    m_nFileContentCacheBytes = qMax(0, nMaxBytes);
+}
+
+int MCPServerConfig::getFileContentCacheBytes() const
+{
+    return m_nFileContentCacheBytes;
+}
+
+void MCPServerConfig::setFileStreamThreshold(qint64 nThresholdBytes)
+{
+    m_nFileStreamThresholdBytes = qMax<qint64>(0, nThresholdBytes);
+}
+
+qint64 MCPServerConfig::getFileStreamThreshold() const
+{
+    return m_nFileStreamThresholdBytes;
+}
+
+void MCPServerConfig::setListPageSize(int nPageSize)
+{
+    m_nListPageSize = qMax(0, nPageSize);
+}
+
+int MCPServerConfig::getListPageSize() const
+{
+    return m_nListPageSize;
+}
+
+void MCPServerConfig::setOutboundHighWatermark(qint64 nBytes)
+{
+    m_nOutboundHighWatermarkBytes = qMax<qint64>(0, nBytes);
+}
+
+qint64 MCPServerConfig::getOutboundHighWatermark() const
+{
+    return m_nOutboundHighWatermarkBytes;
+}
+
+void MCPServerConfig::setOutboundLowWatermark(qint64 nBytes)
+{
+    m_nOutboundLowWatermarkBytes = qMax<qint64>(0, nBytes);
+}
+
+qint64 MCPServerConfig::getOutboundLowWatermark() const
+{
+    return m_nOutboundLowWatermarkBytes;
+}
+
+void MCPServerConfig::setOutboundMaxQueuedBytes(qint64 nBytes)
+{
+    m_nOutboundMaxQueuedBytes = qMax<qint64>(0, nBytes);
+}
+
+qint64 MCPServerConfig::getOutboundMaxQueuedBytes() const
+{
+    return m_nOutboundMaxQueuedBytes;
+}
@@ -58,6 +58,36 @@ public:
     
     void setInstructions(const QString& strInstructions) override;
     QString getInstructions() const override;
+    
+    void setSessionIdleTimeout(qint64 nTimeoutMs) override;
+    qint64 getSessionIdleTimeout() const override;
+    
+    void setSessionMaxPendingUris(int nMaxUris) override;
+    int getSessionMaxPendingUris() const override;
+    
+    void setResourceNotifyDebounce(int nDebounceMs) override;
+    int getResourceNotifyDebounce() const override;
+    
+    void setResourceUpdateInlineContent(bool bInline) override;
+    bool isResourceUpdateInlineContent() const override;
+    
+    void setFileContentCacheBytes(int nMaxBytes) override;
+    int getFileContentCacheBytes() const override;
+    
+    void setFileStreamThreshold(qint64 nThresholdBytes) override;
+    qint64 getFileStreamThreshold() const override;
+    
+    void setListPageSize(int nPageSize) override;
+    int getListPageSize() const override;
+    
+    void setOutboundHighWatermark(qint64 nBytes) override;
+    qint64 getOutboundHighWatermark() const override;
+    
+    void setOutboundLowWatermark(qint64 nBytes) override;
+    qint64 getOutboundLowWatermark() const override;
+    
+    void setOutboundMaxQueuedBytes(qint64 nBytes) override;
+    qint64 getOutboundMaxQueuedBytes() const override;
 
 private:
     // 内部使用的方法
@@ -72,6 +102,16 @@ private:
     QString m_strServerTitle;
     QString m_strServerVersion;
     QString m_strInstructions;
+    qint64 m_nSessionIdleTimeoutMs;
+    int m_nSessionMaxPendingUris;
+    int m_nResourceNotifyDebounceMs;
+    bool m_bResourceUpdateInlineContent;
+    int m_nFileContentCacheBytes;
+    qint64 m_nFileStreamThresholdBytes;
+    int m_nListPageSize;
+    qint64 m_nOutboundHighWatermarkBytes;
+    qint64 m_nOutboundLowWatermarkBytes;
+    qint64 m_nOutboundMaxQueuedBytes;
 private:
     friend class MCPServer;
 };
@@ -35,6 +35,17 @@ QJsonObject MCPToolConfig::toJson() const
         json["annotations"] = annotations;
     }
     
+    // 添加缓存配置（如果存在）
+    if (!jsonCache.isEmpty())
+    {
+        json["cache"] = jsonCache;
+    }
+    
+    if (bSingleFlight)
+    {
+        json["singleFlight"] = true;
+    }
+    
     return json;
 }
 
@@ -55,6 +66,14 @@ MCPToolConfig MCPToolConfig::fromJson(const QJsonObject& json)
         config.annotations = json["annotations"].toObject();
     }
     
+    // 解析缓存配置（如果存在）
+    if (json.contains("cache") && json["cache"].isObject())
+    {
+        config.jsonCache = json["cache"].toObject();
+    }
+    
+    config.bSingleFlight = json["singleFlight"].toBool(false);
+    
     return config;
 }
 
@@ -29,7 +29,13 @@ struct MCPToolConfig
     // 工具注解（Annotations），根据 MCP 协议规范，可选
     QJsonObject annotations;   // 包含 audience、priority、lastModified 等字段
     
-    MCPToolConfig() {}
+    // 结果缓存配置（可选），格式见 MCPToolCacheConfig
+    QJsonObject jsonCache;
+    
+    // 是否合并并发的相同调用（可选，默认false）
+    bool bSingleFlight;
+    
+    MCPToolConfig() : bSingleFlight(false) {}
     
     QJsonObject toJson() const;
     static MCPToolConfig fromJson(const QJsonObject& json);
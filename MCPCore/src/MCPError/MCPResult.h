@@ -0,0 +1,88 @@
+/**
+ * @file MCPResult.h
+ * @brief MCP结果类型（值或错误）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include "MCPError.h"
+
+/**
+ * @brief MCP结果类型，保存成功的值或MCPError
+ *
+ * 用于常见失败路径（工具不存在、参数校验失败、处理器执行失败等），
+ * 通过返回值传递错误而不是抛出异常，异常只保留给真正的程序错误。
+ *
+ * 使用示例：
+ * @code
+ * MCPResult<QJsonObject> callTool(const QString& strName)
+ * {
+ *     if (pTool == nullptr)
+ *     {
+ *         return MCPError::toolNotFound(strName);
+ *     }
+ *     return jsonResult;
+ * }
+ *
+ * auto result = callTool("calculator");
+ * if (!result)
+ * {
+ *     return QSharedPointer<MCPServerErrorResponse>::create(pContext, result.error());
+ * }
+ * @endcode
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - { 和 } 要单独一行
+ */
+template<typename T>
+class MCPResult
+{
+public:
+    MCPResult(const T& value)
+        : m_bSuccess(true)
+        , m_value(value)
+    {
+    }
+
+    MCPResult(const MCPError& error)
+        : m_bSuccess(false)
+        , m_value()
+        , m_error(error)
+    {
+    }
+
+public:
+    bool isSuccess() const
+    {
+        return m_bSuccess;
+    }
+
+    explicit operator bool() const
+    {
+        return m_bSuccess;
+    }
+
+    /**
+     * @brief 获取成功的值（失败时为默认构造的值）
+     */
+    const T& value() const
+    {
+        return m_value;
+    }
+
+    /**
+     * @brief 获取错误（成功时为默认构造的错误）
+     */
+    const MCPError& error() const
+    {
+        return m_error;
+    }
+
+private:
+    bool m_bSuccess;
+    T m_value;
+    MCPError m_error;
+};
@@ -74,6 +74,34 @@ void MCPMessageSender::sendAcceptNotification(quint64 nConnectionId, MCPMessageT
     m_pTransport->sendMessage(nConnectionId, pReplyMessage);
 }
 
+void MCPMessageSender::broadcastSseNotification(const QList<quint64>& lstConnectionIds, const QJsonObject& objNotification)
+{
+    if (lstConnectionIds.isEmpty())
+    {
+        return;
+    }
+    MCPMessageType::Flags enMessageType = MCPMessageType::SseTransport | MCPMessageType::RequestNotification;
+    // SSE通知帧不包含会话相关内容，所有连接可共享同一份数据
+    auto pServerMessage = QSharedPointer<MCPServerMessage>::create(objNotification, enMessageType);
+    m_pTransport->broadcastMessage(lstConnectionIds,
+        QSharedPointer<MCPHttpReplyMessage>::create(pServerMessage, enMessageType));
+}
+
+void MCPMessageSender::sendEventStreamNotification(quint64 nConnectionId, const QJsonObject& objNotification)
+{
+    MCPMessageType::Flags enMessageType = MCPMessageType::StreamableTransport
+        | MCPMessageType::StreamableEventStream
+        | MCPMessageType::RequestNotification;
+    auto pServerMessage = QSharedPointer<MCPServerMessage>::create(objNotification, enMessageType);
+    m_pTransport->sendMessage(nConnectionId,
+        QSharedPointer<MCPHttpReplyMessage>::create(pServerMessage, enMessageType));
+}
+
+void MCPMessageSender::sendHttpError(quint64 nConnectionId, int nStatusCode)
+{
+    m_pTransport->sendCloseMessage(nConnectionId, MCPHttpReplyMessage::CreateHttpErrorResponse(nStatusCode));
+}
+
 void MCPMessageSender::sendSseMessage(const QSharedPointer<MCPServerMessage>& pServerMessage)
 {
     auto pContext = pServerMessage->getContext();
@@ -135,8 +163,14 @@ void MCPMessageSender::sendStreamableMessage(const QSharedPointer<MCPServerMessa
     auto enMessageType = pServerMessage->getType();
     auto pTransport = m_pTransport;
 
+    if (enMessageType & MCPMessageType::Connect)
+    {
+        // 事件流打开响应：只发送响应头，连接保持打开用于推送通知
+        pTransport->sendMessage(pContext->getConnectionId(),
+            QSharedPointer<MCPHttpReplyMessage>::create(pServerMessage, enMessageType));
+    }
     // 发送响应消息
-    if (enMessageType & MCPMessageType::Response)
+    else if (enMessageType & MCPMessageType::Response)
     {
         pTransport->sendMessage(pContext->getConnectionId(),
             QSharedPointer<MCPHttpReplyMessage>::create(pServerMessage, enMessageType));
@@ -9,6 +9,7 @@
 #pragma once
 #include <QObject>
 #include <QSharedPointer>
+#include <QList>
 #include "MCPMessage.h"
 #include "MCPServerMessage.h"
 
@@ -66,6 +67,31 @@ public:
      */
     void sendAcceptNotification(quint64 nConnectionId, MCPMessageType::Flags enTransportType);
 
+    /**
+     * @brief 向多个SSE连接广播同一条通知
+     * @param lstConnectionIds SSE连接ID列表
+     * @param objNotification 通知消息
+     *
+     * 通知帧只构建和序列化一次，由传输层共享给各连接的写队列。
+     */
+    void broadcastSseNotification(const QList<quint64>& lstConnectionIds, const QJsonObject& objNotification);
+
+    /**
+     * @brief 向Streamable会话的事件流（GET /mcp）推送一条通知
+     * @param nConnectionId 事件流连接ID
+     * @param objNotification 通知消息
+     */
+    void sendEventStreamNotification(quint64 nConnectionId, const QJsonObject& objNotification);
+
+    /**
+     * @brief 发送不带消息体的HTTP错误响应
+     * @param nConnectionId 连接ID
+     * @param nStatusCode HTTP状态码（如400、404）
+     *
+     * 用于无法按JSON-RPC回复的请求：如事件流GET没有请求ID，错误响应会被丢弃，连接一直挂起。
+     */
+    void sendHttpError(quint64 nConnectionId, int nStatusCode);
+
 private:
     /**
      * @brief 发送SSE传输的消息
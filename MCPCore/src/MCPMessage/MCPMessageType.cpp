@@ -50,6 +50,7 @@ QString MCPMessageType::toString(Flags type)
 	// 传输类型
 	if (type & SseTransport) parts << "SSE";
 	if (type & StreamableTransport) parts << "Stream";
+	if (type & StreamableEventStream) parts << "EventStream";
 
 	// 单个调用的消息类型
 	if (type & Request) parts << "Request";
@@ -16,6 +16,7 @@ public:
 		SseTransport = 1 << 0,           // Server-Sent Events 传输
 		StreamableTransport = 1 << 1,    // 可流式传输
 		StdioTransport = 1 << 2,         // Stdio传输
+		StreamableEventStream = 1 << 3,  // Streamable的GET事件流（服务器主动推送），与StreamableTransport同时出现
 
 		// 消息内容类型 (bits 8-15) - 请求/响应/通知
 		ContentTypeMask = 0xFF00,
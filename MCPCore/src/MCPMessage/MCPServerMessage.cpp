@@ -9,6 +9,8 @@
 #include "MCPServerMessage.h"
 #include "MCPClientMessage.h"
 #include "MCPError.h"
+#include "Utils/MCPStreamedFileContent.h"
+#include "Utils/MCPStreamedBody.h"
 
 MCPServerMessage::MCPServerMessage()
 	: MCPMessage(MCPMessageType::None)
@@ -95,18 +97,85 @@ MCPServerMessage::MCPServerMessage(const QSharedPointer<MCPContext>& pContext,
 	}
 }
 
+MCPServerMessage::MCPServerMessage(const QJsonValue& rpcValue, MCPMessageType::Flags enType)
+	: MCPMessage(enType)
+	, m_pContext(nullptr)
+{
+	// 无上下文的服务器主动通知（SSE广播、事件流推送），rpcValue为{method, params}
+	QJsonObject objValue = rpcValue.toObject();
+	objValue["jsonrpc"] = "2.0";
+	m_rpcValue = objValue;
+}
+
 
 QSharedPointer<MCPContext > MCPServerMessage::getContext() const
 {
 	return m_pContext;
 }
 
+QJsonValue MCPServerMessage::getRpcValue() const
+{
+	return m_rpcValue;
+}
+
+void MCPServerMessage::attachStreamedContents(const QList<QSharedPointer<MCPStreamedFileContent>>& lstStreamedContents)
+{
+	m_lstStreamedContents.append(lstStreamedContents);
+}
+
+bool MCPServerMessage::hasStreamedContents() const
+{
+	return !m_lstStreamedContents.isEmpty();
+}
+
+QSharedPointer<MCPStreamedBody> MCPServerMessage::createStreamedBody()
+{
+	if (m_lstStreamedContents.isEmpty())
+	{
+		return QSharedPointer<MCPStreamedBody>();
+	}
+	// JSON中只有占位符，尚未输出任何数据前检查文件能否打开，失败时还能改为回复错误
+	auto pBody = QSharedPointer<MCPStreamedBody>::create(toJsonData(), m_lstStreamedContents);
+	if (!pBody->open())
+	{
+		replaceWithReadError();
+		return QSharedPointer<MCPStreamedBody>();
+	}
+	return pBody;
+}
+
 QByteArray MCPServerMessage::toData()
 {
-	auto data = m_rpcValue.isArray()
+	if (!m_lstStreamedContents.isEmpty())
+	{
+		// 不经过传输层分块写出时一次性读入，文件读取失败或过大时改为回复错误
+		QByteArray arrData;
+		auto pBody = createStreamedBody();
+		if (pBody != nullptr && pBody->readAll(arrData))
+		{
+			return arrData;
+		}
+		replaceWithReadError();
+	}
+	return toJsonData();
+}
+
+QByteArray MCPServerMessage::toJsonData() const
+{
+	return m_rpcValue.isArray()
 		? QJsonDocument(m_rpcValue.toArray()).toJson(QJsonDocument::Compact)
 		: QJsonDocument(m_rpcValue.toObject()).toJson(QJsonDocument::Compact);
-	return data;
+}
+
+void MCPServerMessage::replaceWithReadError()
+{
+	if (m_lstStreamedContents.isEmpty())
+	{
+		return;
+	}
+	m_lstStreamedContents.clear();
+	m_rpcValue = MCPError::internalError("Failed to read resource content")
+		.toJsonResponse(m_rpcValue.toObject().value("id"));
 }
 
 MCPServerErrorResponse::MCPServerErrorResponse(const QSharedPointer<MCPContext>& pContext, int nCode, const QString& strMessage, const QString& strData)
@@ -14,6 +14,9 @@
 #include "MCPError.h"
 #include "MCPMessageType.h"
 
+class MCPStreamedFileContent;
+class MCPStreamedBody;
+
 class MCPServerMessage : public MCPMessage
 {
 public:
@@ -36,12 +39,23 @@ public:
 		MCPMessageType::Flags enType);
 public:
 	QSharedPointer<MCPContext> getContext() const;
+	QJsonValue getRpcValue() const;
+	// 挂载大文件流式内容，toData()时用文件内容替换JSON中的占位符
+	void attachStreamedContents(const QList<QSharedPointer<MCPStreamedFileContent>>& lstStreamedContents);
+	bool hasStreamedContents() const;
+	// 创建按块输出的响应数据（传输层边编码边写出）；文件无法打开时改为回复错误并返回空，此后toData()返回错误响应
+	QSharedPointer<MCPStreamedBody> createStreamedBody();
 public:
 	virtual QByteArray toData() override;
 protected:
 	QSharedPointer<MCPContext> m_pContext;
 protected:
     QJsonValue m_rpcValue;
+	QList<QSharedPointer<MCPStreamedFileContent>> m_lstStreamedContents;
+private:
+	QByteArray toJsonData() const;
+	// 改为回复读取失败的错误（不发送截断的内容）
+	void replaceWithReadError();
 };
 Q_DECLARE_METATYPE(MCPServerMessage*)
 Q_DECLARE_METATYPE(QSharedPointer<MCPServerMessage>)
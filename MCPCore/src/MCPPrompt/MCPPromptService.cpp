@@ -14,6 +14,8 @@
 
 MCPPromptService::MCPPromptService(QObject* pParent)
     : IMCPPromptService(pParent)
+    , m_nUpdateDepth(0)
+    , m_bListChangedPending(false)
 {
 }
 
@@ -48,7 +50,8 @@ bool MCPPromptService::registerPrompt(MCPPrompt* pPrompt)
     QString strName = pPrompt->getName();
     
     // 如果已存在，先删除旧的（覆盖），不发送信号，因为后面注册新对象时会发送
-    if (m_dictPrompts.contains(strName))
+    bool bReplaced = m_dictPrompts.contains(strName);
+    if (bReplaced)
     {
         MCP_CORE_LOG_INFO() << "MCPPromptService: 提示词已存在，覆盖旧提示词:" << strName;
         doRemoveImpl(strName, false);
@@ -56,9 +59,10 @@ bool MCPPromptService::registerPrompt(MCPPrompt* pPrompt)
     
     m_dictPrompts[strName] = pPrompt;
     MCP_CORE_LOG_INFO() << "MCPPromptService: 提示词已注册:" << strName;
+    m_listChangeLog.record(strName, bReplaced ? MCPListChangeLog::ChangeType::Changed : MCPListChangeLog::ChangeType::Added);
     
     emit promptChanged(strName);
-    emit promptsListChanged();
+    notifyListChanged();
     return true;
 }
 
@@ -86,6 +90,71 @@ QJsonArray MCPPromptService::list() const
     });
 }
 
+QJsonArray MCPPromptService::listPage(const QString& strAfterName, int nPageSize, QString& strLastName) const
+{
+    return MCPInvokeHelper::syncInvokeReturnT<QJsonArray>(const_cast<MCPPromptService*>(this), [this, strAfterName, nPageSize, &strLastName]()->QJsonArray
+    {
+        return doListPageImpl(strAfterName, nPageSize, strLastName);
+    });
+}
+
+void MCPPromptService::batchUpdate(const std::function<void()>& fun)
+{
+    MCPInvokeHelper::syncInvoke(this, [this, &fun]()
+    {
+        beginUpdate();
+        fun();
+        endUpdate();
+    });
+}
+
+void MCPPromptService::beginUpdate()
+{
+    ++m_nUpdateDepth;
+}
+
+void MCPPromptService::endUpdate()
+{
+    if (m_nUpdateDepth <= 0 || --m_nUpdateDepth > 0)
+    {
+        return;
+    }
+    if (m_bListChangedPending)
+    {
+        m_bListChangedPending = false;
+        emit promptsListChanged();
+    }
+}
+
+void MCPPromptService::notifyListChanged()
+{
+    if (m_nUpdateDepth > 0)
+    {
+        m_bListChangedPending = true;
+        return;
+    }
+    emit promptsListChanged();
+}
+
+quint64 MCPPromptService::getListGeneration() const
+{
+    return m_listChangeLog.getGeneration();
+}
+
+bool MCPPromptService::getListDelta(quint64 nSinceGeneration, QJsonObject& objDelta) const
+{
+    bool bSuccess = false;
+    MCPInvokeHelper::syncInvoke(const_cast<MCPPromptService*>(this), [this, nSinceGeneration, &objDelta, &bSuccess]()
+    {
+        bSuccess = m_listChangeLog.buildDelta(nSinceGeneration, [this](const QString& strName) -> QJsonObject
+        {
+            MCPPrompt* pPrompt = m_dictPrompts.value(strName, nullptr);
+            return pPrompt != nullptr ? pPrompt->getMetadata() : QJsonObject();
+        }, objDelta);
+    });
+    return bSuccess;
+}
+
 QJsonObject MCPPromptService::getPrompt(const QString& strName, const QMap<QString, QString>& arguments)
 {
     QJsonObject objResult;
@@ -200,8 +269,9 @@ bool MCPPromptService::doRemoveImpl(const QString& strName, bool bEmitSignal)
     MCP_CORE_LOG_INFO() << "MCPPromptService: 提示词已注销:" << strName;
     if (bEmitSignal)
     {
+        m_listChangeLog.record(strName, MCPListChangeLog::ChangeType::Removed);
         emit promptChanged(strName);
-        emit promptsListChanged();
+        notifyListChanged();
     }
     return true;
 }
@@ -224,6 +294,28 @@ QJsonArray MCPPromptService::doListImpl() const
     return arrPrompts;
 }
 
+QJsonArray MCPPromptService::doListPageImpl(const QString& strAfterName, int nPageSize, QString& strLastName) const
+{
+    QJsonArray arrPrompts;
+    strLastName.clear();
+    QString strKey;
+    
+    // m_dictPrompts按名称有序，从上一页最后一个名称之后继续
+    auto it = strAfterName.isEmpty() ? m_dictPrompts.constBegin() : m_dictPrompts.upperBound(strAfterName);
+    for (; it != m_dictPrompts.constEnd(); ++it)
+    {
+        if (nPageSize > 0 && arrPrompts.size() >= nPageSize)
+        {
+            strLastName = strKey;
+            break;
+        }
+        arrPrompts.append(it.value()->getMetadata());
+        strKey = it.key();
+    }
+    
+    return arrPrompts;
+}
+
 QJsonObject MCPPromptService::doGetPromptImpl(const QString& strName, const QMap<QString, QString>& arguments)
 {
     if (!m_dictPrompts.contains(strName))
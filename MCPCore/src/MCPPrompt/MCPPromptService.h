@@ -13,6 +13,7 @@
 #include <QJsonArray>
 #include <QString>
 #include "IMCPPromptService.h"
+#include "Utils/MCPListChangeLog.h"
 
 class MCPPrompt;
 struct MCPPromptConfig;
@@ -47,6 +48,7 @@ public:
     bool remove(const QString& strName) override;
     bool has(const QString& strName) const override;
     QJsonArray list() const override;
+    void batchUpdate(const std::function<void()>& fun) override;
     QJsonObject getPrompt(const QString& strName, const QMap<QString, QString>& arguments) override;
     
     bool addFromJson(const QJsonObject& jsonPrompt) override;
@@ -55,6 +57,39 @@ public:
     // 内部方法（供内部使用）
     bool registerPrompt(MCPPrompt* pPrompt);
 
+    /**
+     * @brief 获取一页提示词列表（按提示词名称排序的键集分页，翻页期间增删其他条目不会导致重复或遗漏）
+     * @param strAfterName 上一页最后一个提示词名称，为空表示从头开始
+     * @param nPageSize 每页条目数，0表示不分页
+     * @param strLastName 输出：还有后续条目时为本页最后一个提示词名称，否则为空
+     */
+    QJsonArray listPage(const QString& strAfterName, int nPageSize, QString& strLastName) const;
+
+    /**
+     * @brief 开始批量修改（服务线程内调用，可嵌套）
+     * 
+     * 批量修改期间注册/注销照常记录到变更日志，promptsListChanged信号推迟到最外层endUpdate()时只发送一次
+     */
+    void beginUpdate();
+    
+    /**
+     * @brief 结束批量修改，最外层结束且期间有变化时发送一次列表变化信号
+     */
+    void endUpdate();
+
+    /**
+     * @brief 获取提示词列表当前代数（每次注册/覆盖/注销加1）
+     */
+    quint64 getListGeneration() const;
+
+    /**
+     * @brief 获取自指定代数以来的提示词列表增量
+     * @param nSinceGeneration 起始代数
+     * @param objDelta 输出：{generation, added, changed, removed}
+     * @return false表示差距过大或代数未知，调用方应退化为不带参数的list_changed
+     */
+    bool getListDelta(quint64 nSinceGeneration, QJsonObject& objDelta) const;
+
 signals:
     void promptChanged(const QString& strName);
     /**
@@ -110,6 +145,16 @@ private:
      */
     QJsonArray doListImpl() const;
     
+    /**
+     * @brief 发送提示词列表变化信号（批量修改期间只做标记）
+     */
+    void notifyListChanged();
+    
+    /**
+     * @brief 内部方法：实际执行分页获取提示词列表操作
+     */
+    QJsonArray doListPageImpl(const QString& strAfterName, int nPageSize, QString& strLastName) const;
+    
     /**
      * @brief 内部方法：实际执行获取提示词内容操作
      */
@@ -128,6 +173,9 @@ private:
 
 private:
     QMap<QString, MCPPrompt*> m_dictPrompts;
+    MCPListChangeLog m_listChangeLog;   // 提示词列表变更日志（用于增量list_changed）
+    int m_nUpdateDepth;                 // 批量修改嵌套层数
+    bool m_bListChangedPending;         // 批量修改期间列表是否有变化
 private:
 	friend class MCPServer;
 };
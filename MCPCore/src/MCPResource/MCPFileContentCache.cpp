@@ -0,0 +1,175 @@
+/**
+ * @file MCPFileContentCache.cpp
+ * @brief MCP文件资源内容缓存实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPFileContentCache.h"
+#include "MCPFileResource.h"
+#include "MCPLog/MCPLog.h"
+#include "Utils/MCPResourceContentGenerator.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QMutexLocker>
+#include <climits>
+
+const int MCPFileContentCache::kDefaultMaxBytes;
+const int MCPFileContentCache::kMaxWatchedPaths;
+
+MCPFileContentCache::MCPFileContentCache(QObject* pParent)
+    : QObject(pParent)
+    , m_cache(kDefaultMaxBytes)
+    , m_nHits(0)
+    , m_nMisses(0)
+    , m_nInvalidations(0)
+    , m_pWatcher(new QFileSystemWatcher(this))
+{
+    QObject::connect(m_pWatcher, &QFileSystemWatcher::fileChanged, this, &MCPFileContentCache::onFileChanged);
+}
+
+MCPFileContentCache::~MCPFileContentCache()
+{
+}
+
+QString MCPFileContentCache::getContent(const QString& strFilePath, bool bText)
+{
+    QFileInfo fileInfo(strFilePath);
+    qint64 nSize = fileInfo.size();
+    qint64 nModifiedMs = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        CacheEntry* pEntry = m_cache.object(strFilePath);
+        if (pEntry != nullptr && pEntry->bText == bText
+            && pEntry->nSize == nSize && pEntry->nModifiedMs == nModifiedMs)
+        {
+            ++m_nHits;
+            return pEntry->strContent;
+        }
+        ++m_nMisses;
+    }
+
+    QString strContent = bText
+        ? MCPResourceContentGenerator::readFileAsText(strFilePath)
+        : MCPResourceContentGenerator::readFileAsBase64(strFilePath);
+    if (strContent.isEmpty())
+    {
+        return strContent;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_cache.maxCost() > 0)
+    {
+        // 超过预算的单个文件QCache不会缓存，直接丢弃
+        int nCost = static_cast<int>(qMin<qint64>(static_cast<qint64>(strContent.size()) * sizeof(QChar), INT_MAX));
+        m_cache.insert(strFilePath, new CacheEntry{ strContent, bText, nSize, nModifiedMs }, nCost);
+    }
+    return strContent;
+}
+
+void MCPFileContentCache::watchFile(const QString& strFilePath, MCPFileResource* pResource)
+{
+    if (strFilePath.isEmpty() || pResource == nullptr)
+    {
+        return;
+    }
+
+    auto& lstResources = m_dictWatchedResources[strFilePath];
+    lstResources.append(pResource);
+    if (lstResources.size() > 1)
+    {
+        return;
+    }
+
+    // 超出监听上限或无法监听时，仅依赖大小/修改时间校验
+    if (m_setWatchedPaths.size() >= kMaxWatchedPaths)
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPFileContentCache: 已达到监听上限，仅依赖大小/修改时间校验:" << strFilePath;
+        return;
+    }
+    if (m_pWatcher->addPath(strFilePath))
+    {
+        m_setWatchedPaths.insert(strFilePath);
+    }
+    else
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPFileContentCache: 无法监听文件，仅依赖大小/修改时间校验:" << strFilePath;
+    }
+}
+
+void MCPFileContentCache::unwatchFile(const QString& strFilePath, MCPFileResource* pResource)
+{
+    auto it = m_dictWatchedResources.find(strFilePath);
+    if (it == m_dictWatchedResources.end())
+    {
+        return;
+    }
+
+    it.value().removeAll(pResource);
+    if (it.value().isEmpty())
+    {
+        m_dictWatchedResources.erase(it);
+        if (m_setWatchedPaths.remove(strFilePath))
+        {
+            m_pWatcher->removePath(strFilePath);
+        }
+        QMutexLocker locker(&m_mutex);
+        m_cache.remove(strFilePath);
+    }
+}
+
+void MCPFileContentCache::setMaxBytes(int nMaxBytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.setMaxCost(qMax(0, nMaxBytes));
+}
+
+int MCPFileContentCache::getMaxBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cache.maxCost();
+}
+
+QJsonObject MCPFileContentCache::getStatistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    QJsonObject objStatistics;
+    objStatistics["hits"] = static_cast<double>(m_nHits);
+    objStatistics["misses"] = static_cast<double>(m_nMisses);
+    objStatistics["invalidations"] = static_cast<double>(m_nInvalidations);
+    objStatistics["entries"] = m_cache.count();
+    objStatistics["bytes"] = m_cache.totalCost();
+    objStatistics["maxBytes"] = m_cache.maxCost();
+    objStatistics["watchedFiles"] = m_dictWatchedResources.size();
+    objStatistics["watchedPaths"] = m_setWatchedPaths.size();
+    return objStatistics;
+}
+
+void MCPFileContentCache::onFileChanged(const QString& strFilePath)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_cache.remove(strFilePath);
+        ++m_nInvalidations;
+    }
+
+    // 编辑器原子保存（写临时文件后重命名）会使监听失效，文件仍存在时重新监听
+    if (m_setWatchedPaths.contains(strFilePath) && QFileInfo::exists(strFilePath)
+        && !m_pWatcher->files().contains(strFilePath))
+    {
+        m_pWatcher->addPath(strFilePath);
+    }
+
+    MCP_CORE_LOG_DEBUG() << "MCPFileContentCache: 文件已变化:" << strFilePath;
+    const auto lstResources = m_dictWatchedResources.value(strFilePath);
+    for (const auto& pResource : lstResources)
+    {
+        if (pResource != nullptr)
+        {
+            pResource->notifyChanged();
+        }
+    }
+}
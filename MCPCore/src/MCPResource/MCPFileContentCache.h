@@ -0,0 +1,108 @@
+/**
+ * @file MCPFileContentCache.h
+ * @brief MCP文件资源内容缓存（内部实现）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QPointer>
+#include <QMutex>
+#include <QJsonObject>
+
+class QFileSystemWatcher;
+class MCPFileResource;
+
+/**
+ * @brief MCP文件资源内容缓存
+ *
+ * 职责：
+ * - 按文件路径缓存编码后的资源内容（文本或Base64），同一文件的多个资源共享一份
+ * - 按字节预算做LRU淘汰
+ * - 通过QFileSystemWatcher（Linux下基于inotify）监听文件变化，变化时失效缓存并通知对应资源发出changed信号
+ * - 每次命中前校验文件大小和修改时间，监听漏报（网络文件系统等）时仍能读到新内容
+ * - 监听的文件数有上限（kqueue每个文件占用一个fd，inotify受max_user_watches限制），
+ *   超出后的文件不再监听，只依赖大小/修改时间校验（内容仍是最新的，但不会主动发送变化通知）
+ *
+ * 线程说明：
+ * - 对象属于资源服务所在线程，watchFile/unwatchFile需在该线程调用
+ * - getContent可在任意线程调用
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 指针类型添加 p 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPFileContentCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int kDefaultMaxBytes = 64 * 1024 * 1024;
+    // 监听的文件数上限，与MCPResourceDirectory::kMaxWatchedPaths一致
+    static const int kMaxWatchedPaths = 4096;
+
+public:
+    explicit MCPFileContentCache(QObject* pParent = nullptr);
+    virtual ~MCPFileContentCache();
+
+public:
+    /**
+     * @brief 获取文件内容（命中且文件未变化时直接返回缓存）
+     * @param strFilePath 文件路径
+     * @param bText true读取为文本，false读取为Base64
+     * @return 编码后的内容，读取失败返回空字符串
+     */
+    QString getContent(const QString& strFilePath, bool bText);
+
+    /**
+     * @brief 监听文件变化，变化时调用pResource->notifyChanged()
+     */
+    void watchFile(const QString& strFilePath, MCPFileResource* pResource);
+
+    /**
+     * @brief 取消监听（资源析构时调用）
+     */
+    void unwatchFile(const QString& strFilePath, MCPFileResource* pResource);
+
+    /**
+     * @brief 设置内存预算（字节），0表示禁用缓存（仍然监听文件变化）
+     */
+    void setMaxBytes(int nMaxBytes);
+    int getMaxBytes() const;
+
+    /**
+     * @brief 获取缓存统计
+     * @return {"hits", "misses", "invalidations", "entries", "bytes", "maxBytes", "watchedFiles", "watchedPaths"}
+     */
+    QJsonObject getStatistics() const;
+
+private slots:
+    void onFileChanged(const QString& strFilePath);
+
+private:
+    struct CacheEntry
+    {
+        QString strContent;
+        bool bText;
+        qint64 nSize;
+        qint64 nModifiedMs;
+    };
+
+private:
+    mutable QMutex m_mutex;
+    QCache<QString, CacheEntry> m_cache;    // 以内容字节数作为cost，自动LRU淘汰
+    quint64 m_nHits;
+    quint64 m_nMisses;
+    quint64 m_nInvalidations;
+
+    QFileSystemWatcher* m_pWatcher;
+    QHash<QString, QList<QPointer<MCPFileResource>>> m_dictWatchedResources;  // 文件路径 -> 资源列表
+    QSet<QString> m_setWatchedPaths;        // 实际加入监听器的文件路径（不超过kMaxWatchedPaths）
+};
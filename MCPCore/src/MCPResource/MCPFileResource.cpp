@@ -7,11 +7,13 @@
  */
 
 #include "MCPFileResource.h"
+#include "MCPFileContentCache.h"
 #include "Utils/MCPResourceContentGenerator.h"
+#include "Utils/MCPStreamedFileContent.h"
+#include "Utils/MCPMimeTypes.h"
 #include "MCPLog/MCPLog.h"
+#include <QFile>
 #include <QFileInfo>
-#include <QMimeDatabase>
-#include <QMimeType>
 
 MCPFileResource::MCPFileResource(const QString& strUri,
                                  const QString& strFilePath,
@@ -40,6 +42,10 @@ MCPFileResource::MCPFileResource(const QString& strUri,
 
 MCPFileResource::~MCPFileResource()
 {
+    if (m_pContentCache != nullptr)
+    {
+        m_pContentCache->unwatchFile(m_strFilePath, this);
+    }
 }
 
 QString MCPFileResource::getFilePath() const
@@ -47,6 +53,84 @@ QString MCPFileResource::getFilePath() const
     return m_strFilePath;
 }
 
+void MCPFileResource::setContentCache(MCPFileContentCache* pContentCache)
+{
+    if (m_pContentCache == pContentCache)
+    {
+        return;
+    }
+    if (m_pContentCache != nullptr)
+    {
+        m_pContentCache->unwatchFile(m_strFilePath, this);
+    }
+    m_pContentCache = pContentCache;
+    if (m_pContentCache != nullptr)
+    {
+        m_pContentCache->watchFile(m_strFilePath, this);
+    }
+}
+
+QSharedPointer<MCPStreamedFileContent> MCPFileResource::createStreamedContent(qint64 nThresholdBytes) const
+{
+    return createStreamedFileContent(m_strFilePath, isTextContent(), nThresholdBytes);
+}
+
+QSharedPointer<MCPStreamedFileContent> MCPFileResource::createStreamedFileContent(const QString& strFilePath, bool bText, qint64 nThresholdBytes)
+{
+    if (nThresholdBytes <= 0 || strFilePath.isEmpty())
+    {
+        return QSharedPointer<MCPStreamedFileContent>();
+    }
+    
+    QFileInfo fileInfo(strFilePath);
+    if (!fileInfo.isFile() || fileInfo.size() < nThresholdBytes)
+    {
+        return QSharedPointer<MCPStreamedFileContent>();
+    }
+    
+    auto enEncoding = bText
+        ? MCPStreamedFileContent::Encoding::JsonText
+        : MCPStreamedFileContent::Encoding::Base64;
+    return QSharedPointer<MCPStreamedFileContent>::create(strFilePath, enEncoding);
+}
+
+bool MCPFileResource::supportsRange() const
+{
+    return !m_strFilePath.isEmpty();
+}
+
+bool MCPFileResource::readRange(qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize) const
+{
+    return readFileRange(m_strFilePath, nOffset, nLength, arrData, nTotalSize);
+}
+
+bool MCPFileResource::readFileRange(const QString& strFilePath, qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize)
+{
+    QFile file(strFilePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPFileResource: 无法打开文件:" << strFilePath
+                               << ", 错误:" << file.errorString();
+        return false;
+    }
+    
+    nTotalSize = file.size();
+    arrData.clear();
+    if (nOffset >= nTotalSize || nLength <= 0)
+    {
+        return true;
+    }
+    
+    // 只读取请求区间，不经过内容缓存（缓存的是整个文件）
+    if (!file.seek(nOffset))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPFileResource: 文件定位失败:" << strFilePath << ", 偏移:" << nOffset;
+        return false;
+    }
+    arrData = file.read(qMin(nLength, nTotalSize - nOffset));
+    return true;
+}
+
 std::function<QString()> MCPFileResource::createFileContentProvider() const
 {
     return [this]() -> QString
@@ -58,7 +142,12 @@ std::function<QString()> MCPFileResource::createFileContentProvider() const
         }
         
         // 根据MIME类型决定读取方式
-        if (MCPResourceContentGenerator::isTextMimeType(getMimeType()))
+        bool bText = isTextContent();
+        if (m_pContentCache != nullptr)
+        {
+            return m_pContentCache->getContent(m_strFilePath, bText);
+        }
+        if (bText)
         {
             // 文本类型，直接读取文本内容
             return MCPResourceContentGenerator::readFileAsText(m_strFilePath);
@@ -85,12 +174,11 @@ void MCPFileResource::inferMimeType()
         return;
     }
     
-    // 使用QMimeDatabase根据文件扩展名推断MIME类型
-    QMimeDatabase mimeDb;
-    QMimeType mimeType = mimeDb.mimeTypeForFile(m_strFilePath);
-    if (mimeType.isValid())
+    // 根据文件扩展名推断MIME类型（共享的QMimeDatabase，按扩展名缓存）
+    QString strMimeType = MCPMimeTypes::mimeTypeForFile(m_strFilePath);
+    if (!strMimeType.isEmpty())
     {
-        withMimeType(mimeType.name());
+        withMimeType(strMimeType);
     }
     else
     {
@@ -7,8 +7,13 @@
  */
 
 #pragma once
+#include <QPointer>
+#include <QSharedPointer>
 #include "MCPContentResource.h"
 
+class MCPFileContentCache;
+class MCPStreamedFileContent;
+
 /**
  * @brief MCP文件资源类
  * 
@@ -16,6 +21,9 @@
  * - 实现基于文件路径的资源内容读取
  * - 支持文本和二进制文件
  * - 自动推断MIME类型
+ * - 设置内容缓存后，未变化的文件直接返回缓存内容，文件变化时发出changed信号（支持订阅）
+ * - 大文件可创建流式内容，发送响应时通过mmap直接编码，不经过QString
+ * - 支持按字节范围读取，只读取请求的区间
  * 
  * 注意：
  * - 继承自MCPContentResource，复用链式调用接口（withName、withDescription、withMimeType）
@@ -51,6 +59,43 @@ public:
      */
     QString getFilePath() const;
     
+    /**
+     * @brief 设置共享的文件内容缓存（同时开始监听文件变化）
+     * @param pContentCache 内容缓存，nullptr表示每次读取都直接读文件
+     */
+    void setContentCache(MCPFileContentCache* pContentCache);
+    
+    /**
+     * @brief 为大文件创建流式内容
+     * @param nThresholdBytes 流式阈值（字节），文件不小于该值时才流式发送，<=0表示不流式
+     * @return 流式内容，文件小于阈值或不存在时返回空指针（调用方应回退到readContent()）
+     */
+    QSharedPointer<MCPStreamedFileContent> createStreamedContent(qint64 nThresholdBytes) const;
+    
+    /**
+     * @brief 支持按字节范围读取
+     */
+    bool supportsRange() const override;
+    
+    /**
+     * @brief 定位到nOffset后只读取nLength字节（每次读取独立打开文件，可并发调用）
+     */
+    bool readRange(qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize) const override;
+    
+    /**
+     * @brief 为指定文件创建流式内容（供不创建资源对象的目录挂载使用）
+     * @param strFilePath 文件路径
+     * @param bText true按JSON文本编码，false按Base64编码
+     * @param nThresholdBytes 流式阈值（字节），<=0表示不流式
+     * @return 流式内容，文件小于阈值或不存在时返回空指针
+     */
+    static QSharedPointer<MCPStreamedFileContent> createStreamedFileContent(const QString& strFilePath, bool bText, qint64 nThresholdBytes);
+    
+    /**
+     * @brief 按字节范围读取指定文件（供不创建资源对象的目录挂载使用）
+     */
+    static bool readFileRange(const QString& strFilePath, qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize);
+    
 private:
     /**
      * @brief 根据文件扩展名推断MIME类型
@@ -65,5 +110,6 @@ private:
     
 private:
     QString m_strFilePath;  // 文件路径
+    QPointer<MCPFileContentCache> m_pContentCache;  // 共享内容缓存（属于资源服务）
 };
 
@@ -7,6 +7,7 @@
  */
 
 #include "MCPResource.h"
+#include "Utils/MCPMimeTypes.h"
 #include <QMetaObject>
 #include <QMetaProperty>
 #include <QVariant>
@@ -19,9 +20,11 @@ MCPResource::MCPResource(const QString& strUri,
     , m_strName("")
     , m_strDescription("")
     , m_strMimeType("text/plain")
+    , m_bTextContent(true)
     , m_audience(QJsonArray())
     , m_priority(0.5)  // 默认优先级为 0.5
     , m_strLastModified("")
+    , m_nNotifyDebounceMs(-1)
 {
 }
 
@@ -72,10 +75,16 @@ void MCPResource::setMimeType(const QString& strMimeType)
     if (m_strMimeType != strMimeType)
     {
         m_strMimeType = strMimeType;
+        m_bTextContent = MCPMimeTypes::isText(m_strMimeType);
         emit changed(m_strName, m_strDescription, m_strMimeType);
     }
 }
 
+bool MCPResource::isTextContent() const
+{
+    return m_bTextContent;
+}
+
 void MCPResource::notifyChanged()
 {
     emit changed(m_strName, m_strDescription, m_strMimeType);
@@ -138,6 +147,20 @@ QString MCPResource::getContent() const
     return readContent();
 }
 
+bool MCPResource::supportsRange() const
+{
+    return false;
+}
+
+bool MCPResource::readRange(qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize) const
+{
+    Q_UNUSED(nOffset);
+    Q_UNUSED(nLength);
+    Q_UNUSED(arrData);
+    Q_UNUSED(nTotalSize);
+    return false;
+}
+
 QJsonObject MCPResource::getAnnotations() const
 {
     QJsonObject annotations;
@@ -248,3 +271,13 @@ void MCPResource::updateLastModified()
     m_strLastModified = now.toString(Qt::ISODate);
 }
 
+void MCPResource::setNotifyDebounce(int nDebounceMs)
+{
+    m_nNotifyDebounceMs = nDebounceMs < 0 ? -1 : nDebounceMs;
+}
+
+int MCPResource::getNotifyDebounce() const
+{
+    return m_nNotifyDebounceMs;
+}
+
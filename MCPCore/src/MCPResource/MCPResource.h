@@ -11,6 +11,7 @@
 #include <QString>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QByteArray>
 #include <QDateTime>
 
 /**
@@ -117,6 +118,12 @@ public:
      */
     void setMimeType(const QString& strMimeType);
     
+    /**
+     * @brief 内容是否按文本传输（text字段），否则按二进制传输（blob字段）
+     * @return 设置MIME类型时计算并保存的结果，读取和通知时不再重复判断
+     */
+    bool isTextContent() const;
+    
     /**
      * @brief 设置资源注解（Annotations）
      * @param annotations 注解对象
@@ -169,6 +176,19 @@ public:
      */
     void updateLastModified();
     
+    /**
+     * @brief 设置变化通知的合并窗口
+     * @param nDebounceMs 窗口毫秒数：窗口内的多次变化只发送一次通知；
+     *                    0表示立即通知，-1表示使用服务器全局配置（默认）
+     */
+    void setNotifyDebounce(int nDebounceMs);
+    
+    /**
+     * @brief 获取变化通知的合并窗口
+     * @return 窗口毫秒数，-1表示使用服务器全局配置
+     */
+    int getNotifyDebounce() const;
+    
     /**
      * @brief 通知资源变化
      * 手动触发资源变化信号，用于内容变化时通知订阅者
@@ -233,14 +253,35 @@ public:
      * 注意：此方法不是slot，因为它是纯虚函数，需要通过 getContent() slot 来调用
      */
     virtual QString readContent() const = 0;    
+    
+    /**
+     * @brief 是否支持按字节范围读取（resources/read的offset/length/cursor参数）
+     * @return 默认返回false，子类实现readRange()后重写为true
+     */
+    virtual bool supportsRange() const;
+    
+    /**
+     * @brief 按字节范围读取资源内容
+     * @param nOffset 起始字节偏移
+     * @param nLength 最多读取的字节数
+     * @param arrData 输出：读取到的原始字节（文本为UTF-8，二进制未经Base64编码）
+     * @param nTotalSize 输出：资源内容总字节数
+     * @return 成功返回true；默认实现返回false
+     * 
+     * 注意：nOffset超出总大小时应返回true且arrData为空，由调用方根据nTotalSize判断
+     */
+    virtual bool readRange(qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize) const;
 protected:
     QString m_strUri;
     QString m_strName;
     QString m_strDescription;
     QString m_strMimeType;
+    bool m_bTextContent;           // 由m_strMimeType决定，修改m_strMimeType时同步更新
     
     // 资源注解（Annotations），根据 MCP 协议规范
     QJsonArray m_audience;        // 目标受众数组，有效值为 "user" 和 "assistant"
     double m_priority;             // 优先级，范围 0.0 到 1.0
     QString m_strLastModified;     // 最后修改时间，ISO 8601 格式
+    
+    int m_nNotifyDebounceMs;       // 变化通知合并窗口（毫秒），-1表示使用全局配置
 };
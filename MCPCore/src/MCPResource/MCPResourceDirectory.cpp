@@ -0,0 +1,373 @@
+/**
+ * @file MCPResourceDirectory.cpp
+ * @brief MCP目录资源实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPResourceDirectory.h"
+#include "MCPLog/MCPLog.h"
+#include "Utils/MCPMimeTypes.h"
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QFileSystemWatcher>
+#include <algorithm>
+
+const int MCPResourceDirectory::kMaxWatchedPaths;
+
+MCPResourceDirectory::MCPResourceDirectory(const QString& strUriPrefix,
+                                           const QString& strDirectoryPath,
+                                           QObject* pParent)
+    : QObject(pParent)
+    , m_strUriPrefix(normalizeUriPrefix(strUriPrefix))
+    , m_rootDir(QDir(strDirectoryPath).absolutePath())
+    , m_strDefaultMimeType("text/plain")
+    , m_pWatcher(new QFileSystemWatcher(this))
+{
+    m_strCanonicalRoot = m_rootDir.canonicalPath();
+    if (!m_strCanonicalRoot.endsWith('/'))
+    {
+        m_strCanonicalRoot += '/';
+    }
+
+    QObject::connect(m_pWatcher, &QFileSystemWatcher::directoryChanged, this, &MCPResourceDirectory::onDirectoryChanged);
+    QObject::connect(m_pWatcher, &QFileSystemWatcher::fileChanged, this, &MCPResourceDirectory::onFileChanged);
+}
+
+MCPResourceDirectory::~MCPResourceDirectory()
+{
+}
+
+QString MCPResourceDirectory::normalizeUriPrefix(const QString& strUriPrefix)
+{
+    if (strUriPrefix.isEmpty() || strUriPrefix.endsWith('/'))
+    {
+        return strUriPrefix;
+    }
+    return strUriPrefix + '/';
+}
+
+QString MCPResourceDirectory::getUriPrefix() const
+{
+    return m_strUriPrefix;
+}
+
+QString MCPResourceDirectory::getDirectoryPath() const
+{
+    return m_rootDir.absolutePath();
+}
+
+void MCPResourceDirectory::setDefaultMimeType(const QString& strMimeType)
+{
+    m_strDefaultMimeType = strMimeType.isEmpty() ? QString("text/plain") : strMimeType;
+}
+
+void MCPResourceDirectory::setAnnotations(const QJsonObject& annotations)
+{
+    m_annotations = annotations;
+}
+
+QString MCPResourceDirectory::getFilePath(const QString& strUri) const
+{
+    if (!strUri.startsWith(m_strUriPrefix))
+    {
+        return QString();
+    }
+
+    // 与列表一致：拒绝空路径段、"."、".."和隐藏文件，避免通过URI访问挂载目录之外的文件
+    const QString strRelPath = strUri.mid(m_strUriPrefix.size());
+    if (strRelPath.isEmpty() || strRelPath.contains('\\'))
+    {
+        return QString();
+    }
+    for (const QString& strSegment : strRelPath.split('/'))
+    {
+        if (strSegment.isEmpty() || strSegment.startsWith('.'))
+        {
+            return QString();
+        }
+    }
+
+    const QString strFilePath = m_rootDir.filePath(strRelPath);
+    QFileInfo fileInfo(strFilePath);
+    if (!fileInfo.isFile())
+    {
+        return QString();
+    }
+
+    // 路径中的符号链接可能指向挂载目录之外
+    if (!fileInfo.canonicalFilePath().startsWith(m_strCanonicalRoot))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceDirectory: 文件位于挂载目录之外，拒绝访问:" << strUri;
+        return QString();
+    }
+    return strFilePath;
+}
+
+QString MCPResourceDirectory::getMimeType(const QString& strFilePath) const
+{
+    QString strMimeType = MCPMimeTypes::mimeTypeForFile(strFilePath, false);
+    return strMimeType.isEmpty() ? m_strDefaultMimeType : strMimeType;
+}
+
+QJsonObject MCPResourceDirectory::getMetadata(const QString& strUri) const
+{
+    const QString strRelPath = strUri.mid(m_strUriPrefix.size());
+
+    QJsonObject metadata;
+    metadata["name"] = strRelPath.mid(strRelPath.lastIndexOf('/') + 1);
+    metadata["mimeType"] = getMimeType(m_rootDir.filePath(strRelPath));
+    if (!m_annotations.isEmpty())
+    {
+        metadata["annotations"] = m_annotations;
+    }
+    return metadata;
+}
+
+bool MCPResourceDirectory::listFiles(const QString& strAfterUri, int nMaxCount, QStringList& lstUris)
+{
+    if (strAfterUri.isEmpty() || strAfterUri < m_strUriPrefix)
+    {
+        return listDirectory(QString(), nullptr, nMaxCount, lstUris);
+    }
+    if (!strAfterUri.startsWith(m_strUriPrefix))
+    {
+        // 大于前缀又不以前缀开头，说明挂载下的所有URI都在它之前
+        return false;
+    }
+    const QString strAfter = strAfterUri.mid(m_strUriPrefix.size());
+    return listDirectory(QString(), &strAfter, nMaxCount, lstUris);
+}
+
+bool MCPResourceDirectory::listDirectory(const QString& strRelDir, const QString* pAfter, int nMaxCount, QStringList& lstUris)
+{
+    const QStringList lstEntries = entries(strRelDir);
+    for (const QString& strEntry : lstEntries)
+    {
+        if (strEntry.endsWith('/'))
+        {
+            const QString* pChildAfter = nullptr;
+            QString strChildAfter;
+            if (pAfter != nullptr)
+            {
+                if (pAfter->startsWith(strEntry))
+                {
+                    // 起始位置在该子目录内，只列出它之后的部分
+                    strChildAfter = pAfter->mid(strEntry.size());
+                    pChildAfter = &strChildAfter;
+                }
+                else if (strEntry < *pAfter)
+                {
+                    // 整棵子树都在起始位置之前，不需要列出
+                    continue;
+                }
+            }
+            if (listDirectory(strRelDir + strEntry, pChildAfter, nMaxCount, lstUris))
+            {
+                return true;
+            }
+            continue;
+        }
+
+        if (pAfter != nullptr && strEntry <= *pAfter)
+        {
+            continue;
+        }
+        if (nMaxCount > 0 && lstUris.size() >= nMaxCount)
+        {
+            return true;
+        }
+        lstUris.append(m_strUriPrefix + strRelDir + strEntry);
+    }
+    return false;
+}
+
+QStringList MCPResourceDirectory::entries(const QString& strRelDir)
+{
+    auto it = m_dictDirEntries.constFind(strRelDir);
+    if (it != m_dictDirEntries.constEnd())
+    {
+        return it.value();
+    }
+
+    QStringList lstEntries = scanDirectory(strRelDir);
+
+    // 监听后目录列表由变化通知保持最新，可以缓存；超出监听上限时每次重新读取
+    if (m_dictDirEntries.size() < kMaxWatchedPaths && m_pWatcher->addPath(absolutePath(strRelDir)))
+    {
+        m_dictDirEntries.insert(strRelDir, lstEntries);
+    }
+    return lstEntries;
+}
+
+QStringList MCPResourceDirectory::scanDirectory(const QString& strRelDir) const
+{
+    QDir dir(absolutePath(strRelDir));
+    const QFileInfoList lstFileInfos = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks,
+                                                         QDir::Unsorted);
+
+    // 目录名带上'/'后一起排序，深度优先遍历的顺序就是URI的字典序（如 "a.txt" < "a/b.txt"）
+    QStringList lstEntries;
+    lstEntries.reserve(lstFileInfos.size());
+    for (const QFileInfo& fileInfo : lstFileInfos)
+    {
+        // 与getFilePath()使用同一规则：Windows下'.'开头的文件不是隐藏文件，QDir不会过滤，需要显式跳过
+        const QString strFileName = fileInfo.fileName();
+        if (strFileName.startsWith('.'))
+        {
+            continue;
+        }
+        lstEntries.append(fileInfo.isDir() ? strFileName + '/' : strFileName);
+    }
+    std::sort(lstEntries.begin(), lstEntries.end());
+    return lstEntries;
+}
+
+void MCPResourceDirectory::watchFile(const QString& strFilePath)
+{
+    if (m_setWatchedFiles.contains(strFilePath) || m_setWatchedFiles.size() >= kMaxWatchedPaths)
+    {
+        return;
+    }
+    if (m_pWatcher->addPath(strFilePath))
+    {
+        m_setWatchedFiles.insert(strFilePath);
+    }
+}
+
+void MCPResourceDirectory::unwatchDirectory(const QString& strRelDir)
+{
+    QStringList lstRemoved;
+    for (auto it = m_dictDirEntries.begin(); it != m_dictDirEntries.end();)
+    {
+        if (it.key().startsWith(strRelDir))
+        {
+            lstRemoved.append(absolutePath(it.key()));
+            it = m_dictDirEntries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    const QString strAbsDir = absolutePath(strRelDir) + '/';
+    for (auto it = m_setWatchedFiles.begin(); it != m_setWatchedFiles.end();)
+    {
+        if (it->startsWith(strAbsDir))
+        {
+            lstRemoved.append(*it);
+            it = m_setWatchedFiles.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    if (!lstRemoved.isEmpty())
+    {
+        m_pWatcher->removePaths(lstRemoved);
+    }
+}
+
+void MCPResourceDirectory::onDirectoryChanged(const QString& strPath)
+{
+    const QString strRelDir = relativeDirectory(strPath);
+    auto it = m_dictDirEntries.find(strRelDir);
+    if (it == m_dictDirEntries.end())
+    {
+        return;
+    }
+
+    if (!QFileInfo(strPath).isDir())
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPResourceDirectory: 目录已删除:" << strPath;
+        unwatchDirectory(strRelDir);
+        emit treeChanged();
+        return;
+    }
+
+    const QStringList lstOld = it.value();
+    const QStringList lstNew = scanDirectory(strRelDir);
+    it.value() = lstNew;
+
+    // 新旧列表都已排序，归并比较得出增删的子项
+    bool bTreeChanged = false;
+    int i = 0;
+    int j = 0;
+    while (i < lstOld.size() || j < lstNew.size())
+    {
+        if (j >= lstNew.size() || (i < lstOld.size() && lstOld.at(i) < lstNew.at(j)))
+        {
+            const QString& strEntry = lstOld.at(i++);
+            if (strEntry.endsWith('/'))
+            {
+                unwatchDirectory(strRelDir + strEntry);
+                bTreeChanged = true;
+            }
+            else
+            {
+                m_setWatchedFiles.remove(absolutePath(strRelDir + strEntry));
+                emit fileRemoved(m_strUriPrefix + strRelDir + strEntry);
+            }
+        }
+        else if (i >= lstOld.size() || lstNew.at(j) < lstOld.at(i))
+        {
+            const QString& strEntry = lstNew.at(j++);
+            if (strEntry.endsWith('/'))
+            {
+                bTreeChanged = true;
+            }
+            else
+            {
+                emit fileAdded(m_strUriPrefix + strRelDir + strEntry);
+            }
+        }
+        else
+        {
+            ++i;
+            ++j;
+        }
+    }
+
+    if (bTreeChanged)
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPResourceDirectory: 子目录已变化:" << strPath;
+        emit treeChanged();
+    }
+}
+
+void MCPResourceDirectory::onFileChanged(const QString& strPath)
+{
+    if (!QFileInfo::exists(strPath))
+    {
+        // 文件删除由所在目录的变化通知处理
+        m_setWatchedFiles.remove(strPath);
+        return;
+    }
+
+    // 编辑器原子保存（写临时文件后重命名）会使监听失效，重新监听
+    if (!m_pWatcher->files().contains(strPath))
+    {
+        m_pWatcher->addPath(strPath);
+    }
+
+    const QString strRelPath = m_rootDir.relativeFilePath(strPath);
+    emit fileChanged(m_strUriPrefix + strRelPath);
+}
+
+QString MCPResourceDirectory::absolutePath(const QString& strRelPath) const
+{
+    // 相对目录以'/'结尾，去掉后与监听器上报的路径一致
+    return strRelPath.isEmpty() ? m_rootDir.absolutePath() : QDir::cleanPath(m_rootDir.filePath(strRelPath));
+}
+
+QString MCPResourceDirectory::relativeDirectory(const QString& strAbsPath) const
+{
+    const QString strRelPath = m_rootDir.relativeFilePath(strAbsPath);
+    if (strRelPath.isEmpty() || strRelPath == ".")
+    {
+        return QString();
+    }
+    return strRelPath + '/';
+}
@@ -0,0 +1,173 @@
+/**
+ * @file MCPResourceDirectory.h
+ * @brief MCP目录资源（将文件系统子树挂载到URI前缀下，内部实现）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QObject>
+#include <QDir>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+
+class QFileSystemWatcher;
+
+/**
+ * @brief MCP目录资源
+ *
+ * 职责：
+ * - 将目录子树挂载到URI前缀下，前缀之后的相对路径即文件路径（如 file:///project/ + src/main.cpp）
+ * - 不为文件创建资源对象：注册时不遍历目录，resources/list 翻页时才按需列出经过的目录，
+ *   resources/read 时才打开文件，启动耗时与目录大小无关
+ * - 按URI排序分页：目录内子项排序时目录名视为带'/'结尾，深度优先遍历的顺序即URI字典序，
+ *   翻页时只沿上一页最后一个URI所在的路径下降，跳过之前的子树
+ * - 通过QFileSystemWatcher（Linux下基于inotify）监听列出过的目录和读取过的文件，
+ *   文件增删、内容变化和子目录变化分别发出信号
+ *
+ * 约定：
+ * - 隐藏文件（以'.'开头）和符号链接不对外提供，相对路径中不允许出现 "."、".."
+ * - MIME类型只按文件名推断（列表时不读取文件内容），无法推断时使用默认MIME类型
+ * - 对象属于资源服务所在线程，所有方法需在该线程调用
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPResourceDirectory : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 监听的目录数和文件数各自的上限（inotify监听数受系统限制），超出后不再缓存目录列表、不再监听文件
+    static const int kMaxWatchedPaths = 4096;
+
+public:
+    /**
+     * @brief 构造函数
+     * @param strUriPrefix URI前缀，不以'/'结尾时自动补上
+     * @param strDirectoryPath 挂载的目录路径
+     * @param pParent 父对象
+     */
+    explicit MCPResourceDirectory(const QString& strUriPrefix,
+                                  const QString& strDirectoryPath,
+                                  QObject* pParent = nullptr);
+    virtual ~MCPResourceDirectory();
+
+public:
+    /**
+     * @brief 规范化URI前缀（补上结尾的'/'）
+     */
+    static QString normalizeUriPrefix(const QString& strUriPrefix);
+
+    QString getUriPrefix() const;
+    QString getDirectoryPath() const;
+
+    /**
+     * @brief 设置默认MIME类型（按文件名无法推断时使用），默认text/plain
+     */
+    void setDefaultMimeType(const QString& strMimeType);
+
+    /**
+     * @brief 设置所有文件共用的注解
+     */
+    void setAnnotations(const QJsonObject& annotations);
+
+    /**
+     * @brief 获取URI对应的文件路径
+     * @return 文件路径，URI不在挂载范围内、文件不存在或位于挂载目录之外时返回空字符串
+     */
+    QString getFilePath(const QString& strUri) const;
+
+    /**
+     * @brief 获取文件的MIME类型（只按文件名推断）
+     */
+    QString getMimeType(const QString& strFilePath) const;
+
+    /**
+     * @brief 获取资源元数据（不包含uri，格式同MCPResource::getMetadata()）
+     */
+    QJsonObject getMetadata(const QString& strUri) const;
+
+    /**
+     * @brief 按URI顺序列出文件
+     * @param strAfterUri 只列出大于该URI的文件，为空表示从头开始
+     * @param nMaxCount 最多列出的文件数，0表示不限制
+     * @param lstUris 输出：文件URI（追加）
+     * @return true表示达到nMaxCount后还有后续文件
+     */
+    bool listFiles(const QString& strAfterUri, int nMaxCount, QStringList& lstUris);
+
+    /**
+     * @brief 监听文件内容变化（读取或订阅文件时调用）
+     */
+    void watchFile(const QString& strFilePath);
+
+signals:
+    /**
+     * @brief 列出过的目录中新增了文件
+     */
+    void fileAdded(const QString& strUri);
+
+    /**
+     * @brief 列出过的目录中删除了文件
+     */
+    void fileRemoved(const QString& strUri);
+
+    /**
+     * @brief 监听中的文件内容变化
+     */
+    void fileChanged(const QString& strUri);
+
+    /**
+     * @brief 子目录增删或目录本身被删除，无法逐个给出变化的文件
+     */
+    void treeChanged();
+
+private slots:
+    void onDirectoryChanged(const QString& strPath);
+    void onFileChanged(const QString& strPath);
+
+private:
+    /**
+     * @brief 获取目录的排序子项（子目录以'/'结尾），已监听的目录直接返回缓存
+     * @param strRelDir 相对目录路径，以'/'结尾，根目录为空字符串
+     */
+    QStringList entries(const QString& strRelDir);
+
+    /**
+     * @brief 读取目录的排序子项
+     */
+    QStringList scanDirectory(const QString& strRelDir) const;
+
+    /**
+     * @brief 深度优先列出目录下的文件
+     * @param pAfter 相对strRelDir的起始位置，只列出大于它的文件，nullptr表示列出全部
+     * @return true表示达到nMaxCount后还有后续文件
+     */
+    bool listDirectory(const QString& strRelDir, const QString* pAfter, int nMaxCount, QStringList& lstUris);
+
+    /**
+     * @brief 取消监听目录及其所有已监听的子目录
+     */
+    void unwatchDirectory(const QString& strRelDir);
+
+    QString absolutePath(const QString& strRelPath) const;
+    QString relativeDirectory(const QString& strAbsPath) const;
+
+private:
+    QString m_strUriPrefix;                 // URI前缀（以'/'结尾）
+    QDir m_rootDir;                         // 挂载目录
+    QString m_strCanonicalRoot;             // 挂载目录的规范路径（以'/'结尾），用于检查文件是否位于目录内
+    QString m_strDefaultMimeType;           // 无法推断时的MIME类型
+    QJsonObject m_annotations;              // 所有文件共用的注解
+
+    QFileSystemWatcher* m_pWatcher;
+    QHash<QString, QStringList> m_dictDirEntries;   // 已监听的相对目录 -> 排序子项（目录变化时更新）
+    QSet<QString> m_setWatchedFiles;                // 已监听的文件路径
+};
@@ -10,16 +10,71 @@
 #include "MCPResource.h"
 #include "MCPContentResource.h"
 #include "MCPFileResource.h"
+#include "MCPFileContentCache.h"
 #include "MCPResourceWrapper.h"
+#include "MCPResourceTemplate.h"
+#include "MCPResourceDirectory.h"
 #include "MCPLog.h"
 #include "Utils/MCPInvokeHelper.h"
 #include "MCPConfig/MCPResourcesConfig.h"
 #include "Utils/MCPHandlerResolver.h"
 #include <QSet>
-#include "Utils/MCPResourceContentGenerator.h"
+#include "Utils/MCPStreamedFileContent.h"
+#include "Utils/MCPBase64Encoder.h"
+#include "Utils/MCPCursor.h"
+#include "Utils/MCPMimeTypes.h"
+#include <QFileInfo>
+
+const qint64 MCPResourceService::kMaxRangeBytes;
+
+namespace
+{
+    /**
+     * 文本区间按UTF-8字符边界对齐：跳过开头的续字节（offset落在字符中间时），
+     * 去掉结尾不完整的多字节序列（留给下一段），保证每段都能独立解码
+     */
+    void alignUtf8Range(QByteArray& arrData, qint64& nOffset, bool bHasMore)
+    {
+        int nStart = 0;
+        if (nOffset > 0)
+        {
+            while (nStart < arrData.size() && nStart < 3 && (static_cast<uchar>(arrData.at(nStart)) & 0xC0) == 0x80)
+            {
+                ++nStart;
+            }
+        }
+        
+        int nEnd = arrData.size();
+        if (bHasMore && nEnd > nStart)
+        {
+            int nLead = nEnd - 1;
+            while (nLead > nStart && nLead > nEnd - 4 && (static_cast<uchar>(arrData.at(nLead)) & 0xC0) == 0x80)
+            {
+                --nLead;
+            }
+            const uchar ch = static_cast<uchar>(arrData.at(nLead));
+            const int nSequenceLength = (ch & 0xE0) == 0xC0 ? 2 : (ch & 0xF0) == 0xE0 ? 3 : (ch & 0xF8) == 0xF0 ? 4 : 1;
+            // 区间只有一个不完整字符时保留，避免续读游标原地不动
+            if (nLead + nSequenceLength > nEnd && nLead > nStart)
+            {
+                nEnd = nLead;
+            }
+        }
+        
+        if (nStart > 0 || nEnd < arrData.size())
+        {
+            arrData = arrData.mid(nStart, nEnd - nStart);
+            nOffset += nStart;
+        }
+    }
+}
 
 MCPResourceService::MCPResourceService(QObject* pParent)
     : IMCPResourceService(pParent)
+    , m_nUpdateDepth(0)
+    , m_bListChangedPending(false)
+    , m_pFileContentCache(new MCPFileContentCache(this))
+    , m_nFileStreamThresholdBytes(1024 * 1024)
 {
 
 }
@@ -35,7 +90,7 @@ MCPResourceService::~MCPResourceService()
         }
     }
     m_dictResources.clear();
-    m_subscriptions.clear();
+    m_subscriptionIndex.clear();
     m_sessionSubscriptions.clear();
 }
 
@@ -66,7 +121,8 @@ bool MCPResourceService::add(const QString& strUri,
 bool MCPResourceService::registerResource(const QString& strUri, MCPResource* pResource)
 {
     // 如果已存在，先删除旧的（覆盖），不发送信号，因为后面注册新对象时会发送
-    if (m_dictResources.contains(strUri))
+    bool bReplaced = m_dictResources.contains(strUri);
+    if (bReplaced)
     {
         MCP_CORE_LOG_INFO() << "MCPResourceService: 资源已存在，覆盖旧资源:" << strUri;
         doRemoveImpl(strUri, false);
@@ -74,6 +130,7 @@ bool MCPResourceService::registerResource(const QString& strUri, MCPResource* pR
     
     m_dictResources[strUri] = pResource;
     MCP_CORE_LOG_INFO() << "MCPResourceService: 资源已注册:" << strUri;
+    m_listChangeLog.record(strUri, bReplaced ? MCPListChangeLog::ChangeType::Changed : MCPListChangeLog::ChangeType::Added);
     
     // 连接资源的 changed 信号到 resourceContentChanged(QString) 信号
     // 这样当资源的元数据（name、description、mimeType）或内容变化时，会通知订阅者
@@ -90,8 +147,15 @@ bool MCPResourceService::registerResource(const QString& strUri, MCPResource* pR
         emit resourceDeleted(strUri);  // 通知订阅者资源已删除
     });
     
-    emit resourceContentChanged(strUri);  // 通知订阅者（订阅机制）- 资源注册
-    emit resourcesListChanged();    // 通知所有客户端（广播通知）
+    if (m_nUpdateDepth > 0)
+    {
+        m_setPendingRegisteredUris.insert(strUri);  // 批量修改结束时统一通知订阅者
+    }
+    else
+    {
+        emit resourceContentChanged(strUri);  // 通知订阅者（订阅机制）- 资源注册
+    }
+    notifyListChanged();    // 通知所有客户端（广播通知）
     return true;
 }
 
@@ -121,6 +185,90 @@ QJsonArray MCPResourceService::list(const QString& strUriPrefix) const
     return arrResult;
 }
 
+QJsonArray MCPResourceService::listPage(const QString& strAfterUri, int nPageSize, QString& strLastUri) const
+{
+    QJsonArray arrResult;
+    MCPInvokeHelper::syncInvoke(const_cast<MCPResourceService*>(this), [this, &arrResult, strAfterUri, nPageSize, &strLastUri]()
+    {
+        arrResult = doListPageImpl(strAfterUri, nPageSize, strLastUri);
+    });
+    return arrResult;
+}
+
+void MCPResourceService::batchUpdate(const std::function<void()>& fun)
+{
+    MCPInvokeHelper::syncInvoke(this, [this, &fun]()
+    {
+        beginUpdate();
+        fun();
+        endUpdate();
+    });
+}
+
+void MCPResourceService::beginUpdate()
+{
+    ++m_nUpdateDepth;
+}
+
+void MCPResourceService::endUpdate()
+{
+    if (m_nUpdateDepth <= 0 || --m_nUpdateDepth > 0)
+    {
+        return;
+    }
+    
+    // 新注册的URI大多没有订阅者，只对仍存在且有订阅者的发送信号，避免逐个触发通知处理
+    QSet<QString> setRegisteredUris;
+    setRegisteredUris.swap(m_setPendingRegisteredUris);
+    for (const QString& strUri : setRegisteredUris)
+    {
+        if (m_dictResources.contains(strUri) && m_subscriptionIndex.hasSubscribers(strUri))
+        {
+            emit resourceContentChanged(strUri);
+        }
+    }
+    
+    if (m_bListChangedPending)
+    {
+        m_bListChangedPending = false;
+        emit resourcesListChanged();
+    }
+}
+
+void MCPResourceService::notifyListChanged()
+{
+    if (m_nUpdateDepth > 0)
+    {
+        m_bListChangedPending = true;
+        return;
+    }
+    emit resourcesListChanged();
+}
+
+quint64 MCPResourceService::getListGeneration() const
+{
+    return m_listChangeLog.getGeneration();
+}
+
+bool MCPResourceService::getListDelta(quint64 nSinceGeneration, QJsonObject& objDelta) const
+{
+    bool bSuccess = false;
+    MCPInvokeHelper::syncInvoke(const_cast<MCPResourceService*>(this), [this, nSinceGeneration, &objDelta, &bSuccess]()
+    {
+        bSuccess = m_listChangeLog.buildDelta(nSinceGeneration, [this](const QString& strUri) -> QJsonObject
+        {
+            QJsonObject metadata = getResourceMetadata(strUri);
+            if (metadata.isEmpty())
+            {
+                return QJsonObject();
+            }
+            metadata["uri"] = strUri;
+            return metadata;
+        }, objDelta);
+    });
+    return bSuccess;
+}
+
 QJsonObject MCPResourceService::readResource(const QString& strUri)
 {
     QJsonObject objResult;
@@ -131,6 +279,102 @@ QJsonObject MCPResourceService::readResource(const QString& strUri)
     return objResult;
 }
 
+QJsonObject MCPResourceService::readResourceStreamed(const QString& strUri, QList<QSharedPointer<MCPStreamedFileContent>>& lstStreamedContents)
+{
+    QJsonObject objResult;
+    MCPInvokeHelper::syncInvoke(this, [this, &objResult, &lstStreamedContents, strUri]()
+    {
+        objResult = doReadResourceImpl(strUri, &lstStreamedContents);
+    });
+    return objResult;
+}
+
+bool MCPResourceService::addTemplate(const QString& strUriTemplate,
+                                     const QString& strName,
+                                     const QString& strDescription,
+                                     const QString& strMimeType,
+                                     std::function<QString(const QMap<QString, QString>&)> contentProvider)
+{
+    return MCPInvokeHelper::syncInvokeReturn(this, [this, strUriTemplate, strName, strDescription, strMimeType, contentProvider]()
+    {
+        if (m_dictTemplates.contains(strUriTemplate))
+        {
+            MCP_CORE_LOG_WARNING() << "MCPResourceService: 资源模板已存在:" << strUriTemplate;
+            return false;
+        }
+        
+        QString strError;
+        if (!m_templateMatcher.insert(strUriTemplate, &strError))
+        {
+            MCP_CORE_LOG_WARNING() << "MCPResourceService: 资源模板注册失败:" << strUriTemplate << "," << strError;
+            return false;
+        }
+        
+        m_dictTemplates[strUriTemplate] = QSharedPointer<MCPResourceTemplate>::create(
+            strUriTemplate, strName, strDescription, strMimeType, contentProvider);
+        MCP_CORE_LOG_INFO() << "MCPResourceService: 资源模板已注册:" << strUriTemplate;
+        return true;
+    });
+}
+
+bool MCPResourceService::removeTemplate(const QString& strUriTemplate)
+{
+    return MCPInvokeHelper::syncInvokeReturn(this, [this, strUriTemplate]()
+    {
+        if (m_dictTemplates.remove(strUriTemplate) == 0)
+        {
+            return false;
+        }
+        m_templateMatcher.remove(strUriTemplate);
+        MCP_CORE_LOG_INFO() << "MCPResourceService: 资源模板已注销:" << strUriTemplate;
+        return true;
+    });
+}
+
+QJsonArray MCPResourceService::listTemplates() const
+{
+    QJsonArray arrTemplates;
+    MCPInvokeHelper::syncInvoke(const_cast<MCPResourceService*>(this), [this, &arrTemplates]()
+    {
+        for (const auto& pTemplate : m_dictTemplates)
+        {
+            arrTemplates.append(pTemplate->getMetadata());
+        }
+    });
+    return arrTemplates;
+}
+
+bool MCPResourceService::addDirectory(const QString& strUriPrefix, const QString& strDirectoryPath)
+{
+    return MCPInvokeHelper::syncInvokeReturn(this, [this, strUriPrefix, strDirectoryPath]()
+    {
+        return doAddDirectoryImpl(strUriPrefix, strDirectoryPath) != nullptr;
+    });
+}
+
+bool MCPResourceService::removeDirectory(const QString& strUriPrefix)
+{
+    return MCPInvokeHelper::syncInvokeReturn(this, [this, strUriPrefix]()
+    {
+        return doRemoveDirectoryImpl(strUriPrefix);
+    });
+}
+
+bool MCPResourceService::isRangeRequest(const QJsonObject& objParams)
+{
+    return objParams.contains("offset") || objParams.contains("length") || objParams.contains("cursor");
+}
+
+QJsonObject MCPResourceService::readResourceRange(const QString& strUri, const QJsonObject& objParams, QString& strError)
+{
+    QJsonObject objResult;
+    MCPInvokeHelper::syncInvoke(this, [this, &objResult, &strError, strUri, objParams]()
+    {
+        objResult = doReadResourceRangeImpl(strUri, objParams, strError);
+    });
+    return objResult;
+}
+
 bool MCPResourceService::addFromJson(const QJsonObject& jsonResource, QObject* pSearchRoot)
 {
     return MCPInvokeHelper::syncInvokeReturn(this, [this, jsonResource, pSearchRoot]()
@@ -152,7 +396,11 @@ bool MCPResourceService::addFromConfig(const MCPResourceConfig& resourceConfig,
     else if (resourceConfig.strType == "wrapper")
     {
         return addWrapperResourceFromConfig(resourceConfig, dictHandlers);
-    }        
+    }
+    else if (resourceConfig.strType == "directory")
+    {
+        return addDirectoryResourceFromConfig(resourceConfig);
+    }
     return addContentResourceFromConfig(resourceConfig);
 }
 
@@ -178,6 +426,7 @@ bool MCPResourceService::addFileResourceFromConfig(const MCPResourceConfig& reso
     if (pResource != nullptr)
     {
         applyAnnotationsIfNeeded(pResource, resourceConfig.annotations);
+        pResource->setNotifyDebounce(resourceConfig.nNotifyDebounceMs);
     }
     
     return pResource != nullptr;
@@ -230,6 +479,7 @@ bool MCPResourceService::addWrapperResourceFromConfig(const MCPResourceConfig& r
     if (bSuccess)
     {
         applyAnnotationsIfNeeded(pWrapper, resourceConfig.annotations);
+        pWrapper->setNotifyDebounce(resourceConfig.nNotifyDebounceMs);
     }
     
     return bSuccess;
@@ -260,11 +510,34 @@ bool MCPResourceService::addContentResourceFromConfig(const MCPResourceConfig& r
     if (pResource != nullptr)
     {
         applyAnnotationsIfNeeded(pResource, resourceConfig.annotations);
+        pResource->setNotifyDebounce(resourceConfig.nNotifyDebounceMs);
     }
     
     return pResource != nullptr;
 }
 
+bool MCPResourceService::addDirectoryResourceFromConfig(const MCPResourceConfig& resourceConfig)
+{
+    // 验证目录路径
+    if (resourceConfig.strDirectoryPath.isEmpty())
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 目录资源配置无效（缺少directoryPath）:" 
+                               << resourceConfig.strUri;
+        return false;
+    }
+    
+    MCPResourceDirectory* pDirectory = doAddDirectoryImpl(resourceConfig.strUri, resourceConfig.strDirectoryPath);
+    
+    // mimeType作为无法按文件名推断时的默认值，annotations应用到目录下的所有文件
+    if (pDirectory != nullptr)
+    {
+        pDirectory->setDefaultMimeType(resourceConfig.strMimeType);
+        pDirectory->setAnnotations(resourceConfig.annotations);
+    }
+    
+    return pDirectory != nullptr;
+}
+
 bool MCPResourceService::applyAnnotationsIfNeeded(MCPResource* pResource, const QJsonObject& annotations)
 {
     if (annotations.isEmpty())
@@ -315,6 +588,7 @@ MCPResource* MCPResourceService::doAddImpl(const QString& strUri,
     // 创建文件资源对象（父对象设为this）
     MCPFileResource* pResource = new MCPFileResource(strUri, strFilePath, strName, this);
     pResource->withDescription(strDescription);
+    pResource->setContentCache(m_pFileContentCache);
     
     // 如果提供了MIME类型，设置它（否则MCPFileResource会自动推断）
     if (!strMimeType.isEmpty())
@@ -333,6 +607,107 @@ MCPResource* MCPResourceService::doAddImpl(const QString& strUri,
     return pResource;
 }
 
+MCPResourceDirectory* MCPResourceService::doAddDirectoryImpl(const QString& strUriPrefix, const QString& strDirectoryPath)
+{
+    const QString strPrefix = MCPResourceDirectory::normalizeUriPrefix(strUriPrefix);
+    if (strPrefix.isEmpty())
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 目录挂载失败，URI前缀为空:" << strDirectoryPath;
+        return nullptr;
+    }
+    if (m_dictDirectories.contains(strPrefix))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: URI前缀已挂载目录:" << strPrefix;
+        return nullptr;
+    }
+    if (!QFileInfo(strDirectoryPath).isDir())
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 目录挂载失败，目录不存在:" << strDirectoryPath;
+        return nullptr;
+    }
+    
+    // 目录对象属于服务线程，只在列出和读取时访问文件系统
+    MCPResourceDirectory* pDirectory = new MCPResourceDirectory(strPrefix, strDirectoryPath, this);
+    
+    // 文件变化只在未被单独注册的资源或更深的挂载覆盖时通知
+    QObject::connect(pDirectory, &MCPResourceDirectory::fileAdded, this, [this, pDirectory](const QString& strUri)
+    {
+        if (findDirectory(strUri) != pDirectory)
+        {
+            return;
+        }
+        m_listChangeLog.record(strUri, MCPListChangeLog::ChangeType::Added);
+        emit resourceContentChanged(strUri);
+        notifyListChanged();
+    });
+    QObject::connect(pDirectory, &MCPResourceDirectory::fileRemoved, this, [this, pDirectory](const QString& strUri)
+    {
+        if (findDirectory(strUri) != pDirectory)
+        {
+            return;
+        }
+        m_listChangeLog.record(strUri, MCPListChangeLog::ChangeType::Removed);
+        emit resourceDeleted(strUri);
+        notifyListChanged();
+    });
+    QObject::connect(pDirectory, &MCPResourceDirectory::fileChanged, this, [this, pDirectory](const QString& strUri)
+    {
+        if (findDirectory(strUri) == pDirectory)
+        {
+            emit resourceContentChanged(strUri);
+        }
+    });
+    QObject::connect(pDirectory, &MCPResourceDirectory::treeChanged, this, [this]()
+    {
+        m_listChangeLog.recordReset();
+        notifyListChanged();
+    });
+    
+    m_dictDirectories.insert(strPrefix, pDirectory);
+    MCP_CORE_LOG_INFO() << "MCPResourceService: 目录已挂载:" << strPrefix << "->" << pDirectory->getDirectoryPath();
+    
+    // 挂载的文件不逐个记录到变更日志，之前的代数无法再计算增量
+    m_listChangeLog.recordReset();
+    notifyListChanged();
+    return pDirectory;
+}
+
+bool MCPResourceService::doRemoveDirectoryImpl(const QString& strUriPrefix)
+{
+    MCPResourceDirectory* pDirectory = m_dictDirectories.take(MCPResourceDirectory::normalizeUriPrefix(strUriPrefix));
+    if (pDirectory == nullptr)
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 目录挂载不存在:" << strUriPrefix;
+        return false;
+    }
+    
+    pDirectory->deleteLater();
+    MCP_CORE_LOG_INFO() << "MCPResourceService: 目录挂载已取消:" << strUriPrefix;
+    m_listChangeLog.recordReset();
+    notifyListChanged();
+    return true;
+}
+
+MCPResourceDirectory* MCPResourceService::findDirectory(const QString& strUri) const
+{
+    if (m_dictDirectories.isEmpty() || m_dictResources.contains(strUri))
+    {
+        return nullptr;
+    }
+    
+    MCPResourceDirectory* pResult = nullptr;
+    int nPrefixLength = -1;
+    for (auto it = m_dictDirectories.constBegin(); it != m_dictDirectories.constEnd(); ++it)
+    {
+        if (it.key().size() > nPrefixLength && strUri.startsWith(it.key()))
+        {
+            pResult = it.value();
+            nPrefixLength = it.key().size();
+        }
+    }
+    return pResult;
+}
+
 bool MCPResourceService::doRemoveImpl(const QString& strUri, bool bEmitSignal)
 {
     if (!m_dictResources.contains(strUri))
@@ -350,15 +725,21 @@ bool MCPResourceService::doRemoveImpl(const QString& strUri, bool bEmitSignal)
     MCP_CORE_LOG_INFO() << "MCPResourceService: 资源已注销:" << strUri;
     if (bEmitSignal)
     {
+        m_listChangeLog.record(strUri, MCPListChangeLog::ChangeType::Removed);
         emit resourceDeleted(strUri);  // 通知订阅者资源已删除（订阅机制）
-        emit resourcesListChanged();    // 通知所有客户端（广播通知）
+        notifyListChanged();    // 通知所有客户端（广播通知）
     }
     return true;
 }
 
 bool MCPResourceService::doHasImpl(const QString& strUri) const
 {
-    return m_dictResources.contains(strUri);
+    if (m_dictResources.contains(strUri))
+    {
+        return true;
+    }
+    MCPResourceDirectory* pDirectory = findDirectory(strUri);
+    return pDirectory != nullptr && !pDirectory->getFilePath(strUri).isEmpty();
 }
 
 QJsonArray MCPResourceService::doListImpl(const QString& strUriPrefix) const
@@ -383,21 +764,156 @@ QJsonArray MCPResourceService::doListImpl(const QString& strUriPrefix) const
         arrResources.append(metadata);
     }
     
+    // 目录挂载下的文件（不分页，会遍历整个目录）
+    for (MCPResourceDirectory* pDirectory : m_dictDirectories)
+    {
+        const QString& strPrefix = pDirectory->getUriPrefix();
+        if (!strUriPrefix.isEmpty() && !strPrefix.startsWith(strUriPrefix) && !strUriPrefix.startsWith(strPrefix))
+        {
+            continue;
+        }
+        
+        QStringList lstUris;
+        pDirectory->listFiles(QString(), 0, lstUris);
+        for (const QString& strUri : lstUris)
+        {
+            if ((!strUriPrefix.isEmpty() && !strUri.startsWith(strUriPrefix)) || findDirectory(strUri) != pDirectory)
+            {
+                continue;
+            }
+            QJsonObject metadata = pDirectory->getMetadata(strUri);
+            metadata["uri"] = strUri;
+            arrResources.append(metadata);
+        }
+    }
+    
+    return arrResources;
+}
+
+QJsonArray MCPResourceService::doListPageImpl(const QString& strAfterUri, int nPageSize, QString& strLastUri) const
+{
+    QJsonArray arrResources;
+    strLastUri.clear();
+    
+    // 已注册资源和各目录挂载都按URI有序，各取一页候选后合并（值为nullptr表示已注册资源）；
+    // 某个来源还有后续条目时，本页只能取到该来源候选的最后一个URI为止
+    QMap<QString, MCPResourceDirectory*> dictCandidates;
+    bool bHasMore = false;
+    QString strLimit;
+    auto updateLimit = [&bHasMore, &strLimit](const QString& strUri)
+    {
+        if (!bHasMore || strUri < strLimit)
+        {
+            strLimit = strUri;
+        }
+        bHasMore = true;
+    };
+    
+    // m_dictResources按URI有序，从上一页最后一个URI之后继续
+    QString strKey;
+    auto it = strAfterUri.isEmpty() ? m_dictResources.constBegin() : m_dictResources.upperBound(strAfterUri);
+    for (; it != m_dictResources.constEnd(); ++it)
+    {
+        if (nPageSize > 0 && dictCandidates.size() >= nPageSize)
+        {
+            updateLimit(strKey);
+            break;
+        }
+        dictCandidates.insert(it.key(), nullptr);
+        strKey = it.key();
+    }
+    
+    // 目录挂载只列出本页需要经过的目录
+    for (MCPResourceDirectory* pDirectory : m_dictDirectories)
+    {
+        QStringList lstUris;
+        bool bDirectoryHasMore = pDirectory->listFiles(strAfterUri, nPageSize, lstUris);
+        for (const QString& strUri : lstUris)
+        {
+            if (findDirectory(strUri) == pDirectory)
+            {
+                dictCandidates.insert(strUri, pDirectory);
+            }
+        }
+        if (bDirectoryHasMore)
+        {
+            updateLimit(lstUris.last());
+        }
+    }
+    
+    strKey.clear();
+    bool bPageFull = false;
+    for (auto itCandidate = dictCandidates.constBegin(); itCandidate != dictCandidates.constEnd(); ++itCandidate)
+    {
+        if (bHasMore && itCandidate.key() > strLimit)
+        {
+            break;
+        }
+        if (nPageSize > 0 && arrResources.size() >= nPageSize)
+        {
+            bPageFull = true;
+            break;
+        }
+        MCPResourceDirectory* pDirectory = itCandidate.value();
+        QJsonObject metadata = pDirectory != nullptr
+            ? pDirectory->getMetadata(itCandidate.key())
+            : m_dictResources.value(itCandidate.key())->getMetadata();
+        metadata["uri"] = itCandidate.key();
+        arrResources.append(metadata);
+        strKey = itCandidate.key();
+    }
+    
+    // 页满时从本页最后一个URI继续；否则限制之前的候选已全部给出，从限制处继续
+    if (bPageFull)
+    {
+        strLastUri = strKey;
+    }
+    else if (bHasMore)
+    {
+        strLastUri = strLimit;
+    }
+    
     return arrResources;
 }
 
-QJsonObject MCPResourceService::doReadResourceImpl(const QString& strUri)
+QJsonObject MCPResourceService::doReadResourceImpl(const QString& strUri, QList<QSharedPointer<MCPStreamedFileContent>>* pStreamedContents)
 {
     if (!m_dictResources.contains(strUri))
     {
-        MCP_CORE_LOG_WARNING() << "MCPResourceService: 尝试读取不存在的资源:" << strUri;
-        return QJsonObject();
+        // 没有对应的已注册资源时依次按目录挂载、资源模板匹配
+        MCPResourceDirectory* pDirectory = findDirectory(strUri);
+        if (pDirectory != nullptr)
+        {
+            QJsonObject result = doReadDirectoryResourceImpl(pDirectory, strUri, pStreamedContents);
+            if (!result.isEmpty())
+            {
+                return result;
+            }
+        }
+        return doReadTemplateResourceImpl(strUri);
     }
     
     MCPResource* pResource = m_dictResources[strUri];
-    QString strContent = pResource->readContent();
+    QString strContent;
     QString strMimeType = pResource->getMimeType();
     
+    // 大文件不读入内存，响应中先放占位符，发送时再由连接线程mmap编码写入
+    QSharedPointer<MCPStreamedFileContent> pStreamedContent;
+    auto pFileResource = qobject_cast<MCPFileResource*>(pResource);
+    if (pStreamedContents != nullptr && pFileResource != nullptr)
+    {
+        pStreamedContent = pFileResource->createStreamedContent(m_nFileStreamThresholdBytes);
+    }
+    if (pStreamedContent != nullptr)
+    {
+        strContent = QString::fromLatin1(pStreamedContent->getPlaceholder());
+        pStreamedContents->append(pStreamedContent);
+    }
+    else
+    {
+        strContent = pResource->readContent();
+    }
+    
     // 根据MCP协议规范，资源响应格式：
     // {
     //   "contents": [
@@ -410,8 +926,190 @@ QJsonObject MCPResourceService::doReadResourceImpl(const QString& strUri)
     // }
     QJsonObject result;
     QJsonArray contents;
-    QJsonObject contentObj;
+    contents.append(createContentObject(strUri, strMimeType, pResource->isTextContent(), strContent));
+    result["contents"] = contents;
+    
+    return result;
+}
+
+QJsonObject MCPResourceService::doReadDirectoryResourceImpl(MCPResourceDirectory* pDirectory, const QString& strUri, QList<QSharedPointer<MCPStreamedFileContent>>* pStreamedContents)
+{
+    const QString strFilePath = pDirectory->getFilePath(strUri);
+    if (strFilePath.isEmpty())
+    {
+        return QJsonObject();
+    }
+    
+    const QString strMimeType = pDirectory->getMimeType(strFilePath);
+    const bool bText = MCPMimeTypes::isText(strMimeType);
+    
+    // 读取过的文件才监听内容变化（客户端通常先读取再订阅）
+    pDirectory->watchFile(strFilePath);
+    
+    // 与文件资源相同：大文件流式发送，其余经过共享内容缓存
+    QString strContent;
+    QSharedPointer<MCPStreamedFileContent> pStreamedContent;
+    if (pStreamedContents != nullptr)
+    {
+        pStreamedContent = MCPFileResource::createStreamedFileContent(strFilePath, bText, m_nFileStreamThresholdBytes);
+    }
+    if (pStreamedContent != nullptr)
+    {
+        strContent = QString::fromLatin1(pStreamedContent->getPlaceholder());
+        pStreamedContents->append(pStreamedContent);
+    }
+    else
+    {
+        strContent = m_pFileContentCache->getContent(strFilePath, bText);
+    }
     
+    QJsonObject result;
+    QJsonArray contents;
+    contents.append(createContentObject(strUri, strMimeType, bText, strContent));
+    result["contents"] = contents;
+    return result;
+}
+
+QJsonObject MCPResourceService::doReadTemplateResourceImpl(const QString& strUri)
+{
+    MCPUriTemplateMatcher::Match match;
+    if (!m_templateMatcher.match(strUri, match))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 尝试读取不存在的资源:" << strUri;
+        return QJsonObject();
+    }
+    
+    auto pTemplate = m_dictTemplates.value(match.strUriTemplate);
+    if (pTemplate == nullptr)
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 资源模板不存在:" << match.strUriTemplate;
+        return QJsonObject();
+    }
+    
+    QJsonObject result;
+    QJsonArray contents;
+    contents.append(createContentObject(strUri, pTemplate->getMimeType(), pTemplate->isTextContent(),
+                                        pTemplate->readContent(match.dictVariables)));
+    result["contents"] = contents;
+    return result;
+}
+
+QJsonObject MCPResourceService::doReadResourceRangeImpl(const QString& strUri, const QJsonObject& objParams, QString& strError)
+{
+    // 已注册资源优先，其次是目录挂载下的文件
+    MCPResource* pResource = m_dictResources.value(strUri, nullptr);
+    MCPResourceDirectory* pDirectory = pResource == nullptr ? findDirectory(strUri) : nullptr;
+    const QString strFilePath = pDirectory != nullptr ? pDirectory->getFilePath(strUri) : QString();
+    if (pResource == nullptr && strFilePath.isEmpty())
+    {
+        MCPUriTemplateMatcher::Match match;
+        if (m_templateMatcher.match(strUri, match))
+        {
+            strError = QString("Resource does not support ranged reads: %1").arg(strUri);
+            return QJsonObject();
+        }
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 尝试读取不存在的资源:" << strUri;
+        return QJsonObject();
+    }
+    
+    if (pResource != nullptr && !pResource->supportsRange())
+    {
+        strError = QString("Resource does not support ranged reads: %1").arg(strUri);
+        return QJsonObject();
+    }
+    
+    // 解析范围：cursor优先（来自上次响应的nextCursor），否则使用offset/length
+    qint64 nOffset = 0;
+    qint64 nLength = kMaxRangeBytes;
+    if (objParams.contains("cursor"))
+    {
+        QJsonObject objCursor;
+        if (!MCPCursor::decode(objParams.value("cursor").toString(), objCursor)
+            || objCursor.value("uri").toString() != strUri)
+        {
+            strError = "Invalid cursor";
+            return QJsonObject();
+        }
+        nOffset = static_cast<qint64>(objCursor.value("offset").toDouble(-1));
+        nLength = static_cast<qint64>(objCursor.value("length").toDouble(0));
+    }
+    else
+    {
+        if (objParams.contains("offset"))
+        {
+            nOffset = static_cast<qint64>(objParams.value("offset").toDouble(-1));
+        }
+        if (objParams.contains("length"))
+        {
+            nLength = static_cast<qint64>(objParams.value("length").toDouble(0));
+        }
+    }
+    if (nOffset < 0 || nLength <= 0)
+    {
+        strError = "Invalid range: offset must be >= 0 and length must be > 0";
+        return QJsonObject();
+    }
+    nLength = qMin(nLength, kMaxRangeBytes);
+    
+    QByteArray arrData;
+    qint64 nTotalSize = 0;
+    bool bRead = pResource != nullptr
+        ? pResource->readRange(nOffset, nLength, arrData, nTotalSize)
+        : MCPFileResource::readFileRange(strFilePath, nOffset, nLength, arrData, nTotalSize);
+    if (!bRead)
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceService: 按范围读取资源失败:" << strUri;
+        return QJsonObject();
+    }
+    if (nOffset > nTotalSize)
+    {
+        strError = QString("Range offset %1 exceeds resource size %2").arg(nOffset).arg(nTotalSize);
+        return QJsonObject();
+    }
+    
+    const QString strMimeType = pResource != nullptr ? pResource->getMimeType() : pDirectory->getMimeType(strFilePath);
+    const bool bText = pResource != nullptr ? pResource->isTextContent() : MCPMimeTypes::isText(strMimeType);
+    QString strContent;
+    if (bText)
+    {
+        alignUtf8Range(arrData, nOffset, nOffset + arrData.size() < nTotalSize);
+        strContent = QString::fromUtf8(arrData);
+    }
+    else
+    {
+        strContent = QString::fromLatin1(MCPBase64Encoder::encode(arrData));
+    }
+    
+    QJsonObject result;
+    QJsonArray contents;
+    contents.append(createContentObject(strUri, strMimeType, bText, strContent));
+    result["contents"] = contents;
+    
+    // 范围信息放在_meta中，未读完时返回nextCursor（保持本次的length）
+    QJsonObject objRange;
+    objRange["offset"] = static_cast<double>(nOffset);
+    objRange["length"] = arrData.size();
+    objRange["totalSize"] = static_cast<double>(nTotalSize);
+    QJsonObject objMeta;
+    objMeta["range"] = objRange;
+    result["_meta"] = objMeta;
+    
+    qint64 nNextOffset = nOffset + arrData.size();
+    if (nNextOffset < nTotalSize)
+    {
+        QJsonObject objCursor;
+        objCursor["uri"] = strUri;
+        objCursor["offset"] = static_cast<double>(nNextOffset);
+        objCursor["length"] = static_cast<double>(nLength);
+        result["nextCursor"] = MCPCursor::encode(objCursor);
+    }
+    
+    return result;
+}
+
+QJsonObject MCPResourceService::createContentObject(const QString& strUri, const QString& strMimeType, bool bText, const QString& strContent)
+{
+    QJsonObject contentObj;
     contentObj["uri"] = strUri;
     
     // 如果MIME类型不为空，添加到content对象中
@@ -420,8 +1118,8 @@ QJsonObject MCPResourceService::doReadResourceImpl(const QString& strUri)
         contentObj["mimeType"] = strMimeType;
     }
     
-    // 根据MIME类型决定使用text还是blob字段
-    if (MCPResourceContentGenerator::isTextMimeType(strMimeType))
+    // 根据资源保存的文本/二进制判断结果决定使用text还是blob字段
+    if (bText)
     {
         // 文本类型，使用text字段
         contentObj["text"] = strContent;
@@ -432,11 +1130,7 @@ QJsonObject MCPResourceService::doReadResourceImpl(const QString& strUri)
         // 注意：readContent()对于二进制资源已经返回Base64编码的字符串
         contentObj["blob"] = strContent;
     }
-    
-    contents.append(contentObj);
-    result["contents"] = contents;
-    
-    return result;
+    return contentObj;
 }
 
 bool MCPResourceService::subscribe(const QString& strUri, const QString& strSessionId)
@@ -453,22 +1147,26 @@ bool MCPResourceService::subscribe(const QString& strUri, const QString& strSess
         return false;
     }
     
-    // 检查是否已经订阅
-    if (m_subscriptions.contains(strUri))
+    // 添加到订阅索引，已存在时直接返回成功
+    if (!m_subscriptionIndex.insert(strUri, strSessionId))
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPResourceService: 会话" << strSessionId 
+                            << "已订阅URI:" << strUri;
+        return true;
+    }
+    m_sessionSubscriptions[strSessionId].insert(strUri);
+    
+    // 目录挂载下的文件按需监听，订阅时开始监听内容变化
+    MCPResourceDirectory* pDirectory = findDirectory(strUri);
+    if (pDirectory != nullptr)
     {
-        QSet<QString>& sessionIds = m_subscriptions[strUri];
-        if (sessionIds.contains(strSessionId))
+        QString strFilePath = pDirectory->getFilePath(strUri);
+        if (!strFilePath.isEmpty())
         {
-            MCP_CORE_LOG_DEBUG() << "MCPResourceService: 会话" << strSessionId 
-                                << "已订阅URI:" << strUri;
-            return true; // 已经订阅，返回成功
+            pDirectory->watchFile(strFilePath);
         }
     }
     
-    // 添加到订阅映射
-    m_subscriptions[strUri].insert(strSessionId);
-    m_sessionSubscriptions[strSessionId].insert(strUri);
-    
     MCP_CORE_LOG_INFO() << "MCPResourceService: 会话" << strSessionId 
                        << "已订阅URI:" << strUri;
     return true;
@@ -488,29 +1186,11 @@ bool MCPResourceService::unsubscribe(const QString& strUri, const QString& strSe
         return false;
     }
     
-    // 从URI订阅映射中移除
-    if (m_subscriptions.contains(strUri))
-    {
-        QSet<QString>& sessionIds = m_subscriptions[strUri];
-        if (sessionIds.contains(strSessionId))
-        {
-            sessionIds.remove(strSessionId);
-            if (sessionIds.isEmpty())
-            {
-                // 如果没有订阅者了，移除该URI的映射
-                m_subscriptions.remove(strUri);
-            }
-        }
-        else
-        {
-            MCP_CORE_LOG_DEBUG() << "MCPResourceService: 会话" << strSessionId 
-                                << "未订阅URI:" << strUri;
-            return false;
-        }
-    }
-    else
+    // 从订阅索引中移除（索引会自动回收空节点）
+    if (!m_subscriptionIndex.remove(strUri, strSessionId))
     {
-        MCP_CORE_LOG_DEBUG() << "MCPResourceService: URI不存在订阅:" << strUri;
+        MCP_CORE_LOG_DEBUG() << "MCPResourceService: 会话" << strSessionId 
+                            << "未订阅URI:" << strUri;
         return false;
     }
     
@@ -549,20 +1229,10 @@ void MCPResourceService::unsubscribeAll(const QString& strSessionId)
     // 获取该会话的所有订阅URI
     QSet<QString> uris = m_sessionSubscriptions[strSessionId];
     
-    // 遍历所有URI，从订阅映射中移除该会话
+    // 遍历所有订阅，从订阅索引中移除该会话
     for (const QString& strUri : uris)
     {
-        if (m_subscriptions.contains(strUri))
-        {
-            QSet<QString>& sessionIds = m_subscriptions[strUri];
-            sessionIds.remove(strSessionId);
-            
-            if (sessionIds.isEmpty())
-            {
-                // 如果没有订阅者了，移除该URI的映射
-                m_subscriptions.remove(strUri);
-            }
-        }
+        m_subscriptionIndex.remove(strUri, strSessionId);
     }
     
     // 移除会话的订阅映射
@@ -572,19 +1242,48 @@ void MCPResourceService::unsubscribeAll(const QString& strSessionId)
                        << "的所有订阅已取消，共" << uris.size() << "个订阅";
 }
 
-QSet<QString> MCPResourceService::getSubscribedSessionIds(const QString& strUri) const
+bool MCPResourceService::hasSubscribers(const QString& strUri) const
 {
     if (strUri.isEmpty())
     {
-        return QSet<QString>();
+        return false;
     }
-    
-    if (!m_subscriptions.contains(strUri))
+    return m_subscriptionIndex.hasSubscribers(strUri);
+}
+
+int MCPResourceService::forEachSubscribedSession(const QString& strUri,
+                                                 const std::function<void(const QString&)>& visitor) const
+{
+    if (strUri.isEmpty())
     {
-        return QSet<QString>();
+        return 0;
     }
-    
-    return m_subscriptions[strUri];
+    return m_subscriptionIndex.forEachSubscriber(strUri, visitor);
+}
+
+QSet<QString> MCPResourceService::getSubscribedSessionIds(const QString& strUri) const
+{
+    QSet<QString> setSessionIds;
+    forEachSubscribedSession(strUri, [&setSessionIds](const QString& strSessionId)
+    {
+        setSessionIds.insert(strSessionId);
+    });
+    return setSessionIds;
+}
+
+void MCPResourceService::setFileContentCacheBytes(int nMaxBytes)
+{
+    m_pFileContentCache->setMaxBytes(nMaxBytes);
+}
+
+QJsonObject MCPResourceService::getFileContentCacheStatistics() const
+{
+    return m_pFileContentCache->getStatistics();
+}
+
+void MCPResourceService::setFileStreamThreshold(qint64 nThresholdBytes)
+{
+    m_nFileStreamThresholdBytes = nThresholdBytes;
 }
 
 MCPResource* MCPResourceService::getResource(const QString& strUri) const
@@ -601,3 +1300,19 @@ MCPResource* MCPResourceService::getResource(const QString& strUri) const
     
     return m_dictResources[strUri];
 }
+
+QJsonObject MCPResourceService::getResourceMetadata(const QString& strUri) const
+{
+    MCPResource* pResource = getResource(strUri);
+    if (pResource != nullptr)
+    {
+        return pResource->getMetadata();
+    }
+    
+    MCPResourceDirectory* pDirectory = findDirectory(strUri);
+    if (pDirectory != nullptr && !pDirectory->getFilePath(strUri).isEmpty())
+    {
+        return pDirectory->getMetadata(strUri);
+    }
+    return QJsonObject();
+}
@@ -12,9 +12,20 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QString>
+#include <QList>
+#include <QSharedPointer>
+#include <QSet>
 #include "IMCPResourceService.h"
+#include <functional>
+#include "Utils/MCPListChangeLog.h"
+#include "MCPSubscriptionIndex.h"
+#include "MCPUriTemplateMatcher.h"
 
 class MCPResource;
+class MCPFileContentCache;
+class MCPStreamedFileContent;
+class MCPResourceTemplate;
+class MCPResourceDirectory;
 struct MCPResourceConfig;
 
 /**
@@ -24,12 +35,17 @@ struct MCPResourceConfig;
  * - 资源注册和管理
  * - 资源读取操作
  * - 资源列表提供
- * - 资源订阅管理（只有资源支持订阅）
+ * - 资源订阅管理（只有资源支持订阅，支持精确/前缀/通配订阅，见MCPSubscriptionIndex）
+ * - 目录挂载（目录下的文件不创建资源对象，列表和读取时按需访问文件系统，见MCPResourceDirectory）
  */
 class MCPResourceService : public IMCPResourceService
 {
     Q_OBJECT
 
+public:
+    // 单次按范围读取的最大字节数，请求的length超过时截断并通过nextCursor续读
+    static const qint64 kMaxRangeBytes = 16 * 1024 * 1024;
+
 public:
     explicit MCPResourceService(QObject* pParent = nullptr);
     virtual ~MCPResourceService();
@@ -50,17 +66,29 @@ public:
     bool remove(const QString& strUri) override;
     bool has(const QString& strUri) const override;
     QJsonArray list(const QString& strUriPrefix = QString()) const override;
+    void batchUpdate(const std::function<void()>& fun) override;
     QJsonObject readResource(const QString& strUri) override;
     
     bool addFromJson(const QJsonObject& jsonResource, QObject* pSearchRoot = nullptr) override;
     
+    bool addTemplate(const QString& strUriTemplate,
+                     const QString& strName,
+                     const QString& strDescription,
+                     const QString& strMimeType,
+                     std::function<QString(const QMap<QString, QString>&)> contentProvider) override;
+    bool removeTemplate(const QString& strUriTemplate) override;
+    QJsonArray listTemplates() const override;
+    
+    bool addDirectory(const QString& strUriPrefix, const QString& strDirectoryPath) override;
+    bool removeDirectory(const QString& strUriPrefix) override;
+    
 public:
     // 内部方法（供内部使用）
     bool registerResource(const QString& strUri, MCPResource* pResource);
     
     /**
      * @brief 订阅资源变化
-     * @param strUri 资源URI
+     * @param strUri 资源URI或订阅模式（如 file:///project/** 、file:///logs/*.log）
      * @param strSessionId 会话ID
      * @return 是否订阅成功
      */
@@ -68,7 +96,7 @@ public:
     
     /**
      * @brief 取消订阅资源变化
-     * @param strUri 资源URI
+     * @param strUri 资源URI或订阅模式（必须与订阅时一致）
      * @param strSessionId 会话ID
      * @return 是否取消订阅成功
      */
@@ -80,19 +108,113 @@ public:
      */
     void unsubscribeAll(const QString& strSessionId);
     
+    /**
+     * @brief 检查指定URI是否有订阅者（精确、前缀或通配匹配任意一个即可）
+     * @param strUri 资源URI
+     */
+    bool hasSubscribers(const QString& strUri) const;
+    
+    /**
+     * @brief 原地遍历订阅了指定URI的会话（不复制会话集合）
+     * @param strUri 资源URI
+     * @param visitor 访问回调，参数为会话ID；同一会话只访问一次
+     * @return 访问的会话数
+     * @note 回调中不得订阅/取消订阅
+     */
+    int forEachSubscribedSession(const QString& strUri, const std::function<void(const QString&)>& visitor) const;
+    
     /**
      * @brief 获取订阅指定URI的所有会话ID
      * @param strUri 资源URI
-     * @return 订阅该URI的会话ID集合
+     * @return 订阅该URI的会话ID集合（复制一份，热路径请使用forEachSubscribedSession）
      */
     QSet<QString> getSubscribedSessionIds(const QString& strUri) const;
     
+    /**
+     * @brief 设置文件资源内容缓存的内存预算（字节），0表示不缓存
+     */
+    void setFileContentCacheBytes(int nMaxBytes);
+    
+    /**
+     * @brief 获取文件资源内容缓存统计
+     */
+    QJsonObject getFileContentCacheStatistics() const;
+    
+    /**
+     * @brief 设置文件资源流式发送阈值（字节），0表示不流式发送
+     */
+    void setFileStreamThreshold(qint64 nThresholdBytes);
+    
+    /**
+     * @brief 读取资源内容，大文件资源以占位符代替内容
+     * @param strUri 资源URI
+     * @param lstStreamedContents 输出：需要挂到响应消息上的流式内容
+     * @return 资源内容对象，格式同readResource()
+     */
+    QJsonObject readResourceStreamed(const QString& strUri, QList<QSharedPointer<MCPStreamedFileContent>>& lstStreamedContents);
+    
+    /**
+     * @brief 判断resources/read请求是否带有范围参数（offset、length或cursor）
+     */
+    static bool isRangeRequest(const QJsonObject& objParams);
+    
+    /**
+     * @brief 按字节范围读取资源内容
+     * @param strUri 资源URI
+     * @param objParams resources/read请求参数（offset/length，或上次响应返回的cursor）
+     * @param strError 输出：参数不合法或资源不支持按范围读取时的错误信息（英文，作为Invalid params错误返回）
+     * @return 资源内容对象，额外包含 _meta.range（offset、length、totalSize），未读完时包含 nextCursor；
+     *         资源不存在或读取失败时返回空对象且strError为空
+     */
+    QJsonObject readResourceRange(const QString& strUri, const QJsonObject& objParams, QString& strError);
+    
     /**
      * @brief 获取资源对象（内部方法，供内部使用）
      * @param strUri 资源URI
      * @return 资源对象指针，如果不存在返回nullptr
      */
     MCPResource* getResource(const QString& strUri) const;
+    
+    /**
+     * @brief 获取资源元数据（内部方法，包括目录挂载下的文件，不包含uri）
+     * @param strUri 资源URI
+     * @return 资源元数据，资源不存在时返回空对象
+     */
+    QJsonObject getResourceMetadata(const QString& strUri) const;
+
+    /**
+     * @brief 获取一页资源列表（按资源URI排序的键集分页，翻页期间增删其他条目不会导致重复或遗漏）
+     * @param strAfterUri 上一页最后一个资源URI，为空表示从头开始
+     * @param nPageSize 每页条目数，0表示不分页
+     * @param strLastUri 输出：还有后续条目时为本页最后一个资源URI，否则为空
+     */
+    QJsonArray listPage(const QString& strAfterUri, int nPageSize, QString& strLastUri) const;
+
+    /**
+     * @brief 开始批量修改（服务线程内调用，可嵌套）
+     * 
+     * 批量修改期间注册/注销照常记录到变更日志，resourcesListChanged信号和新注册资源的resourceContentChanged信号推迟到最外层endUpdate()时只发送一次
+     */
+    void beginUpdate();
+    
+    /**
+     * @brief 结束批量修改，最外层结束时对仍存在且有订阅者的新注册资源发送内容变化信号，
+     *        期间有变化时发送一次列表变化信号
+     */
+    void endUpdate();
+
+    /**
+     * @brief 获取资源列表当前代数（每次注册/覆盖/注销加1）
+     */
+    quint64 getListGeneration() const;
+
+    /**
+     * @brief 获取自指定代数以来的资源列表增量
+     * @param nSinceGeneration 起始代数
+     * @param objDelta 输出：{generation, added, changed, removed}，removed为URI列表
+     * @return false表示差距过大或代数未知，调用方应退化为不带参数的list_changed
+     */
+    bool getListDelta(quint64 nSinceGeneration, QJsonObject& objDelta) const;
 
 signals:
     /**
@@ -162,10 +284,58 @@ private:
      */
     QJsonArray doListImpl(const QString& strUriPrefix) const;
     
+    /**
+     * @brief 发送资源列表变化信号（批量修改期间只做标记）
+     */
+    void notifyListChanged();
+    
+    /**
+     * @brief 内部方法：实际执行分页获取资源列表操作
+     */
+    QJsonArray doListPageImpl(const QString& strAfterUri, int nPageSize, QString& strLastUri) const;
+    
     /**
      * @brief 内部方法：实际执行读取资源内容操作
+     * @param pStreamedContents 非空时，超过流式阈值的文件资源只放占位符，流式内容追加到该列表
+     */
+    QJsonObject doReadResourceImpl(const QString& strUri, QList<QSharedPointer<MCPStreamedFileContent>>* pStreamedContents = nullptr);
+    
+    /**
+     * @brief 内部方法：实际执行按范围读取资源内容操作
      */
-    QJsonObject doReadResourceImpl(const QString& strUri);
+    QJsonObject doReadResourceRangeImpl(const QString& strUri, const QJsonObject& objParams, QString& strError);
+    
+    /**
+     * @brief 内部方法：按资源模板读取（URI没有对应的已注册资源时）
+     */
+    QJsonObject doReadTemplateResourceImpl(const QString& strUri);
+    
+    /**
+     * @brief 内部方法：读取目录挂载下的文件
+     */
+    QJsonObject doReadDirectoryResourceImpl(MCPResourceDirectory* pDirectory, const QString& strUri, QList<QSharedPointer<MCPStreamedFileContent>>* pStreamedContents);
+    
+    /**
+     * @brief 内部方法：实际执行挂载目录操作
+     * @return 成功返回目录资源指针，失败返回nullptr
+     */
+    MCPResourceDirectory* doAddDirectoryImpl(const QString& strUriPrefix, const QString& strDirectoryPath);
+    
+    /**
+     * @brief 内部方法：实际执行取消目录挂载操作
+     */
+    bool doRemoveDirectoryImpl(const QString& strUriPrefix);
+    
+    /**
+     * @brief 查找提供该URI的目录挂载（嵌套挂载时取前缀最长的）
+     * @return 目录资源指针，URI未单独注册且位于某个挂载下时有效，否则返回nullptr
+     */
+    MCPResourceDirectory* findDirectory(const QString& strUri) const;
+    
+    /**
+     * @brief 构建resources/read的内容对象（文本放入text字段，二进制放入blob字段）
+     */
+    static QJsonObject createContentObject(const QString& strUri, const QString& strMimeType, bool bText, const QString& strContent);
     
     /**
      * @brief 从配置添加文件资源
@@ -189,6 +359,13 @@ private:
      */
     bool addContentResourceFromConfig(const MCPResourceConfig& resourceConfig);
     
+    /**
+     * @brief 从配置添加目录资源
+     * @param resourceConfig 资源配置对象（uri为URI前缀）
+     * @return true表示挂载成功，false表示失败
+     */
+    bool addDirectoryResourceFromConfig(const MCPResourceConfig& resourceConfig);
+    
     /**
      * @brief 如果配置中包含annotations，则应用到资源
      * @param pResource 资源对象指针
@@ -213,10 +390,19 @@ private:
 
 private:
     QMap<QString, MCPResource*> m_dictResources;
+    MCPListChangeLog m_listChangeLog;   // 资源列表变更日志（用于增量list_changed）
+    int m_nUpdateDepth;                 // 批量修改嵌套层数
+    bool m_bListChangedPending;         // 批量修改期间列表是否有变化
+    QSet<QString> m_setPendingRegisteredUris;   // 批量修改期间注册的资源URI（结束时发送内容变化信号）
+    QMap<QString, QSharedPointer<MCPResourceTemplate>> m_dictTemplates;  // URI模板 -> 资源模板
+    MCPUriTemplateMatcher m_templateMatcher;    // 所有模板编译成的匹配自动机
+    QMap<QString, MCPResourceDirectory*> m_dictDirectories;   // URI前缀 -> 目录挂载
+    MCPFileContentCache* m_pFileContentCache;  // 文件资源共享内容缓存
+    qint64 m_nFileStreamThresholdBytes;        // 文件资源流式发送阈值
     
     // 订阅管理（基于sessionId）
-    QMap<QString, QSet<QString>> m_subscriptions;  // URI -> 会话ID集合
-    QMap<QString, QSet<QString>> m_sessionSubscriptions;  // 会话ID -> URI集合
+    MCPSubscriptionIndex m_subscriptionIndex;  // 订阅模式 -> 会话ID（基数树）
+    QMap<QString, QSet<QString>> m_sessionSubscriptions;  // 会话ID -> 订阅模式集合
 private:
     friend class MCPServer;
 };
@@ -0,0 +1,74 @@
+/**
+ * @file MCPResourceTemplate.cpp
+ * @brief MCP资源模板实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPResourceTemplate.h"
+#include "Utils/MCPMimeTypes.h"
+
+MCPResourceTemplate::MCPResourceTemplate(const QString& strUriTemplate,
+                                         const QString& strName,
+                                         const QString& strDescription,
+                                         const QString& strMimeType,
+                                         ContentProvider contentProvider)
+    : m_strUriTemplate(strUriTemplate)
+    , m_strName(strName)
+    , m_strDescription(strDescription)
+    , m_strMimeType(strMimeType)
+    , m_bTextContent(MCPMimeTypes::isText(strMimeType))
+    , m_contentProvider(contentProvider)
+{
+}
+
+QString MCPResourceTemplate::getUriTemplate() const
+{
+    return m_strUriTemplate;
+}
+
+QString MCPResourceTemplate::getName() const
+{
+    return m_strName;
+}
+
+QString MCPResourceTemplate::getDescription() const
+{
+    return m_strDescription;
+}
+
+QString MCPResourceTemplate::getMimeType() const
+{
+    return m_strMimeType;
+}
+
+bool MCPResourceTemplate::isTextContent() const
+{
+    return m_bTextContent;
+}
+
+QJsonObject MCPResourceTemplate::getMetadata() const
+{
+    QJsonObject metadata;
+    metadata["uriTemplate"] = m_strUriTemplate;
+    metadata["name"] = m_strName;
+    if (!m_strDescription.isEmpty())
+    {
+        metadata["description"] = m_strDescription;
+    }
+    if (!m_strMimeType.isEmpty())
+    {
+        metadata["mimeType"] = m_strMimeType;
+    }
+    return metadata;
+}
+
+QString MCPResourceTemplate::readContent(const QMap<QString, QString>& dictVariables) const
+{
+    if (!m_contentProvider)
+    {
+        return QString();
+    }
+    return m_contentProvider(dictVariables);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file MCPResourceTemplate.h
+ * @brief MCP资源模板（RFC 6570 URI模板 + 内容提供函数）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QMap>
+#include <QJsonObject>
+#include <functional>
+
+/**
+ * @brief MCP资源模板
+ *
+ * 职责：
+ * - 描述一类参数化资源（例如 db://table/{id}），对应 resources/templates/list 中的一项
+ * - 读取时把从URI中解析出的变量交给内容提供函数生成内容，不需要为每个实例注册资源
+ *
+ * 注意：
+ * - 与内容资源一致，二进制MIME类型的内容提供函数应返回Base64编码的字符串
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPResourceTemplate
+{
+public:
+    typedef std::function<QString(const QMap<QString, QString>&)> ContentProvider;
+
+public:
+    MCPResourceTemplate(const QString& strUriTemplate,
+                        const QString& strName,
+                        const QString& strDescription,
+                        const QString& strMimeType,
+                        ContentProvider contentProvider);
+
+public:
+    QString getUriTemplate() const;
+    QString getName() const;
+    QString getDescription() const;
+    QString getMimeType() const;
+    bool isTextContent() const;
+
+    /**
+     * @brief 获取模板元数据（resources/templates/list中的一项）
+     */
+    QJsonObject getMetadata() const;
+
+    /**
+     * @brief 生成资源内容
+     * @param dictVariables 从URI中解析出的变量
+     * @return 资源内容字符串
+     */
+    QString readContent(const QMap<QString, QString>& dictVariables) const;
+
+private:
+    QString m_strUriTemplate;
+    QString m_strName;
+    QString m_strDescription;
+    QString m_strMimeType;
+    bool m_bTextContent;
+    ContentProvider m_contentProvider;
+};
@@ -9,6 +9,7 @@
 #include "MCPResourceWrapper.h"
 #include "MCPLog/MCPLog.h"
 #include "Utils/MCPMetaObjectHelper.h"
+#include "Utils/MCPMimeTypes.h"
 #include <QMetaObject>
 #include <QMetaMethod>
 #include <QVariant>
@@ -20,6 +21,9 @@ MCPResourceWrapper::MCPResourceWrapper(const QString& strUri,
                                        const QMetaMethod& getMetadata,
                                        const QMetaMethod& getContent,
                                        const QMetaMethod& getAnnotations,
+                                       const QMetaMethod& getContentSize,
+                                       const QMetaMethod& readContentRange,
+                                       const QMetaMethod& isContentCacheable,
                                        QObject* pParent)
     : MCPResource(strUri, pParent)
     , m_pWrappedObject(pWrappedObject)
@@ -27,7 +31,21 @@ MCPResourceWrapper::MCPResourceWrapper(const QString& strUri,
     , m_getMetadata(getMetadata)
     , m_getContent(getContent)
     , m_getAnnotations(getAnnotations)  // 从create()方法传入，可能无效
+    , m_getContentSize(getContentSize)
+    , m_readContentRange(readContentRange)
+    , m_bContentCacheable(false)
+    , m_bMetadataCached(false)
+    , m_bContentCached(false)
 {
+    if (isContentCacheable.isValid())
+    {
+        isContentCacheable.invoke(m_pWrappedObject,
+            QThread::currentThread() == m_pWrappedObject->thread()
+            ? Qt::DirectConnection
+            : Qt::BlockingQueuedConnection,
+            Q_RETURN_ARG(bool, m_bContentCacheable));
+    }
+    
     // 从包装对象的getMetadata()方法中获取元数据（name、description、mimeType、annotations）
     updatePropertiesFromWrappedObject();
     
@@ -107,12 +125,51 @@ MCPResourceWrapper* MCPResourceWrapper::create(const QString& strUri,
         MCP_CORE_LOG_DEBUG() << "MCPResourceWrapper::create: 包装对象支持getAnnotations()方法";
     }
     
+    // 尝试获取按范围读取的方法（可选，两个方法都有效才支持）
+    QMetaMethod getContentSizeMethod = MCPMetaObjectHelper::getMethod(pWrappedObject, "getContentSize()");
+    QMetaMethod readContentRangeMethod = MCPMetaObjectHelper::getMethod(pWrappedObject, "readContentRange(qint64,qint64)");
+    if (getContentSizeMethod.isValid() && readContentRangeMethod.isValid())
+    {
+        if (getContentSizeMethod.returnType() == QMetaType::LongLong &&
+            getContentSizeMethod.parameterCount() == 0 &&
+            readContentRangeMethod.returnType() == QMetaType::QByteArray &&
+            readContentRangeMethod.parameterCount() == 2 &&
+            readContentRangeMethod.parameterType(0) == QMetaType::LongLong &&
+            readContentRangeMethod.parameterType(1) == QMetaType::LongLong)
+        {
+            MCP_CORE_LOG_DEBUG() << "MCPResourceWrapper::create: 包装对象支持按范围读取";
+        }
+        else
+        {
+            MCP_CORE_LOG_WARNING() << "MCPResourceWrapper::create: getContentSize()/readContentRange()签名不符，忽略按范围读取";
+            getContentSizeMethod = QMetaMethod();
+            readContentRangeMethod = QMetaMethod();
+        }
+    }
+    else
+    {
+        getContentSizeMethod = QMetaMethod();
+        readContentRangeMethod = QMetaMethod();
+    }
+    
+    // 尝试获取isContentCacheable()方法（可选）
+    QMetaMethod isContentCacheableMethod = MCPMetaObjectHelper::getMethod(pWrappedObject, "isContentCacheable()");
+    if (isContentCacheableMethod.isValid() &&
+        (isContentCacheableMethod.returnType() != QMetaType::Bool || isContentCacheableMethod.parameterCount() != 0))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceWrapper::create: isContentCacheable()签名不符，忽略内容缓存";
+        isContentCacheableMethod = QMetaMethod();
+    }
+    
     // 所有验证通过，创建对象
     MCPResourceWrapper* pWrapper = new MCPResourceWrapper(strUri, pWrappedObject, 
                                                            changedSignal, 
                                                            getMetadataMethod, 
                                                            getContentMethod,
                                                            getAnnotationsMethod,
+                                                           getContentSizeMethod,
+                                                           readContentRangeMethod,
+                                                           isContentCacheableMethod,
                                                            pParent);
     
     return pWrapper;
@@ -127,6 +184,11 @@ QString MCPResourceWrapper::readContent() const
         return QString();
     }
     
+    if (m_bContentCached)
+    {
+        return m_strContent;
+    }
+    
     // 通过保存的QMetaMethod调用包装对象的getContent()方法
     // 使用Qt::AutoConnection自动处理线程问题：
     // - 同线程：使用DirectConnection（直接调用）
@@ -137,6 +199,12 @@ QString MCPResourceWrapper::readContent() const
         ? Qt::DirectConnection 
         : Qt::BlockingQueuedConnection,
         Q_RETURN_ARG(QString, strContent));
+    
+    if (m_bContentCacheable)
+    {
+        m_strContent = strContent;
+        m_bContentCached = true;
+    }
     return strContent;
 }
 
@@ -154,19 +222,8 @@ QJsonObject MCPResourceWrapper::getMetadata() const
         return MCPResource::getMetadata();
     }
     
-    // 通过保存的QMetaMethod调用包装对象的getMetadata()方法
-    // 使用Qt::AutoConnection自动处理线程问题：
-    // - 同线程：使用DirectConnection（直接调用）
-    // - 跨线程：使用BlockingQueuedConnection（同步调用以获取返回值）
-    QJsonObject metadata;
-    
-    // 检查是否跨线程
-    m_getMetadata.invoke(m_pWrappedObject,
-        QThread::currentThread() == m_pWrappedObject->thread() 
-        ? Qt::DirectConnection 
-        : Qt::BlockingQueuedConnection,
-        Q_RETURN_ARG(QJsonObject, metadata));
-    return metadata;
+    ensureMetadataCached();
+    return m_objMetadata;
 }
 
 QJsonObject MCPResourceWrapper::getAnnotations() const
@@ -178,22 +235,97 @@ QJsonObject MCPResourceWrapper::getAnnotations() const
         return MCPResource::getAnnotations();
     }
     
-    // 如果包装对象实现了getAnnotations()方法，则调用它
+    // 如果包装对象实现了getAnnotations()方法，则返回其缓存结果
     if (m_getAnnotations.isValid())
     {
-        QJsonObject annotations;
-        m_getAnnotations.invoke(m_pWrappedObject,
-            QThread::currentThread() == m_pWrappedObject->thread() 
-            ? Qt::DirectConnection 
-            : Qt::BlockingQueuedConnection,
-            Q_RETURN_ARG(QJsonObject, annotations));
-        return annotations;
+        ensureMetadataCached();
+        return m_objAnnotations;
     }
     
     // 如果包装对象没有实现getAnnotations()方法，返回基类的实现
     return MCPResource::getAnnotations();
 }
 
+void MCPResourceWrapper::ensureMetadataCached() const
+{
+    if (m_bMetadataCached)
+    {
+        return;
+    }
+    
+    // 通过保存的QMetaMethod调用包装对象的getMetadata()/getAnnotations()方法
+    // - 同线程：使用DirectConnection（直接调用）
+    // - 跨线程：使用BlockingQueuedConnection（同步调用以获取返回值）
+    Qt::ConnectionType enConnectionType = QThread::currentThread() == m_pWrappedObject->thread()
+        ? Qt::DirectConnection
+        : Qt::BlockingQueuedConnection;
+    
+    m_objMetadata = QJsonObject();
+    m_getMetadata.invoke(m_pWrappedObject, enConnectionType, Q_RETURN_ARG(QJsonObject, m_objMetadata));
+    
+    m_objAnnotations = QJsonObject();
+    if (m_getAnnotations.isValid())
+    {
+        m_getAnnotations.invoke(m_pWrappedObject, enConnectionType, Q_RETURN_ARG(QJsonObject, m_objAnnotations));
+    }
+    m_bMetadataCached = true;
+}
+
+void MCPResourceWrapper::invalidateCache()
+{
+    m_bMetadataCached = false;
+    m_objMetadata = QJsonObject();
+    m_objAnnotations = QJsonObject();
+    m_bContentCached = false;
+    m_strContent.clear();
+}
+
+bool MCPResourceWrapper::supportsRange() const
+{
+    return m_pWrappedObject != nullptr && m_getContentSize.isValid() && m_readContentRange.isValid();
+}
+
+bool MCPResourceWrapper::readRange(qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize) const
+{
+    if (!supportsRange())
+    {
+        return false;
+    }
+    
+    Qt::ConnectionType enConnectionType = QThread::currentThread() == m_pWrappedObject->thread()
+        ? Qt::DirectConnection
+        : Qt::BlockingQueuedConnection;
+    
+    qint64 nSize = 0;
+    if (!m_getContentSize.invoke(m_pWrappedObject, enConnectionType, Q_RETURN_ARG(qint64, nSize)))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceWrapper: 调用getContentSize()失败:" << getUri();
+        return false;
+    }
+    
+    nTotalSize = nSize;
+    arrData.clear();
+    if (nOffset >= nTotalSize || nLength <= 0)
+    {
+        return true;
+    }
+    
+    qint64 nReadLength = qMin(nLength, nTotalSize - nOffset);
+    if (!m_readContentRange.invoke(m_pWrappedObject, enConnectionType,
+        Q_RETURN_ARG(QByteArray, arrData), Q_ARG(qint64, nOffset), Q_ARG(qint64, nReadLength)))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPResourceWrapper: 调用readContentRange()失败:" << getUri();
+        return false;
+    }
+    
+    // 包装对象返回的数据超出请求区间时截断
+    if (arrData.size() > nReadLength)
+    {
+        arrData.truncate(static_cast<int>(nReadLength));
+    }
+    return true;
+}
+
 bool MCPResourceWrapper::validateChangedSignal(const QMetaMethod& changedSignal, QString& strErrorMessage)
 {
     if (!changedSignal.isValid())
@@ -275,10 +407,14 @@ void MCPResourceWrapper::onWrappedObjectChanged(const QString& strName, const QS
         return;
     }
     
+    // 元数据、注解和内容都可能变化，缓存失效后在下次访问时重新获取
+    invalidateCache();
+    
     // 更新本地属性（不触发信号，因为这是从包装对象同步数据）
     m_strName = strName;
     m_strDescription = strDescription;
     m_strMimeType = strMimeType;
+    m_bTextContent = MCPMimeTypes::isText(m_strMimeType);
     
     // 转发changed信号
     emit changed(strName, strDescription, strMimeType);
@@ -331,6 +467,7 @@ void MCPResourceWrapper::onWrappedObjectDestroyed()
     // 包装对象已被删除，清空指针并发送失效信号
     MCP_CORE_LOG_WARNING() << "MCPResourceWrapper: 包装对象已被删除，资源失效:" << getUri();
     m_pWrappedObject = nullptr;
+    invalidateCache();
     notifyInvalidated();
 }
 
@@ -353,6 +490,7 @@ void MCPResourceWrapper::updatePropertiesFromWrappedObject()
     if (metadata.contains("mimeType"))
     {
         m_strMimeType = metadata["mimeType"].toString();
+        m_bTextContent = MCPMimeTypes::isText(m_strMimeType);
     }
     
     // 提取 annotations（如果存在）
@@ -19,12 +19,20 @@
  * - 通过Qt Meta机制动态调用包装对象的方法和信号
  * - 在构造时验证包装对象是否满足最小实现要求
  * - 提供友好的错误处理和验证反馈
+ * - 缓存元数据和注解，只在包装对象发出changed信号后重新获取（跨线程时避免每次请求都阻塞调用）
  * 
  * 包装对象需要提供以下接口：
  * - QJsonObject getMetadata() const;  // slot方法，获取资源元数据
  * - QString getContent() const;        // slot方法，获取资源内容
  * - void changed(const QString&, const QString&, const QString&);  // 信号，通知资源变化
  * 
+ * 可选接口（同时提供两者时声明支持按范围读取）：
+ * - qint64 getContentSize() const;                                 // slot方法，返回内容总字节数
+ * - QByteArray readContentRange(qint64 nOffset, qint64 nLength) const;  // slot方法，返回区间内的原始字节
+ * 
+ * 可选接口（返回true时内容在两次changed信号之间视为不变，同样缓存）：
+ * - bool isContentCacheable() const;                               // slot方法，构造时调用一次
+ * 
  * 使用场景：
  * - 当已有QObject对象实现了资源接口，需要适配为MCPResource时
  * 
@@ -69,7 +77,7 @@ public:
      * @brief 读取资源内容（实现基类纯虚函数）
      * @return 资源内容字符串
      * 
-     * 通过Qt Meta机制调用包装对象的getContent()方法
+     * 通过Qt Meta机制调用包装对象的getContent()方法；包装对象声明内容可缓存时返回缓存
      */
     QString readContent() const override;
     
@@ -77,7 +85,7 @@ public:
      * @brief 获取资源元数据（重写基类方法）
      * @return 资源元数据对象
      * 
-     * 通过Qt Meta机制调用包装对象的getMetadata()方法
+     * 返回缓存，包装对象发出changed信号后的首次调用才通过Qt Meta机制调用getMetadata()
      */
     QJsonObject getMetadata() const override;
     
@@ -85,11 +93,21 @@ public:
      * @brief 获取资源注解（Annotations）（重写基类方法）
      * @return 资源注解对象，包含 audience、priority、lastModified 等字段
      * 
-     * 如果包装对象实现了 getAnnotations() 方法，则调用它
+     * 如果包装对象实现了 getAnnotations() 方法，则返回其缓存结果（与元数据一起刷新）
      * 否则返回基类的实现（可能为空对象）
      */
     QJsonObject getAnnotations() const override;
     
+    /**
+     * @brief 包装对象同时实现了getContentSize()和readContentRange()时支持按范围读取
+     */
+    bool supportsRange() const override;
+    
+    /**
+     * @brief 通过包装对象的getContentSize()和readContentRange()读取区间
+     */
+    bool readRange(qint64 nOffset, qint64 nLength, QByteArray& arrData, qint64& nTotalSize) const override;
+    
     /**
      * @brief 获取包装对象指针
      * @return 包装对象指针
@@ -129,6 +147,9 @@ private:
      * @param getMetadata getMetadata方法的QMetaMethod（必须有效）
      * @param getContent getContent方法的QMetaMethod（必须有效）
      * @param getAnnotations getAnnotations方法的QMetaMethod（可选，可能无效）
+     * @param getContentSize getContentSize方法的QMetaMethod（可选，可能无效）
+     * @param readContentRange readContentRange方法的QMetaMethod（可选，可能无效）
+     * @param isContentCacheable isContentCacheable方法的QMetaMethod（可选，可能无效）
      * @param pParent 父对象
      * 
      * 注意：
@@ -142,6 +163,9 @@ private:
                                 const QMetaMethod& getMetadata,
                                 const QMetaMethod& getContent,
                                 const QMetaMethod& getAnnotations,
+                                const QMetaMethod& getContentSize,
+                                const QMetaMethod& readContentRange,
+                                const QMetaMethod& isContentCacheable,
                                 QObject* pParent = nullptr);
     
     /**
@@ -158,6 +182,16 @@ private:
      */
     void updatePropertiesFromWrappedObject();
     
+    /**
+     * @brief 元数据缓存失效时从包装对象重新获取元数据和注解
+     */
+    void ensureMetadataCached() const;
+    
+    /**
+     * @brief 使元数据和内容缓存失效（下次访问时重新获取）
+     */
+    void invalidateCache();
+    
 private slots:
     /**
      * @brief 处理包装对象的changed信号
@@ -177,4 +211,14 @@ private:
     QMetaMethod m_getMetadata;       // getMetadata方法的QMetaMethod
     QMetaMethod m_getContent;        // getContent方法的QMetaMethod
     QMetaMethod m_getAnnotations;    // getAnnotations方法的QMetaMethod（可选，可能无效）
+    QMetaMethod m_getContentSize;    // getContentSize方法的QMetaMethod（可选，可能无效）
+    QMetaMethod m_readContentRange;  // readContentRange方法的QMetaMethod（可选，可能无效）
+    bool m_bContentCacheable;        // 包装对象声明内容在两次changed信号之间不变
+    
+    // 缓存只在包装器所在线程（资源服务线程）读写，changed信号排队到该线程后失效
+    mutable bool m_bMetadataCached;          // 元数据和注解缓存是否有效
+    mutable QJsonObject m_objMetadata;       // 缓存的getMetadata()结果
+    mutable QJsonObject m_objAnnotations;    // 缓存的getAnnotations()结果
+    mutable bool m_bContentCached;           // 内容缓存是否有效
+    mutable QString m_strContent;            // 缓存的getContent()结果
 };
@@ -0,0 +1,418 @@
+/**
+ * @file MCPSubscriptionIndex.cpp
+ * @brief MCP资源订阅索引实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPSubscriptionIndex.h"
+#include <QVarLengthArray>
+
+MCPSubscriptionIndex::Node::~Node()
+{
+    qDeleteAll(dictChildren);
+}
+
+bool MCPSubscriptionIndex::Node::isEmpty() const
+{
+    return setExactSessions.isEmpty() && setPrefixSessions.isEmpty() && lstGlobs.isEmpty();
+}
+
+MCPSubscriptionIndex::MCPSubscriptionIndex()
+    : m_pRoot(new Node())
+{
+}
+
+MCPSubscriptionIndex::~MCPSubscriptionIndex()
+{
+    delete m_pRoot;
+}
+
+bool MCPSubscriptionIndex::isPattern(const QString& strPattern)
+{
+    return strPattern.contains(QLatin1Char('*'));
+}
+
+MCPSubscriptionIndex::PatternKind MCPSubscriptionIndex::parsePattern(const QString& strPattern,
+                                                                     QString& strLiteral,
+                                                                     QString& strGlob)
+{
+    int nStarIndex = strPattern.indexOf(QLatin1Char('*'));
+    if (nStarIndex < 0)
+    {
+        strLiteral = strPattern;
+        strGlob.clear();
+        return PatternKind::Exact;
+    }
+
+    strLiteral = strPattern.left(nStarIndex);
+    strGlob = strPattern.mid(nStarIndex);
+    if (strGlob == QLatin1String("**"))
+    {
+        // 仅以 "**" 结尾的模式等价于前缀订阅，直接挂在前缀节点上，无需逐个匹配
+        strGlob.clear();
+        return PatternKind::Prefix;
+    }
+    return PatternKind::Glob;
+}
+
+bool MCPSubscriptionIndex::matchGlob(const QChar* pPattern, const QChar* pPatternEnd,
+                                     const QChar* pText, const QChar* pTextEnd)
+{
+    // 迭代匹配，不递归：失配时只回退到最近的 '*' 和最近的 "**"，
+    // 耗时为多项式级，避免 a*a*a*...b 这类模式在递归回溯下指数级增长
+    const QChar* pStarPattern = nullptr;   // 最近的 '*' 之后的模式位置
+    const QChar* pStarText = nullptr;      // 最近的 '*' 已匹配到的文本位置
+    const QChar* pDeepPattern = nullptr;   // 最近的 "**" 之后的模式位置
+    const QChar* pDeepText = nullptr;      // 最近的 "**" 已匹配到的文本位置
+
+    while (pText < pTextEnd)
+    {
+        if (pPattern < pPatternEnd && *pPattern == QLatin1Char('*'))
+        {
+            // 连续多个 '*' 视为 "**"，可跨越 '/'
+            const QChar* pRest = pPattern + 1;
+            while (pRest < pPatternEnd && *pRest == QLatin1Char('*'))
+            {
+                ++pRest;
+            }
+            if (pRest - pPattern > 1)
+            {
+                // "**" 之前的 '*' 不再需要回退，"**" 可以吞下它们能吞的任何字符
+                pDeepPattern = pRest;
+                pDeepText = pText;
+                pStarPattern = nullptr;
+            }
+            else
+            {
+                pStarPattern = pRest;
+                pStarText = pText;
+            }
+            pPattern = pRest;
+            continue;
+        }
+        if (pPattern < pPatternEnd && *pPattern == *pText)
+        {
+            ++pPattern;
+            ++pText;
+            continue;
+        }
+
+        // 失配：先让最近的 '*' 多匹配一个字符（不能跨越'/'），不行再让最近的 "**" 多匹配一个字符
+        if (pStarPattern != nullptr && *pStarText != QLatin1Char('/'))
+        {
+            pPattern = pStarPattern;
+            pText = ++pStarText;
+            continue;
+        }
+        if (pDeepPattern != nullptr)
+        {
+            // "**" 之后的 '*' 从新位置重新匹配
+            pStarPattern = nullptr;
+            pPattern = pDeepPattern;
+            pText = ++pDeepText;
+            continue;
+        }
+        return false;
+    }
+
+    // 文本已匹配完，模式剩余部分只能是 '*'
+    while (pPattern < pPatternEnd && *pPattern == QLatin1Char('*'))
+    {
+        ++pPattern;
+    }
+    return pPattern == pPatternEnd;
+}
+
+MCPSubscriptionIndex::Node* MCPSubscriptionIndex::findOrCreateNode(const QString& strLiteral)
+{
+    Node* pNode = m_pRoot;
+    int nPos = 0;
+    while (nPos < strLiteral.size())
+    {
+        QChar chKey = strLiteral.at(nPos);
+        auto it = pNode->dictChildren.find(chKey);
+        if (it == pNode->dictChildren.end())
+        {
+            Node* pNewNode = new Node();
+            pNewNode->strEdge = strLiteral.mid(nPos);
+            pNode->dictChildren.insert(chKey, pNewNode);
+            return pNewNode;
+        }
+
+        Node* pChild = it.value();
+        const QString& strEdge = pChild->strEdge;
+        int nCommon = 0;
+        int nMaxCommon = qMin(strEdge.size(), strLiteral.size() - nPos);
+        while (nCommon < nMaxCommon && strEdge.at(nCommon) == strLiteral.at(nPos + nCommon))
+        {
+            ++nCommon;
+        }
+
+        if (nCommon < strEdge.size())
+        {
+            // 边标签只匹配了一部分，在公共前缀处拆分出中间节点
+            Node* pMiddle = new Node();
+            pMiddle->strEdge = strEdge.left(nCommon);
+            pChild->strEdge = pChild->strEdge.mid(nCommon);
+            pMiddle->dictChildren.insert(pChild->strEdge.at(0), pChild);
+            it.value() = pMiddle;
+            pChild = pMiddle;
+        }
+
+        nPos += nCommon;
+        pNode = pChild;
+    }
+    return pNode;
+}
+
+QList<MCPSubscriptionIndex::Node*> MCPSubscriptionIndex::findNodePath(const QString& strLiteral) const
+{
+    QList<Node*> lstPath;
+    Node* pNode = m_pRoot;
+    lstPath.append(pNode);
+    int nPos = 0;
+    while (nPos < strLiteral.size())
+    {
+        auto it = pNode->dictChildren.constFind(strLiteral.at(nPos));
+        if (it == pNode->dictChildren.constEnd())
+        {
+            return QList<Node*>();
+        }
+        Node* pChild = it.value();
+        if (strLiteral.midRef(nPos, pChild->strEdge.size()) != pChild->strEdge)
+        {
+            return QList<Node*>();
+        }
+        nPos += pChild->strEdge.size();
+        pNode = pChild;
+        lstPath.append(pNode);
+    }
+    return lstPath;
+}
+
+void MCPSubscriptionIndex::pruneNodePath(const QList<Node*>& lstPath)
+{
+    // 自底向上删除空叶子节点，并把只剩一个子节点的空节点与子节点合并，保持树的压缩形态
+    for (int i = lstPath.size() - 1; i >= 1; --i)
+    {
+        Node* pNode = lstPath.at(i);
+        Node* pParent = lstPath.at(i - 1);
+        if (!pNode->isEmpty())
+        {
+            break;
+        }
+
+        if (pNode->dictChildren.isEmpty())
+        {
+            pParent->dictChildren.remove(pNode->strEdge.at(0));
+            delete pNode;
+            continue;
+        }
+
+        if (pNode->dictChildren.size() == 1)
+        {
+            Node* pChild = pNode->dictChildren.begin().value();
+            pNode->strEdge += pChild->strEdge;
+            pNode->dictChildren = pChild->dictChildren;
+            pNode->setExactSessions.swap(pChild->setExactSessions);
+            pNode->setPrefixSessions.swap(pChild->setPrefixSessions);
+            pNode->lstGlobs.swap(pChild->lstGlobs);
+            pChild->dictChildren.clear();
+            delete pChild;
+        }
+        break;
+    }
+}
+
+bool MCPSubscriptionIndex::insert(const QString& strPattern, const QString& strSessionId)
+{
+    QString strLiteral;
+    QString strGlob;
+    PatternKind enKind = parsePattern(strPattern, strLiteral, strGlob);
+    Node* pNode = findOrCreateNode(strLiteral);
+
+    QSet<QString>* pSessions = nullptr;
+    switch (enKind)
+    {
+    case PatternKind::Exact:
+        pSessions = &pNode->setExactSessions;
+        break;
+    case PatternKind::Prefix:
+        pSessions = &pNode->setPrefixSessions;
+        break;
+    case PatternKind::Glob:
+        for (auto& globEntry : pNode->lstGlobs)
+        {
+            if (globEntry.strGlob == strGlob)
+            {
+                pSessions = &globEntry.setSessions;
+                break;
+            }
+        }
+        if (pSessions == nullptr)
+        {
+            pNode->lstGlobs.append(GlobEntry{ strGlob, QSet<QString>() });
+            pSessions = &pNode->lstGlobs.last().setSessions;
+        }
+        break;
+    }
+
+    if (pSessions->contains(strSessionId))
+    {
+        return false;
+    }
+    pSessions->insert(strSessionId);
+    return true;
+}
+
+bool MCPSubscriptionIndex::remove(const QString& strPattern, const QString& strSessionId)
+{
+    QString strLiteral;
+    QString strGlob;
+    PatternKind enKind = parsePattern(strPattern, strLiteral, strGlob);
+    QList<Node*> lstPath = findNodePath(strLiteral);
+    if (lstPath.isEmpty())
+    {
+        return false;
+    }
+
+    Node* pNode = lstPath.last();
+    bool bRemoved = false;
+    switch (enKind)
+    {
+    case PatternKind::Exact:
+        bRemoved = pNode->setExactSessions.remove(strSessionId);
+        break;
+    case PatternKind::Prefix:
+        bRemoved = pNode->setPrefixSessions.remove(strSessionId);
+        break;
+    case PatternKind::Glob:
+        for (int i = 0; i < pNode->lstGlobs.size(); ++i)
+        {
+            GlobEntry& globEntry = pNode->lstGlobs[i];
+            if (globEntry.strGlob == strGlob)
+            {
+                bRemoved = globEntry.setSessions.remove(strSessionId);
+                if (globEntry.setSessions.isEmpty())
+                {
+                    pNode->lstGlobs.removeAt(i);
+                }
+                break;
+            }
+        }
+        break;
+    }
+
+    if (bRemoved)
+    {
+        pruneNodePath(lstPath);
+    }
+    return bRemoved;
+}
+
+template <typename Visitor>
+void MCPSubscriptionIndex::visitMatchingSets(const QString& strUri, Visitor visitor) const
+{
+    // visitor返回true表示停止遍历
+    const QChar* pData = strUri.constData();
+    const int nLength = strUri.size();
+    const Node* pNode = m_pRoot;
+    int nPos = 0;
+    while (true)
+    {
+        if (!pNode->setPrefixSessions.isEmpty() && visitor(pNode->setPrefixSessions))
+        {
+            return;
+        }
+        for (const auto& globEntry : pNode->lstGlobs)
+        {
+            const QChar* pGlob = globEntry.strGlob.constData();
+            if (matchGlob(pGlob, pGlob + globEntry.strGlob.size(), pData + nPos, pData + nLength)
+                && visitor(globEntry.setSessions))
+            {
+                return;
+            }
+        }
+
+        if (nPos == nLength)
+        {
+            if (!pNode->setExactSessions.isEmpty())
+            {
+                visitor(pNode->setExactSessions);
+            }
+            return;
+        }
+
+        auto it = pNode->dictChildren.constFind(pData[nPos]);
+        if (it == pNode->dictChildren.constEnd())
+        {
+            return;
+        }
+        const Node* pChild = it.value();
+        const int nEdgeLength = pChild->strEdge.size();
+        if (nLength - nPos < nEdgeLength)
+        {
+            return;
+        }
+        const QChar* pEdge = pChild->strEdge.constData();
+        for (int i = 1; i < nEdgeLength; ++i)
+        {
+            if (pData[nPos + i] != pEdge[i])
+            {
+                return;
+            }
+        }
+        nPos += nEdgeLength;
+        pNode = pChild;
+    }
+}
+
+bool MCPSubscriptionIndex::hasSubscribers(const QString& strUri) const
+{
+    bool bFound = false;
+    visitMatchingSets(strUri, [&bFound](const QSet<QString>& setSessions)
+    {
+        bFound = !setSessions.isEmpty();
+        return bFound;
+    });
+    return bFound;
+}
+
+int MCPSubscriptionIndex::forEachSubscriber(const QString& strUri,
+                                            const std::function<void(const QString&)>& visitor) const
+{
+    // 只收集集合指针；一个URI通常只命中极少数模式，去重时回查前面的集合即可
+    QVarLengthArray<const QSet<QString>*, 8> arrMatchedSets;
+    visitMatchingSets(strUri, [&arrMatchedSets](const QSet<QString>& setSessions)
+    {
+        arrMatchedSets.append(&setSessions);
+        return false;
+    });
+
+    int nVisited = 0;
+    for (int i = 0; i < arrMatchedSets.size(); ++i)
+    {
+        for (const QString& strSessionId : *arrMatchedSets[i])
+        {
+            bool bSeen = false;
+            for (int j = 0; j < i && !bSeen; ++j)
+            {
+                bSeen = arrMatchedSets[j]->contains(strSessionId);
+            }
+            if (!bSeen)
+            {
+                visitor(strSessionId);
+                ++nVisited;
+            }
+        }
+    }
+    return nVisited;
+}
+
+void MCPSubscriptionIndex::clear()
+{
+    delete m_pRoot;
+    m_pRoot = new Node();
+}
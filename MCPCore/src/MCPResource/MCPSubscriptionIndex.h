@@ -0,0 +1,125 @@
+/**
+ * @file MCPSubscriptionIndex.h
+ * @brief MCP资源订阅索引（基数树，支持前缀和通配符订阅）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QChar>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <functional>
+
+/**
+ * @brief MCP资源订阅索引
+ *
+ * 职责：
+ * - 按订阅模式的字面前缀组织成基数树（压缩前缀树）
+ * - 资源变化时沿URI走一遍树即可找到所有匹配的会话，耗时与URI长度成正比
+ * - 匹配结果原地遍历，不复制会话集合
+ *
+ * 订阅模式：
+ * - 精确：不含 '*' 的URI，例如 file:///project/a.txt
+ * - 前缀：以 "**" 结尾且不含其他通配符，匹配该前缀下的所有URI，例如 file:///project/**
+ * - 通配：其他含 '*' 的模式，'*' 匹配不含 '/' 的任意字符，"**" 匹配任意字符，例如 file:///project/*.txt
+ * - '?' 在URI中常用于查询参数，不作为通配符
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 指针类型添加 p 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPSubscriptionIndex
+{
+public:
+    MCPSubscriptionIndex();
+    ~MCPSubscriptionIndex();
+
+public:
+    /**
+     * @brief 添加订阅
+     * @param strPattern 订阅模式（精确URI、前缀或通配模式）
+     * @param strSessionId 会话ID
+     * @return true表示新增，false表示已存在
+     */
+    bool insert(const QString& strPattern, const QString& strSessionId);
+
+    /**
+     * @brief 移除订阅
+     * @param strPattern 订阅模式（必须与订阅时一致）
+     * @param strSessionId 会话ID
+     * @return true表示已移除，false表示不存在该订阅
+     */
+    bool remove(const QString& strPattern, const QString& strSessionId);
+
+    /**
+     * @brief 检查URI是否有任意订阅者（找到第一个即返回）
+     */
+    bool hasSubscribers(const QString& strUri) const;
+
+    /**
+     * @brief 原地遍历匹配URI的所有会话，同一会话通过多个模式匹配时只访问一次
+     * @param strUri 资源URI
+     * @param visitor 访问回调，参数为会话ID
+     * @return 访问的会话数
+     */
+    int forEachSubscriber(const QString& strUri, const std::function<void(const QString&)>& visitor) const;
+
+    /**
+     * @brief 清空所有订阅
+     */
+    void clear();
+
+    /**
+     * @brief 判断订阅字符串是否为前缀或通配模式
+     */
+    static bool isPattern(const QString& strPattern);
+
+private:
+    struct GlobEntry
+    {
+        QString strGlob;            // 字面前缀之后的通配部分
+        QSet<QString> setSessions;
+    };
+
+    struct Node
+    {
+        QString strEdge;                    // 从父节点到本节点的边标签
+        QHash<QChar, Node*> dictChildren;   // 子节点，按边标签首字符索引
+        QSet<QString> setExactSessions;     // 精确订阅该路径的会话
+        QSet<QString> setPrefixSessions;    // 订阅该路径下所有URI的会话
+        QList<GlobEntry> lstGlobs;          // 以该路径为字面前缀的通配订阅
+
+        ~Node();
+        bool isEmpty() const;
+    };
+
+    enum class PatternKind
+    {
+        Exact,
+        Prefix,
+        Glob
+    };
+
+private:
+    static PatternKind parsePattern(const QString& strPattern, QString& strLiteral, QString& strGlob);
+    static bool matchGlob(const QChar* pPattern, const QChar* pPatternEnd, const QChar* pText, const QChar* pTextEnd);
+    Node* findOrCreateNode(const QString& strLiteral);
+    QList<Node*> findNodePath(const QString& strLiteral) const;
+    void pruneNodePath(const QList<Node*>& lstPath);
+
+    /**
+     * @brief 沿URI收集匹配的会话集合指针（不复制集合）
+     */
+    template <typename Visitor>
+    void visitMatchingSets(const QString& strUri, Visitor visitor) const;
+
+private:
+    Node* m_pRoot;
+
+    Q_DISABLE_COPY(MCPSubscriptionIndex)
+};
@@ -0,0 +1,495 @@
+/**
+ * @file MCPUriTemplateMatcher.cpp
+ * @brief MCP URI模板匹配器实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPUriTemplateMatcher.h"
+#include <QSet>
+#include <QUrl>
+#include <QUrlQuery>
+
+MCPUriTemplateMatcher::Node::Node(int nKind)
+    : nVarKind(nKind)
+    , nTemplate(-1)
+    , nQueryTemplate(-1)
+{
+    for (int i = 0; i < VarKindCount; ++i)
+    {
+        arrVarChildren[i] = nullptr;
+    }
+}
+
+MCPUriTemplateMatcher::Node::~Node()
+{
+    qDeleteAll(dictLiterals);
+    for (int i = 0; i < VarKindCount; ++i)
+    {
+        delete arrVarChildren[i];
+    }
+}
+
+MCPUriTemplateMatcher::MCPUriTemplateMatcher()
+    : m_pRoot(new Node(-1))
+{
+}
+
+MCPUriTemplateMatcher::~MCPUriTemplateMatcher()
+{
+    delete m_pRoot;
+}
+
+bool MCPUriTemplateMatcher::insert(const QString& strUriTemplate, QString* pError)
+{
+    QString strError;
+    CompiledTemplate compiled;
+    if (contains(strUriTemplate))
+    {
+        strError = "Template already exists";
+    }
+    else if (compile(strUriTemplate, compiled, strError))
+    {
+        m_lstTemplates.append(compiled);
+        if (insertCompiled(m_lstTemplates.size() - 1, strError))
+        {
+            return true;
+        }
+        // 与已有模板冲突：插入前已检查，树未被修改，只需移除列表末尾
+        m_lstTemplates.removeLast();
+    }
+
+    if (pError != nullptr)
+    {
+        *pError = strError;
+    }
+    return false;
+}
+
+bool MCPUriTemplateMatcher::remove(const QString& strUriTemplate)
+{
+    for (int i = 0; i < m_lstTemplates.size(); ++i)
+    {
+        if (m_lstTemplates.at(i).strUriTemplate == strUriTemplate)
+        {
+            // 节点通过下标引用模板，移除后整体重建（模板移除不在热路径上）
+            m_lstTemplates.removeAt(i);
+            rebuild();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MCPUriTemplateMatcher::contains(const QString& strUriTemplate) const
+{
+    for (const auto& compiled : m_lstTemplates)
+    {
+        if (compiled.strUriTemplate == strUriTemplate)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MCPUriTemplateMatcher::clear()
+{
+    m_lstTemplates.clear();
+    delete m_pRoot;
+    m_pRoot = new Node(-1);
+}
+
+bool MCPUriTemplateMatcher::isTemplate(const QString& strUri)
+{
+    return strUri.contains('{');
+}
+
+bool MCPUriTemplateMatcher::match(const QString& strUri, Match& match) const
+{
+    if (m_lstTemplates.isEmpty())
+    {
+        return false;
+    }
+
+    QVector<State> lstActive;
+    QVector<State> lstNext;
+    QSet<const Node*> setReached;
+    lstActive.append(State{ m_pRoot, QVector<int>() });
+
+    int nBestTemplate = -1;
+    int nBestQueryPos = -1;
+    State bestState;
+    auto consider = [this, &nBestTemplate, &nBestQueryPos, &bestState](const State& state, int nTemplate, int nQueryPos)
+    {
+        if (nBestTemplate < 0
+            || m_lstTemplates.at(nTemplate).nLiteralLength > m_lstTemplates.at(nBestTemplate).nLiteralLength
+            || (m_lstTemplates.at(nTemplate).nLiteralLength == m_lstTemplates.at(nBestTemplate).nLiteralLength
+                && nTemplate < nBestTemplate))
+        {
+            nBestTemplate = nTemplate;
+            nBestQueryPos = nQueryPos;
+            bestState = state;
+        }
+    };
+
+    const int nLength = strUri.size();
+    for (int i = 0; i <= nLength && !lstActive.isEmpty(); ++i)
+    {
+        const bool bEnd = (i == nLength);
+        const QChar ch = bEnd ? QChar() : strUri.at(i);
+
+        // 路径部分在URI末尾或'?'处结束时，查询模板可以命中
+        if (bEnd || ch == '?')
+        {
+            for (const State& state : lstActive)
+            {
+                if (state.pNode->nQueryTemplate >= 0)
+                {
+                    consider(state, state.pNode->nQueryTemplate, bEnd ? -1 : i);
+                }
+            }
+        }
+        if (bEnd)
+        {
+            for (const State& state : lstActive)
+            {
+                if (state.pNode->nTemplate >= 0)
+                {
+                    consider(state, state.pNode->nTemplate, -1);
+                }
+            }
+            break;
+        }
+
+        // 推进所有存活状态；同一节点只保留最先到达的状态
+        lstNext.clear();
+        setReached.clear();
+        for (const State& state : lstActive)
+        {
+            const Node* pNode = state.pNode;
+
+            auto itLiteral = pNode->dictLiterals.constFind(ch);
+            if (itLiteral != pNode->dictLiterals.constEnd() && !setReached.contains(itLiteral.value()))
+            {
+                setReached.insert(itLiteral.value());
+                lstNext.append(State{ itLiteral.value(), state.arrCaptures });
+            }
+
+            if (pNode->nVarKind >= 0 && isVarChar(pNode->nVarKind, ch) && !setReached.contains(pNode))
+            {
+                // 变量继续吸收当前字符
+                setReached.insert(pNode);
+                State next{ pNode, state.arrCaptures };
+                next.arrCaptures.last() = i + 1;
+                lstNext.append(next);
+            }
+
+            for (int nKind = 0; nKind < VarKindCount; ++nKind)
+            {
+                const Node* pVarNode = pNode->arrVarChildren[nKind];
+                if (pVarNode != nullptr && isVarChar(nKind, ch) && !setReached.contains(pVarNode))
+                {
+                    // 进入新变量，至少吸收一个字符
+                    setReached.insert(pVarNode);
+                    State next{ pVarNode, state.arrCaptures };
+                    next.arrCaptures.append(i);
+                    next.arrCaptures.append(i + 1);
+                    lstNext.append(next);
+                }
+            }
+        }
+        lstActive.swap(lstNext);
+    }
+
+    if (nBestTemplate < 0)
+    {
+        return false;
+    }
+    fillMatch(bestState, nBestTemplate, strUri, nBestQueryPos, match);
+    return true;
+}
+
+void MCPUriTemplateMatcher::fillMatch(const State& state, int nTemplate, const QString& strUri, int nQueryPos, Match& match) const
+{
+    const CompiledTemplate& compiled = m_lstTemplates.at(nTemplate);
+    match.strUriTemplate = compiled.strUriTemplate;
+    match.dictVariables.clear();
+
+    for (int i = 0; i < compiled.lstPathVariables.size() && i * 2 + 1 < state.arrCaptures.size(); ++i)
+    {
+        const int nStart = state.arrCaptures.at(i * 2);
+        const int nEnd = state.arrCaptures.at(i * 2 + 1);
+        match.dictVariables.insert(compiled.lstPathVariables.at(i),
+            QUrl::fromPercentEncoding(strUri.mid(nStart, nEnd - nStart).toUtf8()));
+    }
+
+    if (nQueryPos >= 0 && !compiled.lstQueryVariables.isEmpty())
+    {
+        QString strQuery = strUri.mid(nQueryPos + 1);
+        int nFragmentPos = strQuery.indexOf('#');
+        if (nFragmentPos >= 0)
+        {
+            strQuery.truncate(nFragmentPos);
+        }
+        QUrlQuery query(strQuery);
+        for (const QString& strName : compiled.lstQueryVariables)
+        {
+            if (query.hasQueryItem(strName))
+            {
+                match.dictVariables.insert(strName, query.queryItemValue(strName, QUrl::FullyDecoded));
+            }
+        }
+    }
+}
+
+bool MCPUriTemplateMatcher::compile(const QString& strUriTemplate, CompiledTemplate& compiled, QString& strError)
+{
+    compiled.strUriTemplate = strUriTemplate;
+    compiled.nLiteralLength = 0;
+    QSet<QString> setNames;
+    bool bQueryStarted = false;
+
+    auto appendLiteral = [&compiled](const QString& strText)
+    {
+        if (!compiled.lstTokens.isEmpty() && compiled.lstTokens.last().bLiteral)
+        {
+            compiled.lstTokens.last().strText += strText;
+        }
+        else
+        {
+            compiled.lstTokens.append(Token{ true, strText, -1 });
+        }
+        compiled.nLiteralLength += strText.size();
+    };
+
+    int i = 0;
+    const int nLength = strUriTemplate.size();
+    while (i < nLength)
+    {
+        const QChar ch = strUriTemplate.at(i);
+        if (ch == '}')
+        {
+            strError = QString("Unmatched '}' at position %1").arg(i);
+            return false;
+        }
+        if (ch != '{')
+        {
+            if (bQueryStarted)
+            {
+                strError = "Query expressions must be at the end of the template";
+                return false;
+            }
+            appendLiteral(QString(ch));
+            ++i;
+            continue;
+        }
+
+        int nClose = strUriTemplate.indexOf('}', i + 1);
+        if (nClose < 0)
+        {
+            strError = QString("Unclosed expression at position %1").arg(i);
+            return false;
+        }
+        QString strExpression = strUriTemplate.mid(i + 1, nClose - i - 1);
+        i = nClose + 1;
+        if (strExpression.isEmpty())
+        {
+            strError = "Empty expression";
+            return false;
+        }
+
+        QChar chOperator;
+        if (QString("+#./;?&").contains(strExpression.at(0)))
+        {
+            chOperator = strExpression.at(0);
+            strExpression.remove(0, 1);
+        }
+
+        // 解析变量列表，去掉前缀修饰符(:n)，记录展开修饰符(*)
+        QStringList lstNames;
+        bool bExplode = false;
+        for (QString strName : strExpression.split(','))
+        {
+            if (strName.endsWith('*'))
+            {
+                bExplode = true;
+                strName.chop(1);
+            }
+            int nColon = strName.indexOf(':');
+            if (nColon >= 0)
+            {
+                strName.truncate(nColon);
+            }
+            if (strName.isEmpty())
+            {
+                strError = "Empty variable name";
+                return false;
+            }
+            for (QChar chName : strName)
+            {
+                if (!chName.isLetterOrNumber() && chName != '_' && chName != '.' && chName != '%')
+                {
+                    strError = QString("Invalid variable name: %1").arg(strName);
+                    return false;
+                }
+            }
+            if (setNames.contains(strName))
+            {
+                strError = QString("Duplicate variable name: %1").arg(strName);
+                return false;
+            }
+            setNames.insert(strName);
+            lstNames.append(strName);
+        }
+
+        if (chOperator == '?' || chOperator == '&')
+        {
+            bQueryStarted = true;
+            compiled.lstQueryVariables.append(lstNames);
+            continue;
+        }
+        if (bQueryStarted)
+        {
+            strError = "Query expressions must be at the end of the template";
+            return false;
+        }
+        if (lstNames.size() != 1)
+        {
+            strError = "Multiple variables in one expression are only supported for query expressions";
+            return false;
+        }
+
+        const QString& strName = lstNames.first();
+        int nKind = SegmentVar;
+        if (chOperator == '+')
+        {
+            nKind = ReservedVar;
+        }
+        else if (chOperator == '#')
+        {
+            appendLiteral("#");
+            nKind = FragmentVar;
+        }
+        else if (chOperator == '/')
+        {
+            appendLiteral("/");
+            nKind = bExplode ? ReservedVar : SegmentVar;
+        }
+        else if (chOperator == '.')
+        {
+            appendLiteral(".");
+            nKind = LabelVar;
+        }
+        else if (chOperator == ';')
+        {
+            appendLiteral(";" + strName + "=");
+            nKind = ParamVar;
+        }
+        compiled.lstTokens.append(Token{ false, strName, nKind });
+        compiled.lstPathVariables.append(strName);
+    }
+
+    if (compiled.lstPathVariables.isEmpty() && compiled.lstQueryVariables.isEmpty())
+    {
+        strError = "Template has no variables";
+        return false;
+    }
+    return true;
+}
+
+bool MCPUriTemplateMatcher::isVarChar(int nVarKind, QChar ch)
+{
+    switch (nVarKind)
+    {
+    case SegmentVar:
+        return ch != '/' && ch != '?' && ch != '#';
+    case LabelVar:
+        return ch != '.' && ch != '/' && ch != '?' && ch != '#';
+    case ParamVar:
+        return ch != ';' && ch != '/' && ch != '?' && ch != '#';
+    case ReservedVar:
+        return ch != '?' && ch != '#';
+    case FragmentVar:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool MCPUriTemplateMatcher::insertCompiled(int nIndex, QString& strError)
+{
+    const CompiledTemplate& compiled = m_lstTemplates.at(nIndex);
+    const bool bQuery = !compiled.lstQueryVariables.isEmpty();
+
+    // 先只读地走一遍，结构相同的模板已存在时不修改树
+    const Node* pExisting = m_pRoot;
+    for (const Token& token : compiled.lstTokens)
+    {
+        if (token.bLiteral)
+        {
+            for (QChar ch : token.strText)
+            {
+                pExisting = pExisting != nullptr ? pExisting->dictLiterals.value(ch, nullptr) : nullptr;
+            }
+        }
+        else
+        {
+            pExisting = pExisting != nullptr ? pExisting->arrVarChildren[token.nVarKind] : nullptr;
+        }
+    }
+    if (pExisting != nullptr && (bQuery ? pExisting->nQueryTemplate : pExisting->nTemplate) >= 0)
+    {
+        int nConflict = bQuery ? pExisting->nQueryTemplate : pExisting->nTemplate;
+        strError = QString("Template conflicts with existing template: %1").arg(m_lstTemplates.at(nConflict).strUriTemplate);
+        return false;
+    }
+
+    Node* pNode = m_pRoot;
+    for (const Token& token : compiled.lstTokens)
+    {
+        if (token.bLiteral)
+        {
+            for (QChar ch : token.strText)
+            {
+                Node*& pChild = pNode->dictLiterals[ch];
+                if (pChild == nullptr)
+                {
+                    pChild = new Node(-1);
+                }
+                pNode = pChild;
+            }
+        }
+        else
+        {
+            Node*& pChild = pNode->arrVarChildren[token.nVarKind];
+            if (pChild == nullptr)
+            {
+                pChild = new Node(token.nVarKind);
+            }
+            pNode = pChild;
+        }
+    }
+
+    if (bQuery)
+    {
+        pNode->nQueryTemplate = nIndex;
+    }
+    else
+    {
+        pNode->nTemplate = nIndex;
+    }
+    return true;
+}
+
+void MCPUriTemplateMatcher::rebuild()
+{
+    delete m_pRoot;
+    m_pRoot = new Node(-1);
+    QString strError;
+    for (int i = 0; i < m_lstTemplates.size(); ++i)
+    {
+        insertCompiled(i, strError);
+    }
+}
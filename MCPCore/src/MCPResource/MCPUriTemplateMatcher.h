@@ -0,0 +1,153 @@
+/**
+ * @file MCPUriTemplateMatcher.h
+ * @brief MCP URI模板匹配器（RFC 6570模板编译为前缀树自动机）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QChar>
+#include <QHash>
+#include <QMap>
+#include <QList>
+#include <QVector>
+
+/**
+ * @brief MCP URI模板匹配器
+ *
+ * 职责：
+ * - 将所有URI模板编译进同一棵前缀树：字面字符是确定的边，变量是带字符集的自环节点
+ * - 匹配时按URI逐字符推进当前存活的节点集合（Thompson式模拟，不回溯），
+ *   每个字符只处理一次，耗时与URI长度成正比，与模板数量无关（存活节点只来自与URI前缀一致的分支）
+ * - 多个模板都能匹配时，字面字符最多（最具体）的模板优先，相同时先注册的优先
+ *
+ * 支持的RFC 6570表达式（用于匹配，变量值做百分号解码）：
+ * - {var}     不含 '/'、'?'、'#'
+ * - {+var}    不含 '?'、'#'（可跨路径段）
+ * - {#var}    '#' 之后的任意字符
+ * - {/var}    '/' 加一个路径段；{/var*} 可匹配多个路径段
+ * - {.var}    '.' 加不含 '.' 的标签
+ * - {;var}    ";var=" 加参数值
+ * - {?a,b}、{&c}  查询参数（只能位于模板末尾，顺序任意，均为可选）
+ * - 前缀修饰符 :n 在匹配时忽略；除查询表达式外，一个表达式只能有一个变量
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 指针类型添加 p 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPUriTemplateMatcher
+{
+public:
+    /**
+     * @brief 匹配结果
+     */
+    struct Match
+    {
+        QString strUriTemplate;                 // 命中的模板
+        QMap<QString, QString> dictVariables;   // 变量名 -> 解码后的值
+    };
+
+public:
+    MCPUriTemplateMatcher();
+    ~MCPUriTemplateMatcher();
+
+public:
+    /**
+     * @brief 编译并添加模板
+     * @param strUriTemplate URI模板
+     * @param pError 输出：失败原因（语法错误或与已有模板结构相同）
+     * @return true表示添加成功
+     */
+    bool insert(const QString& strUriTemplate, QString* pError = nullptr);
+
+    /**
+     * @brief 移除模板（重建前缀树）
+     * @return true表示已移除，false表示不存在
+     */
+    bool remove(const QString& strUriTemplate);
+
+    /**
+     * @brief 检查模板是否已添加
+     */
+    bool contains(const QString& strUriTemplate) const;
+
+    /**
+     * @brief 匹配URI
+     * @param strUri 资源URI
+     * @param match 输出：命中的模板和变量
+     * @return true表示有模板匹配
+     */
+    bool match(const QString& strUri, Match& match) const;
+
+    /**
+     * @brief 清空所有模板
+     */
+    void clear();
+
+    /**
+     * @brief 判断字符串是否包含模板表达式
+     */
+    static bool isTemplate(const QString& strUri);
+
+private:
+    enum VarKind
+    {
+        SegmentVar = 0,     // {var}
+        LabelVar,           // {.var}
+        ParamVar,           // {;var}
+        ReservedVar,        // {+var}、{/var*}
+        FragmentVar,        // {#var}
+        VarKindCount
+    };
+
+    struct Token
+    {
+        bool bLiteral;
+        QString strText;    // 字面文本或变量名
+        int nVarKind;
+    };
+
+    struct CompiledTemplate
+    {
+        QString strUriTemplate;
+        QList<Token> lstTokens;             // 路径部分（字面和变量）
+        QStringList lstPathVariables;       // 路径变量名（按出现顺序）
+        QStringList lstQueryVariables;      // 查询变量名
+        int nLiteralLength;                 // 字面字符数（用于确定优先级）
+    };
+
+    struct Node
+    {
+        QHash<QChar, Node*> dictLiterals;   // 字面字符边
+        Node* arrVarChildren[VarKindCount]; // 变量边（按字符集种类）
+        int nVarKind;                       // 本节点为变量节点时的种类，字面节点为-1
+        int nTemplate;                      // 在此结束的模板（无查询参数），-1表示无
+        int nQueryTemplate;                 // 在此结束路径部分的查询模板，-1表示无
+
+        explicit Node(int nKind);
+        ~Node();
+    };
+
+    struct State
+    {
+        const Node* pNode;
+        QVector<int> arrCaptures;           // 路径变量的[起始, 结束)位置对
+    };
+
+private:
+    static bool compile(const QString& strUriTemplate, CompiledTemplate& compiled, QString& strError);
+    static bool isVarChar(int nVarKind, QChar ch);
+    bool insertCompiled(int nIndex, QString& strError);
+    void rebuild();
+    void fillMatch(const State& state, int nTemplate, const QString& strUri, int nQueryPos, Match& match) const;
+
+private:
+    Node* m_pRoot;
+    QList<CompiledTemplate> m_lstTemplates;   // 节点通过下标引用
+
+    Q_DISABLE_COPY(MCPUriTemplateMatcher)
+};
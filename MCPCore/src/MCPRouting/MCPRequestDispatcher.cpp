@@ -11,6 +11,8 @@
 #include <QJsonParseError>
 #include "MCPMessage/MCPMessage.h"
 #include "MCPContext.h"
+#include "MCPSession/MCPSession.h"
+#include "MCPSession/MCPSessionService.h"
 #include "MCPTools/MCPToolService.h"
 #include "MCPResource/MCPResourceService.h"
 #include "MCPPrompt/MCPPromptService.h"
@@ -21,6 +23,10 @@
 #include "MCPSubscriptionHandler.h"
 #include "MCPMiddleware/MCPMiddlewares.h"
 #include "MCPServer/MCPServer.h"
+#include "IMCPServerConfig.h"
+#include "MCPTools/MCPToolResultCache.h"
+#include "Utils/MCPCursor.h"
+#include <QMutexLocker>
 #include <QtConcurrent>
 
 MCPRequestDispatcher::MCPRequestDispatcher(MCPServer* pServer,
@@ -58,6 +64,11 @@ void MCPRequestDispatcher::initializeRoutes()
         return handleConnect(pContext);
     });
     
+    m_pRouter->registerRoute("stream", [this](const QSharedPointer<MCPContext>& pContext)
+    {
+        return handleEventStream(pContext);
+    });
+    
     m_pRouter->registerRoute("initialize", [this](const QSharedPointer<MCPContext>& pContext)
     {
         return m_pInitializeHandler->handleInitialize(pContext);
@@ -113,6 +124,11 @@ void MCPRequestDispatcher::initializeRoutes()
         return handleGetPrompt(pContext);
     });
     
+    m_pRouter->registerRoute("notifications/cancelled", [this](const QSharedPointer<MCPContext>& pContext)
+    {
+        return handleCancelled(pContext);
+    });
+    
     m_pRouter->registerRoute("notifications/subscribe", [this](const QSharedPointer<MCPContext>& pContext)
     {
         return m_pSubscriptionHandler->handleSubscribe(pContext);
@@ -135,78 +151,231 @@ QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleConnect(const QShar
 	return QSharedPointer<MCPServerMessage>::create(pContext, (MCPMessageType::Flags)MCPMessageType::Connect);
 }
 
+QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleEventStream(const QSharedPointer<MCPContext>& pContext)
+{
+	// 会话不存在或未初始化时MCPServerHandler已按HTTP状态码拒绝
+	m_pServer->getSessionService()->bindEventStream(pContext->getSession(), pContext->getConnectionId());
+	return QSharedPointer<MCPServerMessage>::create(pContext, (MCPMessageType::Flags)MCPMessageType::Connect);
+}
+
 QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleToolsList(const QSharedPointer<MCPContext>& pContext)
 {
-    QJsonArray arrTools = m_pServer->getToolService()->list();
-    return QSharedPointer<MCPServerMessage>::create(pContext, QJsonObject{ {"tools", arrTools} });
+    auto jsonParams = pContext->getClientMessage()->getParmams().toObject();
+    QString strAfterName;
+    quint64 nGeneration = 0;
+    if (!parseListCursor(jsonParams, "tools", m_pServer->getToolService()->getListGeneration(), strAfterName, nGeneration))
+    {
+        return QSharedPointer<MCPServerErrorResponse>::create(pContext, MCPError::invalidParams("Invalid cursor"));
+    }
+    // 首页先记录代数再取列表：列表至少包含该代数的内容，之后的增量从该代数开始计算；
+    // 后续页不再改动，翻页期间的变化由该代数之后的list_changed通知客户端
+    if (pContext->getSession() != nullptr && !jsonParams.contains("cursor"))
+    {
+        pContext->getSession()->setListGeneration(MCPPendingNotificationType::ToolsListChanged, nGeneration);
+    }
+    QString strLastName;
+    QJsonArray arrTools = m_pServer->getToolService()->listPage(strAfterName, m_pServer->getConfig()->getListPageSize(), strLastName);
+    QJsonObject result{ {"tools", arrTools} };
+    if (!strLastName.isEmpty())
+    {
+        result["nextCursor"] = createListCursor("tools", nGeneration, strLastName);
+    }
+    return QSharedPointer<MCPServerMessage>::create(pContext, result);
 }
 
 QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleToolsCall(const QSharedPointer<MCPContext>& pContext)
 {
-	QtConcurrent::run([this, pContext]()
+	auto jsonCall = pContext->getClientMessage()->getParmams().toObject();
+	QString strToolName = jsonCall.value("name").toString();
+	QJsonObject jsonCallArguments = jsonCall.value("arguments").toObject();
+
+	auto pFlight = QSharedPointer<ToolCallFlight>::create();
+	{
+		QMutexLocker locker(&m_flightMutex);
+		if (m_pServer->getToolService()->isSingleFlightEnabled(strToolName))
 		{
-			auto pServerMessage = syncHandleToolsCall(pContext);
-			emit this->serverMessageReceived(pServerMessage);
+			pFlight->flightKey = strToolName.toUtf8() + '\0' + MCPToolResultCache::canonicalKey(jsonCallArguments);
+			if (auto pRunningFlight = m_dictInFlightCalls.value(pFlight->flightKey))
+			{
+				// 相同调用正在执行，挂到已有执行上等待结果
+				pRunningFlight->lstWaiters.append(pContext);
+				m_dictPendingRequests.insert(getRequestKey(pContext), pRunningFlight);
+				MCP_CORE_LOG_DEBUG() << "工具调用合并到执行中的调用:" << strToolName << "等待者:" << pRunningFlight->lstWaiters.size();
+				return QSharedPointer<MCPServerMessage>();
+			}
+			m_dictInFlightCalls.insert(pFlight->flightKey, pFlight);
+		}
+		pFlight->lstWaiters.append(pContext);
+		m_dictPendingRequests.insert(getRequestKey(pContext), pFlight);
+	}
+
+	QtConcurrent::run([this, pFlight, strToolName, jsonCallArguments]()
+		{
+			runToolsCall(pFlight, strToolName, jsonCallArguments);
 		});
 	return QSharedPointer<MCPServerMessage>();
 }
 
-QSharedPointer<MCPServerMessage> MCPRequestDispatcher::syncHandleToolsCall(const QSharedPointer<MCPContext>& pContext)
+void MCPRequestDispatcher::runToolsCall(const QSharedPointer<ToolCallFlight>& pFlight, const QString& strToolName, const QJsonObject& jsonCallArguments)
 {
-	auto pClientMesage = pContext->getClientMessage().dynamicCast<MCPClientMessage>();
-    auto jsonCall = pClientMesage->getParmams().toObject();
-    QString strToolName = jsonCall.value("name").toString();
-    QJsonObject jsonCallArguments = jsonCall.value("arguments").toObject();
+	auto result = executeToolsCall(strToolName, jsonCallArguments);
 
+	// 执行完成：从执行表中移除，取出仍在等待（未取消）的请求
+	QList<QSharedPointer<MCPContext>> lstWaiters;
+	{
+		QMutexLocker locker(&m_flightMutex);
+		if (!pFlight->flightKey.isEmpty())
+		{
+			m_dictInFlightCalls.remove(pFlight->flightKey);
+		}
+		lstWaiters.swap(pFlight->lstWaiters);
+		for (const auto& pWaiter : lstWaiters)
+		{
+			auto strRequestKey = getRequestKey(pWaiter);
+			if (m_dictPendingRequests.value(strRequestKey) == pFlight)
+			{
+				m_dictPendingRequests.remove(strRequestKey);
+			}
+		}
+	}
+
+	// 每个等待者使用自己的上下文（JSON-RPC ID、连接）生成响应
+	for (const auto& pWaiter : lstWaiters)
+	{
+		emit serverMessageReceived(createToolsCallResponse(pWaiter, result));
+	}
+}
+
+MCPResult<QJsonObject> MCPRequestDispatcher::executeToolsCall(const QString& strToolName, const QJsonObject& jsonCallArguments)
+{
     // 验证必需参数
     if (strToolName.isEmpty())
     {
         // 根据 JSON-RPC 2.0 和 MCP 协议规范，错误消息应该使用英文
-        return QSharedPointer<MCPServerErrorResponse>::create(
-            pContext, 
-            MCPError::invalidParams("Missing required parameter: name")
-        );
+        return MCPError::invalidParams("Missing required parameter: name");
     }
+    //https://modelcontextprotocol.io/docs/learn/architecture
+    //https://modelcontextprotocol.io/specification/2025-06-18/server/tools#structured-content
+    // 常见失败（工具不存在、参数校验失败、处理器执行失败）通过返回值传递，不抛出异常
+    return m_pServer->getToolService()->callTool(strToolName, jsonCallArguments);
+}
 
-    try
+QSharedPointer<MCPServerMessage> MCPRequestDispatcher::createToolsCallResponse(const QSharedPointer<MCPContext>& pContext, const MCPResult<QJsonObject>& result)
+{
+    if (!result)
     {
-        //https://modelcontextprotocol.io/docs/learn/architecture
-        //https://modelcontextprotocol.io/specification/2025-06-18/server/tools#structured-content
-        QJsonObject result = m_pServer->getToolService()->callTool(strToolName, jsonCallArguments);
-        if (result.contains("error"))
-        {
-            return QSharedPointer<MCPServerErrorResponse>::create(pContext, result);
-        }
-        return QSharedPointer<MCPServerMessage>::create(pContext, result);
+        return QSharedPointer<MCPServerErrorResponse>::create(pContext, result.error());
+    }
+    return QSharedPointer<MCPServerMessage>::create(pContext, result.value());
+}
+
+QString MCPRequestDispatcher::getRequestKey(const QString& strSessionId, const QJsonValue& jsonRequestId)
+{
+    // JSON-RPC ID 可以是字符串或数字，加类型前缀避免 "1" 与 1 冲突
+    return jsonRequestId.isString()
+        ? QString("%1#s:%2").arg(strSessionId, jsonRequestId.toString())
+        : QString("%1#n:%2").arg(strSessionId).arg(jsonRequestId.toDouble(), 0, 'g', 17);
+}
+
+QString MCPRequestDispatcher::getRequestKey(const QSharedPointer<MCPContext>& pContext)
+{
+    auto strSessionId = (pContext->getSession() != nullptr) ? pContext->getSession()->getSessionId() : QString();
+    return getRequestKey(strSessionId, pContext->getClientMessage()->getMethodId());
+}
+
+bool MCPRequestDispatcher::parseListCursor(const QJsonObject& jsonParams, const QString& strList, quint64 nCurrentGeneration,
+                                           QString& strAfterKey, quint64& nGeneration)
+{
+    strAfterKey.clear();
+    nGeneration = nCurrentGeneration;
+    if (!jsonParams.contains("cursor"))
+    {
+        return true;
     }
-    catch (const MCPError& error)
+    
+    // 游标：{list, after, generation}，代数用字符串保存避免超出double精度
+    QJsonObject objCursor;
+    if (!MCPCursor::decode(jsonParams.value("cursor").toString(), objCursor)
+        || objCursor.value("list").toString() != strList
+        || !objCursor.value("after").isString())
     {
-        return QSharedPointer<MCPServerErrorResponse>::create(pContext, error);
+        return false;
     }
-    catch (const std::exception& e)
+    bool bOk = false;
+    quint64 nCursorGeneration = objCursor.value("generation").toString().toULongLong(&bOk);
+    // 代数只增不减，比当前代数大说明游标来自服务器重启之前
+    if (!bOk || nCursorGeneration > nCurrentGeneration)
     {
-        MCP_CORE_LOG_WARNING() << "工具调用时发生未知异常:" << e.what();
-        // 根据 MCP 协议规范，内部错误的错误消息应该是英文
-        MCPError error = MCPError::internalError(QString("Tool execution failed: %1").arg(e.what()));
-        return QSharedPointer<MCPServerErrorResponse>::create(pContext, error);
+        return false;
     }
+    strAfterKey = objCursor.value("after").toString();
+    nGeneration = nCursorGeneration;
+    return true;
 }
 
+QString MCPRequestDispatcher::createListCursor(const QString& strList, quint64 nGeneration, const QString& strLastKey)
+{
+    QJsonObject objCursor;
+    objCursor["list"] = strList;
+    objCursor["after"] = strLastKey;
+    objCursor["generation"] = QString::number(nGeneration);
+    return MCPCursor::encode(objCursor);
+}
+
+QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleCancelled(const QSharedPointer<MCPContext>& pContext)
+{
+    // notifications/cancelled: { requestId, reason }
+    // 仅移除对应的等待者，合并执行中的其他等待者不受影响；已开始的执行无法中止，结果被丢弃
+    auto jsonParams = pContext->getClientMessage()->getParmams().toObject();
+    auto strSessionId = (pContext->getSession() != nullptr) ? pContext->getSession()->getSessionId() : QString();
+    auto strRequestKey = getRequestKey(strSessionId, jsonParams.value("requestId"));
+    {
+        QMutexLocker locker(&m_flightMutex);
+        if (auto pFlight = m_dictPendingRequests.take(strRequestKey))
+        {
+            for (int i = pFlight->lstWaiters.size() - 1; i >= 0; --i)
+            {
+                if (getRequestKey(pFlight->lstWaiters[i]) == strRequestKey)
+                {
+                    pFlight->lstWaiters.removeAt(i);
+                }
+            }
+            MCP_CORE_LOG_INFO() << "请求已取消:" << strRequestKey << "原因:" << jsonParams.value("reason").toString();
+        }
+    }
+    // 通知不需要响应
+    return QSharedPointer<MCPServerMessage>::create(pContext, (MCPMessageType::Flags)MCPMessageType::ResponseNotification);
+}
 
 QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleListResources(const QSharedPointer<MCPContext>& pContext)
 {
-    QJsonArray arrResources = m_pServer->getResourceService()->list();
+    auto jsonParams = pContext->getClientMessage()->getParmams().toObject();
+    QString strAfterUri;
+    quint64 nGeneration = 0;
+    if (!parseListCursor(jsonParams, "resources", m_pServer->getResourceService()->getListGeneration(), strAfterUri, nGeneration))
+    {
+        return QSharedPointer<MCPServerErrorResponse>::create(pContext, MCPError::invalidParams("Invalid cursor"));
+    }
+    if (pContext->getSession() != nullptr && !jsonParams.contains("cursor"))
+    {
+        pContext->getSession()->setListGeneration(MCPPendingNotificationType::ResourcesListChanged, nGeneration);
+    }
+    QString strLastUri;
+    QJsonArray arrResources = m_pServer->getResourceService()->listPage(strAfterUri, m_pServer->getConfig()->getListPageSize(), strLastUri);
     QJsonObject result;
     result["resources"] = arrResources;
+    if (!strLastUri.isEmpty())
+    {
+        result["nextCursor"] = createListCursor("resources", nGeneration, strLastUri);
+    }
     return QSharedPointer<MCPServerMessage>::create(pContext, result);
 }
 
 QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleListResourceTemplates(const QSharedPointer<MCPContext>& pContext)
 {
-    // 当前实现不支持资源模板，返回空列表
-    // 根据MCP规范，resources/templates/list应该返回资源模板列表
+    // 根据MCP规范，resources/templates/list返回资源模板列表
     QJsonObject result;
-    result["resourceTemplates"] = QJsonArray();
+    result["resourceTemplates"] = m_pServer->getResourceService()->listTemplates();
     return QSharedPointer<MCPServerMessage>::create(pContext, result);
 }
 
@@ -225,7 +394,31 @@ QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleReadResource(const
         );
     }
     
-    QJsonObject result = m_pServer->getResourceService()->readResource(strUri);
+    // 带offset/length/cursor参数时按范围读取，只读取和传输请求的区间
+    if (MCPResourceService::isRangeRequest(jsonParams))
+    {
+        QString strError;
+        QJsonObject rangeResult = m_pServer->getResourceService()->readResourceRange(strUri, jsonParams, strError);
+        if (!strError.isEmpty())
+        {
+            return QSharedPointer<MCPServerErrorResponse>::create(
+                pContext, 
+                MCPError::invalidParams(strError)
+            );
+        }
+        if (rangeResult.isEmpty())
+        {
+            return QSharedPointer<MCPServerErrorResponse>::create(
+                pContext, 
+                MCPError::resourceNotFound(strUri)
+            );
+        }
+        return QSharedPointer<MCPServerMessage>::create(pContext, rangeResult);
+    }
+    
+    // 大文件资源在结果中只有占位符，序列化响应时再写入文件内容
+    QList<QSharedPointer<MCPStreamedFileContent>> lstStreamedContents;
+    QJsonObject result = m_pServer->getResourceService()->readResourceStreamed(strUri, lstStreamedContents);
     
     if (result.isEmpty())
     {
@@ -236,14 +429,32 @@ QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleReadResource(const
         );
     }
     
-    return QSharedPointer<MCPServerMessage>::create(pContext, result);
+    auto pServerMessage = QSharedPointer<MCPServerMessage>::create(pContext, result);
+    pServerMessage->attachStreamedContents(lstStreamedContents);
+    return pServerMessage;
 }
 
 QSharedPointer<MCPServerMessage> MCPRequestDispatcher::handleListPrompts(const QSharedPointer<MCPContext>& pContext)
 {
-    QJsonArray arrPrompts = m_pServer->getPromptService()->list();
+    auto jsonParams = pContext->getClientMessage()->getParmams().toObject();
+    QString strAfterName;
+    quint64 nGeneration = 0;
+    if (!parseListCursor(jsonParams, "prompts", m_pServer->getPromptService()->getListGeneration(), strAfterName, nGeneration))
+    {
+        return QSharedPointer<MCPServerErrorResponse>::create(pContext, MCPError::invalidParams("Invalid cursor"));
+    }
+    if (pContext->getSession() != nullptr && !jsonParams.contains("cursor"))
+    {
+        pContext->getSession()->setListGeneration(MCPPendingNotificationType::PromptsListChanged, nGeneration);
+    }
+    QString strLastName;
+    QJsonArray arrPrompts = m_pServer->getPromptService()->listPage(strAfterName, m_pServer->getConfig()->getListPageSize(), strLastName);
     QJsonObject result;
     result["prompts"] = arrPrompts;
+    if (!strLastName.isEmpty())
+    {
+        result["nextCursor"] = createListCursor("prompts", nGeneration, strLastName);
+    }
     return QSharedPointer<MCPServerMessage>::create(pContext, result);
 }
 
@@ -11,7 +11,11 @@
 #include <QSharedPointer>
 #include <QJsonArray>
 #include <QString>
+#include <QHash>
+#include <QList>
+#include <QMutex>
 #include "MCPServerMessage.h"
+#include "MCPError/MCPResult.h"
 
 class MCPToolService;
 class MCPResourceService;
@@ -37,6 +41,8 @@ class MCPServer;
  * - 使用MCPRouter进行路由分发
  * - 通过Lambda将处理方法注册到路由器
  * - 保持协议处理方法的集中管理
+ * - 启用 singleFlight 的工具，相同（工具名, 规范化参数）的并发调用只执行一次，
+ *   结果按各自的请求ID分别回复；notifications/cancelled 只取消对应的等待者
  * 
  * 编码规范：
  * - 类成员添加 m_ 前缀
@@ -73,6 +79,7 @@ private:
 private:
     // MCP 协议方法处理器
 	QSharedPointer<MCPServerMessage> handleConnect(const QSharedPointer<MCPContext>& pContext);
+	QSharedPointer<MCPServerMessage> handleEventStream(const QSharedPointer<MCPContext>& pContext);
     QSharedPointer<MCPServerMessage> handleToolsList(const QSharedPointer<MCPContext>& pContext);
     QSharedPointer<MCPServerMessage> handleToolsCall(const QSharedPointer<MCPContext>& pContext);
     QSharedPointer<MCPServerMessage> handleListResources(const QSharedPointer<MCPContext>& pContext);
@@ -81,14 +88,48 @@ private:
     QSharedPointer<MCPServerMessage> handleListPrompts(const QSharedPointer<MCPContext>& pContext);
     QSharedPointer<MCPServerMessage> handleGetPrompt(const QSharedPointer<MCPContext>& pContext);
     QSharedPointer<MCPServerMessage> handlePing(const QSharedPointer<MCPContext>& pContext);
+    QSharedPointer<MCPServerMessage> handleCancelled(const QSharedPointer<MCPContext>& pContext);
     
 private:
-	QSharedPointer<MCPServerMessage> syncHandleToolsCall(const QSharedPointer<MCPContext>& pContext);
+    /**
+     * @brief 一次工具执行及其等待者
+     * 
+     * 未启用 singleFlight 的工具只有一个等待者；启用时相同调用共享同一个实例。
+     */
+    struct ToolCallFlight
+    {
+        QByteArray flightKey;                           // 合并键，为空表示不参与合并
+        QList<QSharedPointer<MCPContext>> lstWaiters;   // 等待结果的请求（各自的JSON-RPC ID）
+    };
+    
+private:
+	void runToolsCall(const QSharedPointer<ToolCallFlight>& pFlight, const QString& strToolName, const QJsonObject& jsonCallArguments);
+	MCPResult<QJsonObject> executeToolsCall(const QString& strToolName, const QJsonObject& jsonCallArguments);
+	QSharedPointer<MCPServerMessage> createToolsCallResponse(const QSharedPointer<MCPContext>& pContext, const MCPResult<QJsonObject>& result);
+	static QString getRequestKey(const QString& strSessionId, const QJsonValue& jsonRequestId);
+	static QString getRequestKey(const QSharedPointer<MCPContext>& pContext);
+    
+    /**
+     * @brief 解析列表分页游标
+     * @param jsonParams 请求参数
+     * @param strList 列表种类（"tools"、"resources"、"prompts"）
+     * @param nCurrentGeneration 列表当前代数
+     * @param strAfterKey 输出：上一页最后一个键，未带游标时为空
+     * @param nGeneration 输出：本次遍历开始时的代数，未带游标时为当前代数
+     * @return 未带游标或游标合法返回true
+     */
+    static bool parseListCursor(const QJsonObject& jsonParams, const QString& strList, quint64 nCurrentGeneration,
+                                QString& strAfterKey, quint64& nGeneration);
+    static QString createListCursor(const QString& strList, quint64 nGeneration, const QString& strLastKey);
     
 private:
     MCPServer* m_pServer;
     MCPRouter* m_pRouter;
     MCPInitializeHandler* m_pInitializeHandler;
     MCPSubscriptionHandler* m_pSubscriptionHandler;
+    
+    QMutex m_flightMutex;                                                  // 保护以下两个表（执行完成在线程池中）
+    QHash<QByteArray, QSharedPointer<ToolCallFlight>> m_dictInFlightCalls; // 合并键 -> 执行中的调用
+    QHash<QString, QSharedPointer<ToolCallFlight>> m_dictPendingRequests;  // (会话, 请求ID) -> 所属调用，用于取消
 };
 
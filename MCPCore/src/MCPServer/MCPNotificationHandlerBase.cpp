@@ -11,7 +11,9 @@
 #include "MCPSession/MCPSessionService.h"
 #include "MCPSession/MCPSession.h"
 #include "MCPSession/MCPPendingNotification.h"
+#include "MCPResource/MCPResourceService.h"
 #include "MCPLog/MCPLog.h"
+#include <QMap>
 
 MCPNotificationHandlerBase::MCPNotificationHandlerBase(MCPServer* pServer, QObject* pParent)
     : QObject(pParent)
@@ -36,62 +38,113 @@ void MCPNotificationHandlerBase::broadcastNotification(const QString& strMethod,
     notification["params"] = objParams;
     
     // 遍历所有会话，根据传输类型决定处理方式
+    QList<quint64> lstSseConnectionIds;
+    QStringList lstEventStreamSessionIds;
+    for (const auto& pSession : allSessions)
+    {
+        if (pSession == nullptr)
+        {
+            continue;
+        }
+        dispatchToSession(pSession, strMethod, objParams, lstSseConnectionIds, lstEventStreamSessionIds);
+    }
+    
+    if (!lstEventStreamSessionIds.isEmpty())
+    {
+        emit eventStreamNotificationsPending(lstEventStreamSessionIds);
+    }
+    
+    if (!lstSseConnectionIds.isEmpty())
+    {
+        emit notificationBroadcastRequested(lstSseConnectionIds, notification);
+        MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 已请求向" << lstSseConnectionIds.size() << "个SSE会话广播通知:" << strMethod;
+    }
+}
+
+void MCPNotificationHandlerBase::broadcastListChangedNotification(const QString& strMethod,
+                                                                  MCPPendingNotificationType enType,
+                                                                  const std::function<bool(quint64, QJsonObject&)>& deltaFun)
+{
+    auto pSessionService = m_pServer->getSessionService();
+    QList<QSharedPointer<MCPSession>> allSessions = pSessionService->getAllSessions();
+    
+    // StreamableTransport会话只标记待发送；SSE会话按已确认的列表代数分组
+    QList<quint64> lstUnusedConnectionIds;
+    QStringList lstEventStreamSessionIds;
+    QMap<quint64, QList<QSharedPointer<MCPSession>>> dictSseSessionsByGeneration;
     for (const auto& pSession : allSessions)
     {
         if (pSession == nullptr)
         {
             continue;
         }
-        
-        QString strSessionId = pSession->getSessionId();
-        
         if (pSession->isStreamableTransport())
         {
-            // StreamableTransport：缓存通知标记，等待下次请求时发送
-            // 根据方法名判断通知类型
-            if (strMethod == "notifications/resources/updated")
-            {
-                QString strUri = objParams.value("uri").toString();
-                pSession->addResourceChangedNotification(strUri);
-            }
-            else if (strMethod == "notifications/resources/list_changed")
-            {
-                pSession->addResourcesListChangedNotification();
-            }
-            else if (strMethod == "notifications/tools/list_changed")
-            {
-                pSession->addToolsListChangedNotification();
-            }
-            else if (strMethod == "notifications/prompts/list_changed")
-            {
-                pSession->addPromptsListChangedNotification();
-            }
-            else
+            dispatchToSession(pSession, strMethod, QJsonObject(), lstUnusedConnectionIds, lstEventStreamSessionIds);
+        }
+        else if (pSession->getSseConnectionId() > 0)
+        {
+            dictSseSessionsByGeneration[pSession->getListGeneration(enType)].append(pSession);
+        }
+    }
+    
+    if (!lstEventStreamSessionIds.isEmpty())
+    {
+        emit eventStreamNotificationsPending(lstEventStreamSessionIds);
+    }
+    
+    QList<quint64> lstBareConnectionIds;
+    for (auto it = dictSseSessionsByGeneration.constBegin(); it != dictSseSessionsByGeneration.constEnd(); ++it)
+    {
+        QJsonObject objDelta;
+        if (!deltaFun(it.key(), objDelta))
+        {
+            // 尚未拉取过列表或代数已不在变更日志中：没有计算增量的基准
+            for (const auto& pSession : it.value())
             {
-                // 未知的通知类型，使用通用方法（向后兼容）
-                MCP_CORE_LOG_WARNING() << "MCPNotificationHandlerBase: 未知的通知方法:" << strMethod;
+                lstBareConnectionIds.append(pSession->getSseConnectionId());
             }
-            MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 通知标记已缓存到StreamableTransport会话:" << strSessionId << ", 方法:" << strMethod;
+            continue;
         }
-        else
+        
+        // 该组会话已拉取到最新列表，无需通知
+        if (objDelta.value("added").toArray().isEmpty() &&
+            objDelta.value("changed").toArray().isEmpty() &&
+            objDelta.value("removed").toArray().isEmpty())
         {
-            // SSE传输：通过信号发送通知
-            emit notificationRequested(strSessionId, notification);
-            MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 已请求向会话" << strSessionId << "发送通知:" << strMethod;
+            continue;
         }
+        
+        quint64 nGeneration = static_cast<quint64>(objDelta.value("generation").toDouble());
+        QList<quint64> lstConnectionIds;
+        for (const auto& pSession : it.value())
+        {
+            pSession->setListGeneration(enType, nGeneration);
+            lstConnectionIds.append(pSession->getSseConnectionId());
+        }
+        QJsonObject notification;
+        notification["method"] = strMethod;
+        notification["params"] = objDelta;
+        emit notificationBroadcastRequested(lstConnectionIds, notification);
     }
-}
-
-void MCPNotificationHandlerBase::sendNotificationToSubscribers(const QString& strMethod,
-                                                                const QJsonObject& objParams,
-                                                                const QSet<QString>& setSubscribedSessionIds)
-{
-    if (setSubscribedSessionIds.isEmpty())
+    
+    if (!lstBareConnectionIds.isEmpty())
     {
-        MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 没有订阅者，方法:" << strMethod;
-        return;
+        // 不带内容的通知，客户端重新拉取列表时更新会话代数
+        QJsonObject notification;
+        notification["method"] = strMethod;
+        notification["params"] = QJsonObject();
+        emit notificationBroadcastRequested(lstBareConnectionIds, notification);
     }
     
+    MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 列表变化通知已分组发送:" << strMethod
+                         << ", SSE代数分组数:" << dictSseSessionsByGeneration.size();
+}
+
+int MCPNotificationHandlerBase::sendNotificationToSubscribers(const QString& strMethod,
+                                                               const QJsonObject& objParams,
+                                                               const QString& strUri)
+{
     // 构建通知消息
     QJsonObject notification;
     notification["method"] = strMethod;
@@ -99,48 +152,80 @@ void MCPNotificationHandlerBase::sendNotificationToSubscribers(const QString& st
     
     auto pSessionService = m_pServer->getSessionService();
     
-    // 遍历每个订阅者，根据传输类型决定处理方式
-    for (const QString& strSessionId : setSubscribedSessionIds)
+    // 在订阅索引中原地遍历订阅者，根据传输类型决定处理方式
+    QList<quint64> lstSseConnectionIds;
+    QStringList lstEventStreamSessionIds;
+    int nSubscriberCount = m_pServer->getResourceService()->forEachSubscribedSession(strUri, [&](const QString& strSessionId)
     {
         auto pSession = pSessionService->getSessionBySessionId(strSessionId);
-        if (pSession == nullptr)
+        if (pSession != nullptr)
         {
-            continue;
+            dispatchToSession(pSession, strMethod, objParams, lstSseConnectionIds, lstEventStreamSessionIds);
         }
-        if (pSession->isStreamableTransport())
+    });
+    
+    if (nSubscriberCount == 0)
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 没有订阅者，方法:" << strMethod;
+        return 0;
+    }
+    
+    if (!lstEventStreamSessionIds.isEmpty())
+    {
+        emit eventStreamNotificationsPending(lstEventStreamSessionIds);
+    }
+    
+    if (!lstSseConnectionIds.isEmpty())
+    {
+        emit notificationBroadcastRequested(lstSseConnectionIds, notification);
+        MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 已请求向" << lstSseConnectionIds.size() << "个SSE订阅会话广播通知:" << strMethod;
+    }
+    return nSubscriberCount;
+}
+
+void MCPNotificationHandlerBase::dispatchToSession(const QSharedPointer<MCPSession>& pSession,
+                                                   const QString& strMethod,
+                                                   const QJsonObject& objParams,
+                                                   QList<quint64>& lstSseConnectionIds,
+                                                   QStringList& lstEventStreamSessionIds)
+{
+    QString strSessionId = pSession->getSessionId();
+    
+    if (pSession->isStreamableTransport())
+    {
+        // StreamableTransport：缓存通知标记，等待下次请求时发送
+        // 根据方法名判断通知类型
+        if (strMethod == "notifications/resources/updated")
         {
-            // StreamableTransport：缓存通知标记，等待下次请求时发送
-            // 对于资源变化通知，需要包含URI信息
-            if (strMethod == "notifications/resources/updated")
-            {
-                QString strUri = objParams.value("uri").toString();
-                pSession->addResourceChangedNotification(strUri);
-            }
-            else if (strMethod == "notifications/resources/list_changed")
-            {
-                pSession->addResourcesListChangedNotification();
-            }
-            else if (strMethod == "notifications/tools/list_changed")
-            {
-                pSession->addToolsListChangedNotification();
-            }
-            else if (strMethod == "notifications/prompts/list_changed")
-            {
-                pSession->addPromptsListChangedNotification();
-            }
-            else
-            {
-                // 未知的通知类型，使用通用方法（向后兼容）
-                MCP_CORE_LOG_WARNING() << "MCPNotificationHandlerBase: 未知的通知方法:" << strMethod;
-            }
-            MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 通知标记已缓存到StreamableTransport会话:" << strSessionId << ", 方法:" << strMethod;
+            QString strUri = objParams.value("uri").toString();
+            pSession->addResourceChangedNotification(strUri);
+        }
+        else if (strMethod == "notifications/resources/list_changed")
+        {
+            pSession->addResourcesListChangedNotification();
+        }
+        else if (strMethod == "notifications/tools/list_changed")
+        {
+            pSession->addToolsListChangedNotification();
+        }
+        else if (strMethod == "notifications/prompts/list_changed")
+        {
+            pSession->addPromptsListChangedNotification();
         }
         else
         {
-            // SSE传输：通过信号发送通知
-            emit notificationRequested(strSessionId, notification);
-            MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 已请求向SSE会话" << strSessionId << "发送通知:" << strMethod;
+            // 未知的通知类型，使用通用方法（向后兼容）
+            MCP_CORE_LOG_WARNING() << "MCPNotificationHandlerBase: 未知的通知方法:" << strMethod;
+        }
+        MCP_CORE_LOG_DEBUG() << "MCPNotificationHandlerBase: 通知标记已缓存到StreamableTransport会话:" << strSessionId << ", 方法:" << strMethod;
+        if (pSession->getEventStreamConnectionId() > 0)
+        {
+            lstEventStreamSessionIds.append(strSessionId);
         }
     }
+    else if (pSession->getSseConnectionId() > 0)
+    {
+        // SSE传输：汇总连接ID，循环结束后统一广播
+        lstSseConnectionIds.append(pSession->getSseConnectionId());
+    }
 }
-
@@ -13,6 +13,10 @@
 #include <QJsonArray>
 #include <QSharedPointer>
 #include <QSet>
+#include <QList>
+#include <QStringList>
+#include <functional>
+#include "MCPSession/MCPPendingNotification.h"
 
 class MCPServer;
 class MCPSession;
@@ -23,6 +27,8 @@ class MCPSession;
  * 职责：
  * - 提供通用的通知发送逻辑
  * - 处理StreamableTransport和SSE传输的通知发送
+ * - SSE会话的通知汇总为一次广播，通知帧只序列化一次
+ * - 打开了事件流（GET /mcp）的Streamable会话，缓存通知后请求立即推送
  * 
  * 编码规范：
  * - 类成员添加 m_ 前缀
@@ -50,6 +56,19 @@ signals:
      * @param objNotification 通知消息
      */
     void notificationRequested(const QString& strSessionId, const QJsonObject& objNotification);
+
+    /**
+     * @brief 向多个SSE连接广播通知信号
+     * @param lstConnectionIds SSE连接ID列表
+     * @param objNotification 通知消息
+     */
+    void notificationBroadcastRequested(const QList<quint64>& lstConnectionIds, const QJsonObject& objNotification);
+
+    /**
+     * @brief 有事件流的Streamable会话缓存了新通知，请求通过事件流推送
+     * @param lstSessionIds 会话ID列表
+     */
+    void eventStreamNotificationsPending(const QStringList& lstSessionIds);
     
 protected:
     /**
@@ -63,11 +82,39 @@ protected:
      * @brief 发送通知到订阅的会话（订阅通知）
      * @param strMethod 通知方法名
      * @param objParams 通知参数
-     * @param setSubscribedSessionIds 订阅的会话ID集合
+     * @param strUri 资源URI，订阅者在资源订阅索引中原地匹配（精确/前缀/通配）
+     * @return 通知的订阅会话数
+     */
+    int sendNotificationToSubscribers(const QString& strMethod, 
+                                      const QJsonObject& objParams,
+                                      const QString& strUri);
+    
+    /**
+     * @brief 广播列表变化通知（增量）
+     * @param strMethod 通知方法名（如"notifications/tools/list_changed"）
+     * @param enType 列表类型（用于读写会话已确认的列表代数）
+     * @param deltaFun 计算增量的回调（对应服务的getListDelta）
+     * 
+     * SSE会话按各自已确认的列表代数分组，同组共享一次增量计算和一次广播，发送后更新会话代数；
+     * 会话尚未拉取过列表或其代数已不在变更日志中时，发送不带内容的通知，由客户端重新拉取列表。
+     * StreamableTransport会话只标记待发送，发送时按会话代数单独计算。
+     */
+    void broadcastListChangedNotification(const QString& strMethod,
+                                          MCPPendingNotificationType enType,
+                                          const std::function<bool(quint64, QJsonObject&)>& deltaFun);
+    
+private:
+    /**
+     * @brief 将通知分派到单个会话
+     * 
+     * StreamableTransport会话缓存通知标记（有事件流的记入lstEventStreamSessionIds），
+     * SSE会话记入lstSseConnectionIds，由调用方统一广播。
      */
-    void sendNotificationToSubscribers(const QString& strMethod, 
-                                       const QJsonObject& objParams,
-                                       const QSet<QString>& setSubscribedSessionIds);
+    void dispatchToSession(const QSharedPointer<MCPSession>& pSession,
+                           const QString& strMethod,
+                           const QJsonObject& objParams,
+                           QList<quint64>& lstSseConnectionIds,
+                           QStringList& lstEventStreamSessionIds);
     
 protected:
     MCPServer* m_pServer;  // 服务器对象，通过它获取各个服务
@@ -24,15 +24,13 @@ void MCPPromptNotificationHandler::onPromptsListChanged()
 {
     MCP_CORE_LOG_INFO() << "MCPPromptNotificationHandler: 提示词列表变化，向所有客户端发送通知";
     
-    // 获取最新的提示词列表
-    QJsonArray arrPrompts = m_pServer->getPromptService()->list();
-    
-    // 构建通知参数
-    QJsonObject params;
-    params["prompts"] = arrPrompts;
-    
-    // 广播通知
-    broadcastNotification("notifications/prompts/list_changed", params);
+    // 按各会话已确认的列表代数发送增量（而非完整提示词列表）
+    auto pPromptService = m_pServer->getPromptService();
+    broadcastListChangedNotification("notifications/prompts/list_changed", MCPPendingNotificationType::PromptsListChanged,
+                                     [pPromptService](quint64 nSinceGeneration, QJsonObject& objDelta)
+                                     {
+                                         return pPromptService->getListDelta(nSinceGeneration, objDelta);
+                                     });
     
     MCP_CORE_LOG_INFO() << "MCPPromptNotificationHandler: 提示词列表变化通知处理完成";
 }
@@ -11,10 +11,21 @@
 #include "MCPResource/MCPResourceService.h"
 #include "MCPResource/MCPResource.h"
 #include "MCPLog/MCPLog.h"
+#include "Utils/MCPResourceUpdatedParams.h"
+#include "IMCPServerConfig.h"
+#include <QDateTime>
+#include <QTimer>
+#include <QStringList>
+#include <climits>
 
 MCPResourceNotificationHandler::MCPResourceNotificationHandler(MCPServer* pServer, QObject* pParent)
     : MCPNotificationHandlerBase(pServer, pParent)
+    , m_pFlushTimer(new QTimer(this))
+    , m_nTimerDeadline(0)
+    , m_nCoalescedCount(0)
 {
+    m_pFlushTimer->setSingleShot(true);
+    QObject::connect(m_pFlushTimer, &QTimer::timeout, this, &MCPResourceNotificationHandler::onFlushTimeout);
 }
 
 MCPResourceNotificationHandler::~MCPResourceNotificationHandler()
@@ -22,40 +33,141 @@ MCPResourceNotificationHandler::~MCPResourceNotificationHandler()
 }
 
 void MCPResourceNotificationHandler::onResourceContentChanged(const QString& strUri)
+{
+    // 窗口内已有待刷新的变化，直接合并
+    if (m_dictPendingChanges.contains(strUri))
+    {
+        ++m_nCoalescedCount;
+        return;
+    }
+    
+    // 没有订阅者时不需要通知，也不需要等待
+    if (!m_pServer->getResourceService()->hasSubscribers(strUri))
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPResourceNotificationHandler: URI没有订阅者:" << strUri;
+        return;
+    }
+    
+    int nDebounceMs = getDebounceWindow(strUri);
+    if (nDebounceMs <= 0)
+    {
+        flushResourceChanged(strUri);
+        return;
+    }
+    
+    // 窗口从第一次变化开始计算，窗口结束时按最新状态读取一次
+    qint64 nDeadline = QDateTime::currentMSecsSinceEpoch() + nDebounceMs;
+    m_dictPendingChanges.insert(strUri, nDeadline);
+    m_mapDeadlines.insert(nDeadline, strUri);
+    scheduleFlushTimer();
+}
+
+void MCPResourceNotificationHandler::onFlushTimeout()
+{
+    // 截止时间有序，只取出已到期的部分
+    m_nTimerDeadline = 0;
+    qint64 nNow = QDateTime::currentMSecsSinceEpoch();
+    QStringList lstDueUris;
+    auto it = m_mapDeadlines.begin();
+    while (it != m_mapDeadlines.end() && it.key() <= nNow)
+    {
+        lstDueUris.append(it.value());
+        m_dictPendingChanges.remove(it.value());
+        it = m_mapDeadlines.erase(it);
+    }
+    // 先移出待刷新表，刷新过程中再次发生的变化会开启新的窗口
+    for (const auto& strUri : lstDueUris)
+    {
+        flushResourceChanged(strUri);
+    }
+    if (m_nCoalescedCount > 0)
+    {
+        MCP_CORE_LOG_DEBUG() << "MCPResourceNotificationHandler: 累计合并资源变化次数:" << m_nCoalescedCount;
+    }
+    scheduleFlushTimer();
+}
+
+int MCPResourceNotificationHandler::getDebounceWindow(const QString& strUri) const
+{
+    if (auto pResource = m_pServer->getResourceService()->getResource(strUri))
+    {
+        int nDebounceMs = pResource->getNotifyDebounce();
+        if (nDebounceMs >= 0)
+        {
+            return nDebounceMs;
+        }
+    }
+    return m_pServer->getConfig()->getResourceNotifyDebounce();
+}
+
+void MCPResourceNotificationHandler::scheduleFlushTimer()
+{
+    if (m_mapDeadlines.isEmpty())
+    {
+        m_pFlushTimer->stop();
+        m_nTimerDeadline = 0;
+        return;
+    }
+    
+    // 定时器已对应不晚于最早截止时间的时刻时不需要重新启动（提前触发时onFlushTimeout会重新设置）
+    qint64 nEarliest = m_mapDeadlines.firstKey();
+    if (m_pFlushTimer->isActive() && m_nTimerDeadline <= nEarliest)
+    {
+        return;
+    }
+    m_nTimerDeadline = nEarliest;
+    qint64 nDelayMs = qMax<qint64>(0, nEarliest - QDateTime::currentMSecsSinceEpoch());
+    m_pFlushTimer->start(static_cast<int>(qMin<qint64>(nDelayMs, INT_MAX)));
+}
+
+void MCPResourceNotificationHandler::removePendingChange(const QString& strUri)
+{
+    auto it = m_dictPendingChanges.find(strUri);
+    if (it == m_dictPendingChanges.end())
+    {
+        return;
+    }
+    m_mapDeadlines.remove(it.value(), strUri);
+    m_dictPendingChanges.erase(it);
+}
+
+void MCPResourceNotificationHandler::flushResourceChanged(const QString& strUri)
 {
     MCP_CORE_LOG_INFO() << "MCPResourceNotificationHandler: 资源内容变化，通知订阅者:" << strUri;
     
-    // 获取订阅该URI的所有会话ID
+    // 检查该URI是否仍有订阅者（合并窗口期间订阅关系可能已变化）
 	auto pResourceService = m_pServer->getResourceService();
-	QSet<QString> lstSubscribedSessionIds = pResourceService->getSubscribedSessionIds(strUri);
-    if (lstSubscribedSessionIds.isEmpty())
+    if (!pResourceService->hasSubscribers(strUri))
     {
         MCP_CORE_LOG_DEBUG() << "MCPResourceNotificationHandler: URI没有订阅者:" << strUri;
         return;
     }
     
-    // 读取资源内容和元数据
-    QJsonObject resourceInfo = pResourceService->readResource(strUri);
-    // 获取资源元数据（name、description、mimeType）
-    auto pResource = pResourceService->getResource(strUri);
-	QJsonObject metadata = pResource->getMetadata();
-	resourceInfo["name"] = metadata["name"];
-	resourceInfo["description"] = metadata["description"];
-	resourceInfo["mimeType"] = metadata["mimeType"];
+    if (!pResourceService->has(strUri))
+    {
+        // 窗口期间资源已被删除，删除通知由 onResourceDeleted 发送
+        return;
+    }
     
-    // 构建通知参数
-    QJsonObject params;
-    params["uri"] = strUri;
-    QJsonObject resourceData;
-    resourceData["resource"] = resourceInfo;
-    params["data"] = resourceData;
+    // 构建通知参数（内联内容时每次刷新只读取一次，所有订阅者共享）
+    QJsonObject params = buildResourceUpdatedParams(strUri);
     
     // 发送通知到订阅者
     // 根据 MCP 协议规范，资源更新通知方法名是 "notifications/resources/updated"
-    sendNotificationToSubscribers("notifications/resources/updated", params, lstSubscribedSessionIds);
+    int nSubscriberCount = sendNotificationToSubscribers("notifications/resources/updated", params, strUri);
     
     MCP_CORE_LOG_INFO() << "MCPResourceNotificationHandler: URI" << strUri 
-                       << "的内容变化通知已处理，共" << lstSubscribedSessionIds.size() << "个订阅者";
+                       << "的内容变化通知已处理，共" << nSubscriberCount << "个订阅者";
+}
+
+QJsonObject MCPResourceNotificationHandler::buildResourceUpdatedParams(const QString& strUri) const
+{
+    // 目录挂载下的文件没有资源对象，按元数据判断是否存在
+    auto pResourceService = m_pServer->getResourceService();
+    return MCPResourceUpdatedParams::build(pResourceService,
+                                           strUri,
+                                           pResourceService->getResourceMetadata(strUri),
+                                           m_pServer->getConfig()->isResourceUpdateInlineContent());
 }
 
 void MCPResourceNotificationHandler::onResourceDeleted(const QString& strUri)
@@ -67,11 +179,13 @@ void MCPResourceNotificationHandler::onResourceDeleted(const QString& strUri)
     
     auto pResourceService = m_pServer->getResourceService();
     
+    // 丢弃尚未刷新的内容变化，资源已不存在
+    removePendingChange(strUri);
+    
     MCP_CORE_LOG_INFO() << "MCPResourceNotificationHandler: 资源删除，通知订阅者:" << strUri;
     
-    // 获取订阅该URI的所有会话ID
-    QSet<QString> subscribedSessionIds = pResourceService->getSubscribedSessionIds(strUri);
-    if (subscribedSessionIds.isEmpty())
+    // 检查该URI是否有订阅者
+    if (!pResourceService->hasSubscribers(strUri))
     {
         MCP_CORE_LOG_DEBUG() << "MCPResourceNotificationHandler: URI没有订阅者:" << strUri;
         return;
@@ -86,10 +200,10 @@ void MCPResourceNotificationHandler::onResourceDeleted(const QString& strUri)
     
     // 发送通知到订阅者
     // 根据 MCP 协议规范，资源更新通知方法名是 "notifications/resources/updated"
-    sendNotificationToSubscribers("notifications/resources/updated", params, subscribedSessionIds);
+    int nSubscriberCount = sendNotificationToSubscribers("notifications/resources/updated", params, strUri);
     
     MCP_CORE_LOG_INFO() << "MCPResourceNotificationHandler: URI" << strUri 
-                       << "的删除通知已处理，共" << subscribedSessionIds.size() << "个订阅者";
+                       << "的删除通知已处理，共" << nSubscriberCount << "个订阅者";
 }
 
 void MCPResourceNotificationHandler::onResourcesListChanged()
@@ -98,15 +212,12 @@ void MCPResourceNotificationHandler::onResourcesListChanged()
     
     MCP_CORE_LOG_INFO() << "MCPResourceNotificationHandler: 资源列表变化，向所有客户端发送通知";
     
-    // 获取最新的资源列表
-    QJsonArray arrResources = pResourceService->list();
-    
-    // 构建通知参数
-    QJsonObject params;
-    params["resources"] = arrResources;
-    
-    // 广播通知
-    broadcastNotification("notifications/resources/list_changed", params);
+    // 按各会话已确认的列表代数发送增量（而非完整资源列表）
+    broadcastListChangedNotification("notifications/resources/list_changed", MCPPendingNotificationType::ResourcesListChanged,
+                                     [pResourceService](quint64 nSinceGeneration, QJsonObject& objDelta)
+                                     {
+                                         return pResourceService->getListDelta(nSinceGeneration, objDelta);
+                                     });
     
     MCP_CORE_LOG_INFO() << "MCPResourceNotificationHandler: 资源列表变化通知处理完成";
 }
@@ -8,6 +8,10 @@
 
 #pragma once
 #include "MCPNotificationHandlerBase.h"
+#include <QHash>
+#include <QMultiMap>
+
+class QTimer;
 
 /**
  * @brief MCP资源通知处理器
@@ -16,6 +20,9 @@
  * - 处理资源内容变化通知（订阅机制）
  * - 处理资源删除通知（订阅机制）
  * - 处理资源列表变化通知（广播通知）
+ * - 合并资源变化风暴：同一URI在合并窗口内的多次变化只通知一次，
+ *   窗口结束时才读取资源，每次刷新只读取一次内容
+ * - 构建 notifications/resources/updated 参数：默认只携带uri，可配置为内联资源内容
  * 
  * 编码规范：
  * - 类成员添加 m_ 前缀
@@ -36,6 +43,15 @@ public:
     
     virtual ~MCPResourceNotificationHandler();
     
+public:
+    /**
+     * @brief 构建资源更新通知参数
+     * @param strUri 资源URI
+     * @return 默认为 {"uri"}；开启内联内容时为 {"uri", "data": {"resource": 内容和元数据}}；
+     *         资源已不存在时为 {"uri", "data": {"deleted": true}}
+     */
+    QJsonObject buildResourceUpdatedParams(const QString& strUri) const;
+    
 public slots:
     /**
      * @brief 处理资源内容变化事件（订阅机制）
@@ -53,5 +69,36 @@ public slots:
      * @brief 处理资源列表变化事件（广播通知）
      */
     void onResourcesListChanged();
+
+private slots:
+    void onFlushTimeout();
+
+private:
+    /**
+     * @brief 获取URI的合并窗口（资源自身配置优先，否则使用服务器全局配置）
+     */
+    int getDebounceWindow(const QString& strUri) const;
+    
+    /**
+     * @brief 读取资源并向订阅者发送内容变化通知
+     */
+    void flushResourceChanged(const QString& strUri);
+    
+    /**
+     * @brief 按最早到期的URI设置刷新定时器（只在最早截止时间提前时重新启动）
+     */
+    void scheduleFlushTimer();
+    
+    /**
+     * @brief 移除URI的待刷新记录
+     */
+    void removePendingChange(const QString& strUri);
+
+private:
+    QHash<QString, qint64> m_dictPendingChanges;   // 等待合并的URI -> 刷新截止时间（毫秒）
+    QMultiMap<qint64, QString> m_mapDeadlines;     // 刷新截止时间 -> URI（按截止时间排序）
+    QTimer* m_pFlushTimer;
+    qint64 m_nTimerDeadline;                       // 定时器当前对应的截止时间
+    quint64 m_nCoalescedCount;                     // 被合并掉的变化次数
 };
 
@@ -58,6 +58,12 @@ MCPServer::MCPServer(QObject* pParent)
 	QObject::connect(m_pTransport, &IMCPTransport::messageReceived,
         m_pHandler, &MCPServerHandler::onClientMessageReceived);
 	
+	// 连接断开时清理会话，会话移除（断开或空闲超时）时清理其订阅
+	QObject::connect(m_pTransport, &IMCPTransport::connectionDisconnected,
+		m_pHandler, &MCPServerHandler::onConnectionClosed);
+	QObject::connect(m_pSessionService, &MCPSessionService::sessionRemoved,
+		m_pHandler, &MCPServerHandler::onSessionRemoved);
+	
 	// 连接资源服务的信号到业务处理器（MCPServerHandler内部会转发到对应的子Handler）
 	QObject::connect(m_pResourceService, &MCPResourceService::resourceContentChanged,
 		m_pHandler, &MCPServerHandler::onResourceContentChanged);
@@ -117,6 +123,14 @@ bool MCPServer::isRunning()
 	return m_pTransport->isRunning();
 }
 
+QJsonObject MCPServer::getStatistics()
+{
+	QJsonObject objStatistics;
+	objStatistics["sessions"] = m_pSessionService->getStatistics();
+	objStatistics["outbound"] = m_pTransport->getOutboundStatistics();
+	return objStatistics;
+}
+
 IMCPServerConfig* MCPServer::getConfig()
 {
     return m_pConfig;
@@ -149,6 +163,19 @@ MCPSessionService* MCPServer::getSessionService() const
 
 bool MCPServer::doStart()
 {
+	// 应用会话空闲超时（时间轮定时器属于工作线程，需在此处设置）
+	m_pSessionService->setIdleTimeout(m_pConfig->getSessionIdleTimeout());
+	m_pSessionService->setMaxPendingUris(m_pConfig->getSessionMaxPendingUris());
+	
+	// 应用文件资源内容缓存预算和流式发送阈值
+	m_pResourceService->setFileContentCacheBytes(m_pConfig->getFileContentCacheBytes());
+	m_pResourceService->setFileStreamThreshold(m_pConfig->getFileStreamThreshold());
+	
+	// 应用连接出站队列水位（慢消费者背压）
+	m_pTransport->setOutboundLimits(m_pConfig->getOutboundHighWatermark(),
+		m_pConfig->getOutboundLowWatermark(),
+		m_pConfig->getOutboundMaxQueuedBytes());
+	
 	// 启动传输层
 	auto nPort = m_pConfig->getPort();
 	if (!m_pTransport->start(nPort))
@@ -175,22 +202,37 @@ bool MCPServer::initServer(QSharedPointer<MCPToolsConfig> pToolsConfig,
 {
 	// 预先解析所有Handlers（一次性解析，避免重复遍历对象树）
 	QMap<QString, QObject*> dictHandlers = MCPHandlerResolver::resolveDefaultHandlers();
-	// 1. 应用工具配置
+	// 1. 应用工具配置（批量注册，只发送一次列表变化通知）
 	if (pToolsConfig != nullptr)
 	{
+		m_pToolService->beginUpdate();
 		for (const auto& toolConfig : pToolsConfig->getTools())
 		{
 			m_pToolService->addFromConfig(toolConfig, dictHandlers);
 		}
+		m_pToolService->endUpdate();
+	}
+	
+	// 2. 应用资源配置（目录资源只挂载，不遍历目录）
+	if (pResourcesConfig != nullptr)
+	{
+		m_pResourceService->beginUpdate();
+		for (const auto& resourceConfig : pResourcesConfig->getResources())
+		{
+			m_pResourceService->addFromConfig(resourceConfig, dictHandlers);
+		}
+		m_pResourceService->endUpdate();
 	}
 	
 	// 3. 应用提示词配置
 	if (pPromptsConfig != nullptr)
 	{
+		m_pPromptService->beginUpdate();
 		for (const auto& promptConfig : pPromptsConfig->getPrompts())
 		{
 			m_pPromptService->addFromConfig(promptConfig);
 		}
+		m_pPromptService->endUpdate();
 	}
 	return true;
 }
@@ -69,6 +69,12 @@ public:
      */
     bool isRunning() override;
 
+    /**
+     * @brief 获取运行统计
+     * @return 统计信息（JSON对象）
+     */
+    QJsonObject getStatistics() override;
+
 public:
     /**
      * @brief 获取配置对象
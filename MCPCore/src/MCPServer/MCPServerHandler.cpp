@@ -29,6 +29,7 @@
 #include "MCPToolNotificationHandler.h"
 #include "MCPPromptNotificationHandler.h"
 #include <QJsonArray>
+#include <QTimer>
 
 MCPServerHandler::MCPServerHandler(MCPServer* pServer,
                                    QObject* pParent)
@@ -39,6 +40,7 @@ MCPServerHandler::MCPServerHandler(MCPServer* pServer,
     , m_pResourceNotificationHandler(nullptr)
     , m_pToolNotificationHandler(nullptr)
     , m_pPromptNotificationHandler(nullptr)
+    , m_bEventStreamFlushScheduled(false)
 {
     // 创建消息发送器（统一处理消息发送逻辑）
     m_pMessageSender = new MCPMessageSender(pServer->getTransport(), this);
@@ -62,6 +64,22 @@ MCPServerHandler::MCPServerHandler(MCPServer* pServer,
                      this, &MCPServerHandler::onNotificationRequested);
     QObject::connect(m_pPromptNotificationHandler, &MCPNotificationHandlerBase::notificationRequested,
                      this, &MCPServerHandler::onNotificationRequested);
+    
+    // 连接各个通知处理器的SSE广播信号到本Handler
+    QObject::connect(m_pResourceNotificationHandler, &MCPNotificationHandlerBase::notificationBroadcastRequested,
+                     this, &MCPServerHandler::onNotificationBroadcastRequested);
+    QObject::connect(m_pToolNotificationHandler, &MCPNotificationHandlerBase::notificationBroadcastRequested,
+                     this, &MCPServerHandler::onNotificationBroadcastRequested);
+    QObject::connect(m_pPromptNotificationHandler, &MCPNotificationHandlerBase::notificationBroadcastRequested,
+                     this, &MCPServerHandler::onNotificationBroadcastRequested);
+    
+    // 连接各个通知处理器的事件流推送信号到本Handler
+    QObject::connect(m_pResourceNotificationHandler, &MCPNotificationHandlerBase::eventStreamNotificationsPending,
+                     this, &MCPServerHandler::onEventStreamNotificationsPending);
+    QObject::connect(m_pToolNotificationHandler, &MCPNotificationHandlerBase::eventStreamNotificationsPending,
+                     this, &MCPServerHandler::onEventStreamNotificationsPending);
+    QObject::connect(m_pPromptNotificationHandler, &MCPNotificationHandlerBase::eventStreamNotificationsPending,
+                     this, &MCPServerHandler::onEventStreamNotificationsPending);
 }
 
 MCPServerHandler::~MCPServerHandler()
@@ -72,7 +90,25 @@ void MCPServerHandler::onClientMessageReceived(quint64 nConnectionId, const QSha
 {
     if (auto pClientMessage = pMessage.dynamicCast<MCPClientMessage>())
     {
-		if (auto pSession = m_pServer->getSessionService()->getSession(nConnectionId, pClientMessage))
+		auto pSession = m_pServer->getSessionService()->getSession(nConnectionId, pClientMessage);
+		// 事件流GET没有请求ID，无法回复JSON-RPC错误，直接按HTTP状态码拒绝：
+		// 会话不存在返回404（客户端应重新初始化），会话未初始化返回400
+		if (pClientMessage->getType() & MCPMessageType::StreamableEventStream)
+		{
+			if (pSession == nullptr)
+			{
+				MCP_CORE_LOG_WARNING() << "MCPServerHandler: 事件流会话不存在:" << pClientMessage->getSessionId();
+				m_pMessageSender->sendHttpError(nConnectionId, 404);
+				return;
+			}
+			if (pSession->getSessionStatus() != EnumSessionStatus::enInitialized)
+			{
+				MCP_CORE_LOG_WARNING() << "MCPServerHandler: 事件流会话未初始化:" << pSession->getSessionId();
+				m_pMessageSender->sendHttpError(nConnectionId, 400);
+				return;
+			}
+		}
+		if (pSession != nullptr)
 		{
 			auto strMethodName = pClientMessage->getMethodName();
 			auto pContext = QSharedPointer<MCPContext>::create(nConnectionId, pSession, pClientMessage);
@@ -98,22 +134,33 @@ void MCPServerHandler::onServerMessageReceived(const QSharedPointer<MCPMessage>&
   
 		// 使用消息发送器统一发送消息
 		m_pMessageSender->sendMessage(pServerMessage);
+		
+		// 事件流刚打开：把之前缓存的通知推送出去
+		if ((enMessageType & MCPMessageType::StreamableEventStream) &&
+		    (enMessageType & MCPMessageType::Connect))
+		{
+			auto pContext = pServerMessage->getContext();
+			if (pContext != nullptr && pContext->getSession() != nullptr)
+			{
+				scheduleEventStreamFlush(pContext->getSession()->getSessionId());
+			}
+		}
     }
 }
 
 void MCPServerHandler::onConnectionClosed(quint64 nConnectionId)
 {
-    // 先获取会话，以便取消订阅
-    auto pSession = m_pServer->getSessionService()->getSessionByConnectionId(nConnectionId);
-    if (pSession)
-    {
-        QString strSessionId = pSession->getSessionId();
-        // 取消该会话的所有订阅（使用sessionId）
-        m_pServer->getResourceService()->unsubscribeAll(strSessionId);
-    }
-    
-    // 移除会话
+    // 只有SSE会话与连接绑定；Streamable会话跨多个HTTP连接，由空闲超时淘汰
+    // 订阅的清理在 sessionRemoved 信号中统一处理
     m_pServer->getSessionService()->removeSessionBySSEConnectId(nConnectionId);
+    // Streamable会话的事件流断开后，通知回退到随下一次请求的响应发送
+    m_pServer->getSessionService()->unbindEventStream(nConnectionId);
+}
+
+void MCPServerHandler::onSessionRemoved(const QString& strSessionId)
+{
+    // 取消该会话的所有订阅（使用sessionId）
+    m_pServer->getResourceService()->unsubscribeAll(strSessionId);
 }
 
 // 注意：onSseTransportServerMessageReceived 和 onStreamableTransportServerMessageReceived 
@@ -133,13 +180,31 @@ void MCPServerHandler::sendStreamableTransportPendingNotifications(const QShared
 		return;
 	}
 
+	// 根据通知对象生成并发送通知
+	for (const QJsonObject& notificationObj : takePendingNotificationObjects(pSession))
+	{
+		// 创建通知消息
+		auto pNotificationMessage = QSharedPointer<MCPServerMessage>::create(
+            pContext, notificationObj,
+			MCPMessageType::StreamableTransport | MCPMessageType::RequestNotification
+		);
+
+		// 使用消息发送器发送通知
+		m_pMessageSender->sendMessage(pNotificationMessage);
+
+		MCP_CORE_LOG_DEBUG() << "MCPServerHandler: 已发送StreamableTransport通知:" << notificationObj.value("method").toString();
+	}
+}
+
+QList<QJsonObject> MCPServerHandler::takePendingNotificationObjects(const QSharedPointer<MCPSession>& pSession)
+{
+	QList<QJsonObject> lstNotificationObjs;
 	// 检查是否有待发送的通知
-    if (!pSession->hasPendingNotifications())
-    {
-        return;
-    }
+	if (!pSession->hasPendingNotifications())
+	{
+		return lstNotificationObjs;
+	}
 
-	// 根据通知对象生成并发送通知
 	auto lstPendingNotifications = pSession->takePendingNotifications();
 	for (const MCPPendingNotification& notification : lstPendingNotifications)
 	{
@@ -148,20 +213,10 @@ void MCPServerHandler::sendStreamableTransportPendingNotifications(const QShared
 		{
 			notificationObj = generateResourceChangedNotification(notification);
 		}
-		else if (notification.isResourcesListChanged())
-		{
-			// 资源列表变化通知：通过方法名生成
-			notificationObj = generateNotificationByMethod(notification.getMethod());
-		}
-		else if (notification.isToolsListChanged())
-		{
-			// 工具列表变化通知：通过方法名生成
-			notificationObj = generateNotificationByMethod(notification.getMethod());
-		}
-		else if (notification.isPromptsListChanged())
+		else if (notification.isResourcesListChanged() || notification.isToolsListChanged() || notification.isPromptsListChanged())
 		{
-			// 提示词列表变化通知：通过方法名生成
-			notificationObj = generateNotificationByMethod(notification.getMethod());
+			// 列表变化通知：按会话已确认的代数生成增量
+			notificationObj = generateListChangedNotification(pSession, notification);
 		}
 		else
 		{
@@ -172,20 +227,62 @@ void MCPServerHandler::sendStreamableTransportPendingNotifications(const QShared
 
 		if (notificationObj.isEmpty())
 		{
-			MCP_CORE_LOG_WARNING() << "MCPServerHandler: 无法生成通知:" << notification.getMethod();
+			MCP_CORE_LOG_DEBUG() << "MCPServerHandler: 通知无需发送或无法生成:" << notification.getMethod();
 			continue;
 		}
+		lstNotificationObjs.append(notificationObj);
+	}
+	return lstNotificationObjs;
+}
 
-		// 创建通知消息
-		auto pNotificationMessage = QSharedPointer<MCPServerMessage>::create(
-            pContext, notificationObj,
-			MCPMessageType::StreamableTransport | MCPMessageType::RequestNotification
-		);
+void MCPServerHandler::onEventStreamNotificationsPending(const QStringList& lstSessionIds)
+{
+	for (const QString& strSessionId : lstSessionIds)
+	{
+		scheduleEventStreamFlush(strSessionId);
+	}
+}
 
-		// 使用消息发送器发送通知
-		m_pMessageSender->sendMessage(pNotificationMessage);
+void MCPServerHandler::scheduleEventStreamFlush(const QString& strSessionId)
+{
+	m_setEventStreamFlushSessionIds.insert(strSessionId);
+	if (!m_bEventStreamFlushScheduled)
+	{
+		// 同一轮事件循环内的多次变化合并为一次推送
+		m_bEventStreamFlushScheduled = true;
+		QTimer::singleShot(0, this, &MCPServerHandler::flushEventStreams);
+	}
+}
+
+void MCPServerHandler::flushEventStreams()
+{
+	m_bEventStreamFlushScheduled = false;
+	QSet<QString> setSessionIds;
+	setSessionIds.swap(m_setEventStreamFlushSessionIds);
 
-		MCP_CORE_LOG_DEBUG() << "MCPServerHandler: 已发送StreamableTransport通知:" << notification.getMethod();
+	auto pSessionService = m_pServer->getSessionService();
+	for (const QString& strSessionId : setSessionIds)
+	{
+		auto pSession = pSessionService->getSessionBySessionId(strSessionId);
+		if (pSession == nullptr)
+		{
+			continue;
+		}
+		// 事件流已断开：通知保留在会话中，随下一次请求的响应发送
+		quint64 nEventStreamConnectionId = pSession->getEventStreamConnectionId();
+		if (nEventStreamConnectionId == 0)
+		{
+			continue;
+		}
+		auto lstNotificationObjs = takePendingNotificationObjects(pSession);
+		for (const QJsonObject& notificationObj : lstNotificationObjs)
+		{
+			m_pMessageSender->sendEventStreamNotification(nEventStreamConnectionId, notificationObj);
+		}
+		if (!lstNotificationObjs.isEmpty())
+		{
+			MCP_CORE_LOG_DEBUG() << "MCPServerHandler: 已通过事件流推送" << lstNotificationObjs.size() << "条通知，会话:" << strSessionId;
+		}
 	}
 }
 
@@ -273,6 +370,12 @@ void MCPServerHandler::onNotificationRequested(const QString& strSessionId, cons
     onSubscriptionNotification(strSessionId, objNotification);
 }
 
+void MCPServerHandler::onNotificationBroadcastRequested(const QList<quint64>& lstConnectionIds, const QJsonObject& objNotification)
+{
+    // 通知帧只序列化一次，由传输层共享给所有目标连接
+    m_pMessageSender->broadcastSseNotification(lstConnectionIds, objNotification);
+}
+
 void MCPServerHandler::onResourceContentChanged(const QString& strUri)
 {
     // 转发到资源通知处理器
@@ -318,48 +421,52 @@ MCPPromptNotificationHandler* MCPServerHandler::getPromptNotificationHandler() c
     return m_pPromptNotificationHandler;
 }
 
-QJsonObject MCPServerHandler::generateNotificationByMethod(const QString& strMethod)
+QJsonObject MCPServerHandler::generateListChangedNotification(const QSharedPointer<MCPSession>& pSession,
+                                                              const MCPPendingNotification& notification)
 {
-    QJsonObject notification;
-    notification["method"] = strMethod;
+    MCPPendingNotificationType enType = notification.getType();
+    quint64 nSinceGeneration = pSession->getListGeneration(enType);
     
-    if (strMethod == "notifications/resources/list_changed")
-    {
-        // 资源列表变化通知：包含当前资源列表
-        QJsonArray resources = m_pServer->getResourceService()->list();
-        QJsonObject params;
-        params["resources"] = resources;
-        notification["params"] = params;
-    }
-    else if (strMethod == "notifications/tools/list_changed")
-    {
-        // 工具列表变化通知：包含当前工具列表
-        QJsonArray tools = m_pServer->getToolService()->list();
-        QJsonObject params;
-        params["tools"] = tools;
-        notification["params"] = params;
-    }
-    else if (strMethod == "notifications/prompts/list_changed")
+    QJsonObject objDelta;
+    bool bDelta = false;
+    switch (enType)
     {
-        // 提示词列表变化通知：包含当前提示词列表
-        QJsonArray prompts = m_pServer->getPromptService()->list();
-        QJsonObject params;
-        params["prompts"] = prompts;
-        notification["params"] = params;
+    case MCPPendingNotificationType::ResourcesListChanged:
+        bDelta = m_pServer->getResourceService()->getListDelta(nSinceGeneration, objDelta);
+        break;
+    case MCPPendingNotificationType::ToolsListChanged:
+        bDelta = m_pServer->getToolService()->getListDelta(nSinceGeneration, objDelta);
+        break;
+    case MCPPendingNotificationType::PromptsListChanged:
+        bDelta = m_pServer->getPromptService()->getListDelta(nSinceGeneration, objDelta);
+        break;
+    default:
+        MCP_CORE_LOG_WARNING() << "MCPServerHandler: 未知的列表通知方法:" << notification.getMethod();
+        return QJsonObject();
     }
-    else
+    
+    QJsonObject notificationObj;
+    notificationObj["method"] = notification.getMethod();
+    if (bDelta)
     {
-        // 未知的通知方法，返回空对象
-        MCP_CORE_LOG_WARNING() << "MCPServerHandler: 未知的通知方法:" << strMethod;
-        return QJsonObject();
+        // 会话已拉取到最新列表，无需通知
+        if (objDelta.value("added").toArray().isEmpty() &&
+            objDelta.value("changed").toArray().isEmpty() &&
+            objDelta.value("removed").toArray().isEmpty())
+        {
+            return QJsonObject();
+        }
+        notificationObj["params"] = objDelta;
+        pSession->setListGeneration(enType, static_cast<quint64>(objDelta.value("generation").toDouble()));
     }
+    // 否则发送不带params的list_changed，由客户端重新拉取列表（拉取时会更新会话代数）
     
-    return notification;
+    return notificationObj;
 }
 
 QJsonObject MCPServerHandler::generateResourceChangedNotification(const MCPPendingNotification& notification)
 {
-    // 资源变化通知：重新读取资源数据和元数据
+    // 资源变化通知：默认只携带uri，开启内联内容时重新读取资源数据和元数据
     QString strUri = notification.getUri();
     if (strUri.isEmpty())
     {
@@ -367,35 +474,9 @@ QJsonObject MCPServerHandler::generateResourceChangedNotification(const MCPPendi
         return QJsonObject();
     }
     
-    auto pResourceService = m_pServer->getResourceService();
-    QJsonObject resourceData;
-    
-    if (pResourceService->has(strUri))
-    {
-        // 获取资源内容（包含contents数组）
-        QJsonObject resourceInfo = pResourceService->readResource(strUri);
-        // 获取资源元数据（name、description、mimeType）
-        if (auto pResource = pResourceService->getResource(strUri))
-        {
-            QJsonObject metadata = pResource->getMetadata();
-            // 合并元数据到资源信息中
-            resourceInfo["name"] = metadata["name"];
-            resourceInfo["description"] = metadata["description"];
-            resourceInfo["mimeType"] = metadata["mimeType"];
-        }
-        resourceData["resource"] = resourceInfo;
-    }
-    else
-    {
-        resourceData["deleted"] = true;
-    }
-
     QJsonObject notificationObj;
     notificationObj["method"] = notification.getMethod();
-    QJsonObject params;
-    params["uri"] = strUri;
-    params["data"] = resourceData;
-    notificationObj["params"] = params;
+    notificationObj["params"] = m_pResourceNotificationHandler->buildResourceUpdatedParams(strUri);
     return notificationObj;
 }
 
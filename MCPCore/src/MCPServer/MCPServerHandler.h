@@ -12,6 +12,8 @@
 #include <QJsonObject>
 #include <QSharedPointer>
 #include <QSet>
+#include <QList>
+#include <QStringList>
 
 class MCPMessage;
 class MCPServerMessage;
@@ -28,6 +30,7 @@ class MCPToolNotificationHandler;
 class MCPPromptNotificationHandler;
 class MCPPendingNotification;
 class MCPMessageSender;
+class MCPSession;
 
 /**
  * @brief MCP服务器业务处理器类
@@ -86,6 +89,12 @@ public slots:
      * @param nConnectionId 连接ID
      */
     void onConnectionClosed(quint64 nConnectionId);
+
+    /**
+     * @brief 处理会话移除（连接断开或空闲超时），取消该会话的所有订阅
+     * @param strSessionId 会话ID
+     */
+    void onSessionRemoved(const QString& strSessionId);
     
     /**
      * @brief 处理订阅通知
@@ -146,6 +155,24 @@ private slots:
      * @param objNotification 通知消息
      */
     void onNotificationRequested(const QString& strSessionId, const QJsonObject& objNotification);
+
+    /**
+     * @brief 处理SSE通知广播请求（由各个通知处理器发出）
+     * @param lstConnectionIds SSE连接ID列表
+     * @param objNotification 通知消息
+     */
+    void onNotificationBroadcastRequested(const QList<quint64>& lstConnectionIds, const QJsonObject& objNotification);
+
+    /**
+     * @brief 处理事件流推送请求（由各个通知处理器发出），合并到下一轮事件循环统一推送
+     * @param lstSessionIds 有待发送通知且打开了事件流的会话ID列表
+     */
+    void onEventStreamNotificationsPending(const QStringList& lstSessionIds);
+
+    /**
+     * @brief 把待推送会话的缓存通知通过各自的事件流发送出去
+     */
+    void flushEventStreams();
     
 private:
     /**
@@ -155,13 +182,31 @@ private:
      * 注意：此方法在发送响应消息之前调用，用于发送待处理的通知
      */
     void sendStreamableTransportPendingNotifications(const QSharedPointer<MCPServerMessage>& pServerMessage);
+
+    /**
+     * @brief 取出会话缓存的通知并生成通知消息（随响应发送和事件流推送共用）
+     * @param pSession 会话
+     * @return 通知消息列表，已跳过无需发送的通知
+     */
+    QList<QJsonObject> takePendingNotificationObjects(const QSharedPointer<MCPSession>& pSession);
+
+    /**
+     * @brief 安排一次事件流推送（同一轮事件循环内的多次请求只推送一次）
+     * @param strSessionId 会话ID
+     */
+    void scheduleEventStreamFlush(const QString& strSessionId);
 private:
     /**
-     * @brief 根据通知方法名生成通知消息
-     * @param strMethod 通知方法名（如"notifications/tools/list_changed"）
-     * @return 通知消息JSON对象
+     * @brief 生成列表变化通知消息（增量）
+     * @param pSession 目标会话，用于读取和推进已确认的列表代数
+     * @param notification 列表变化通知对象（资源/工具/提示词）
+     * @return 通知消息JSON对象：
+     *         - 差距可计算时params为{generation, added, changed, removed}
+     *         - 会话代数未知或差距过大时为不带params的list_changed，客户端需重新拉取列表
+     *         - 会话已是最新代数时返回空对象（无需发送）
      */
-    QJsonObject generateNotificationByMethod(const QString& strMethod);
+    QJsonObject generateListChangedNotification(const QSharedPointer<MCPSession>& pSession,
+                                                const MCPPendingNotification& notification);
     
     /**
      * @brief 生成资源变化通知消息
@@ -183,5 +228,9 @@ private:
     MCPResourceNotificationHandler* m_pResourceNotificationHandler;
     MCPToolNotificationHandler* m_pToolNotificationHandler;
     MCPPromptNotificationHandler* m_pPromptNotificationHandler;
+    
+    // 等待通过事件流推送通知的会话
+    QSet<QString> m_setEventStreamFlushSessionIds;
+    bool m_bEventStreamFlushScheduled;
 };
 
@@ -24,15 +24,13 @@ void MCPToolNotificationHandler::onToolsListChanged()
 {
     MCP_CORE_LOG_INFO() << "MCPToolNotificationHandler: 工具列表变化，向所有客户端发送通知";
     
-    // 获取最新的工具列表
-    QJsonArray arrTools = m_pServer->getToolService()->list();
-    
-    // 构建通知参数
-    QJsonObject params;
-    params["tools"] = arrTools;
-    
-    // 广播通知
-    broadcastNotification("notifications/tools/list_changed", params);
+    // 按各会话已确认的列表代数发送增量（而非完整工具列表）
+    auto pToolService = m_pServer->getToolService();
+    broadcastListChangedNotification("notifications/tools/list_changed", MCPPendingNotificationType::ToolsListChanged,
+                                     [pToolService](quint64 nSinceGeneration, QJsonObject& objDelta)
+                                     {
+                                         return pToolService->getListDelta(nSinceGeneration, objDelta);
+                                     });
     
     MCP_CORE_LOG_INFO() << "MCPToolNotificationHandler: 工具列表变化通知处理完成";
 }
@@ -11,12 +11,43 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+
+namespace
+{
+	// 默认待发送URI上限
+	const int kDefaultMaxPendingUris = 1024;
+
+	// 列表变化通知对应的位标记，未知类型返回0
+	quint8 getListFlag(MCPPendingNotificationType enType)
+	{
+		switch (enType)
+		{
+		case MCPPendingNotificationType::ResourcesListChanged:
+			return 0x01;
+		case MCPPendingNotificationType::ToolsListChanged:
+			return 0x02;
+		case MCPPendingNotificationType::PromptsListChanged:
+			return 0x04;
+		default:
+			return 0;
+		}
+	}
+}
+
 MCPSession::MCPSession(QObject* parent)
 	: QObject(parent)
 	, m_nSseConnectId(0)
 	, m_nConnectionId(0)
+	, m_nEventStreamConnectionId(0)
 	, m_enStatus(EnumSessionStatus::enConnect)
+	, m_nLastActiveTime(QDateTime::currentMSecsSinceEpoch())
+	, m_nPendingListFlags(0)
+	, m_nMaxPendingUris(kDefaultMaxPendingUris)
+	, m_bPendingUrisCollapsed(false)
 	, m_bIsStreamableTransport(false)
+	, m_nToolsListGeneration(0)
+	, m_nResourcesListGeneration(0)
+	, m_nPromptsListGeneration(0)
 {
 	m_strSessionId = QUuid::createUuid().toString().remove('{').remove('}');
 }
@@ -68,15 +99,38 @@ EnumSessionStatus MCPSession::setStatus(EnumSessionStatus enStatus)
 
 void MCPSession::addPendingNotification(const MCPPendingNotification& notification)
 {
-	// 检查是否已存在相同的通知（避免重复）
-	for (const auto& existing : m_pendingNotifications)
+	if (!notification.isResourceChanged())
 	{
-		if (existing == notification)
-		{
-			return;  // 已存在，不重复添加
-		}
+		m_nPendingListFlags |= getListFlag(notification.getType());
+		return;
 	}
-	m_pendingNotifications.append(notification);
+
+	// 已合并为资源列表变化通知，客户端会重新拉取，无需再缓存URI
+	if (m_bPendingUrisCollapsed)
+	{
+		return;
+	}
+
+	const QString strUri = notification.getUri();
+	if (m_setPendingUris.contains(strUri))
+	{
+		return;  // 已存在，不重复添加
+	}
+
+	if (m_nMaxPendingUris > 0 && m_lstPendingUris.size() >= m_nMaxPendingUris)
+	{
+		// 超过上限：丢弃逐个URI的通知，改为发送一条不带增量的资源列表变化通知
+		m_lstPendingUris.clear();
+		m_setPendingUris.clear();
+		m_bPendingUrisCollapsed = true;
+		m_nPendingListFlags |= getListFlag(MCPPendingNotificationType::ResourcesListChanged);
+		// 代数置为未知，保证发送不带增量的list_changed（列表本身可能没有增删）
+		m_nResourcesListGeneration = 0;
+		return;
+	}
+
+	m_lstPendingUris.append(strUri);
+	m_setPendingUris.insert(strUri);
 }
 
 void MCPSession::addResourceChangedNotification(const QString& strUri)
@@ -101,14 +155,47 @@ void MCPSession::addPromptsListChangedNotification()
 
 QList<MCPPendingNotification> MCPSession::takePendingNotifications()
 {
-	QList<MCPPendingNotification> notifications = m_pendingNotifications;
-	m_pendingNotifications.clear();
+	static const MCPPendingNotificationType kListTypes[] =
+	{
+		MCPPendingNotificationType::ResourcesListChanged,
+		MCPPendingNotificationType::ToolsListChanged,
+		MCPPendingNotificationType::PromptsListChanged
+	};
+
+	QList<MCPPendingNotification> notifications;
+	notifications.reserve(3 + m_lstPendingUris.size());
+	for (auto enType : kListTypes)
+	{
+		if (m_nPendingListFlags & getListFlag(enType))
+		{
+			notifications.append(MCPPendingNotification(enType));
+		}
+	}
+	for (const QString& strUri : m_lstPendingUris)
+	{
+		notifications.append(MCPPendingNotification(MCPPendingNotificationType::ResourceChanged, strUri));
+	}
+
+	m_nPendingListFlags = 0;
+	m_lstPendingUris.clear();
+	m_setPendingUris.clear();
+	m_bPendingUrisCollapsed = false;
 	return notifications;
 }
 
 bool MCPSession::hasPendingNotifications() const
 {
-	return !m_pendingNotifications.isEmpty();
+	return m_nPendingListFlags != 0 || !m_lstPendingUris.isEmpty();
+}
+
+void MCPSession::setMaxPendingUris(int nMaxUris)
+{
+	m_nMaxPendingUris = qMax(0, nMaxUris);
+}
+
+int MCPSession::getMaxPendingUris() const
+{
+	return m_nMaxPendingUris;
 }
 
 void MCPSession::setTransportType(bool bIsStreamable)
@@ -131,3 +218,56 @@ quint64 MCPSession::getConnectionId() const
 	return m_nConnectionId;
 }
 
+void MCPSession::setEventStreamConnectionId(quint64 nConnectionId)
+{
+	m_nEventStreamConnectionId = nConnectionId;
+}
+
+quint64 MCPSession::getEventStreamConnectionId() const
+{
+	return m_nEventStreamConnectionId;
+}
+
+
+void MCPSession::touch()
+{
+	m_nLastActiveTime = QDateTime::currentMSecsSinceEpoch();
+}
+
+qint64 MCPSession::getLastActiveTime() const
+{
+	return m_nLastActiveTime;
+}
+
+void MCPSession::setListGeneration(MCPPendingNotificationType enType, quint64 nGeneration)
+{
+	switch (enType)
+	{
+	case MCPPendingNotificationType::ToolsListChanged:
+		m_nToolsListGeneration = nGeneration;
+		break;
+	case MCPPendingNotificationType::ResourcesListChanged:
+		m_nResourcesListGeneration = nGeneration;
+		break;
+	case MCPPendingNotificationType::PromptsListChanged:
+		m_nPromptsListGeneration = nGeneration;
+		break;
+	default:
+		break;
+	}
+}
+
+quint64 MCPSession::getListGeneration(MCPPendingNotificationType enType) const
+{
+	switch (enType)
+	{
+	case MCPPendingNotificationType::ToolsListChanged:
+		return m_nToolsListGeneration;
+	case MCPPendingNotificationType::ResourcesListChanged:
+		return m_nResourcesListGeneration;
+	case MCPPendingNotificationType::PromptsListChanged:
+		return m_nPromptsListGeneration;
+	default:
+		return 0;
+	}
+}
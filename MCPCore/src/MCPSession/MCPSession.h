@@ -5,6 +5,7 @@
 #include <QDateTime>
 #include <QSet>
 #include <QList>
+#include <QStringList>
 #include "MCPPendingNotification.h"
 enum class EnumSessionStatus
 {
@@ -36,6 +37,10 @@ public:
 	/**
 	 * @brief 添加待发送的通知（用于StreamableTransport）
 	 * @param notification 待发送的通知对象
+	 *
+	 * 列表变化通知按类型去重（位标记），资源变化通知按URI去重（保持插入顺序），均为O(1)。
+	 * 待发送URI数超过上限时，已缓存的URI合并为一条 resources/list_changed，
+	 * 直到下次取走通知前不再缓存新的URI。
 	 */
 	void addPendingNotification(const MCPPendingNotification& notification);
 	
@@ -71,6 +76,13 @@ public:
 	 * @return true表示有待发送的通知
 	 */
 	bool hasPendingNotifications() const;
+
+	/**
+	 * @brief 设置待发送资源变化通知的URI上限
+	 * @param nMaxUris URI上限，0表示不限制
+	 */
+	void setMaxPendingUris(int nMaxUris);
+	int getMaxPendingUris() const;
 	
 	/**
 	 * @brief 设置传输类型
@@ -95,9 +107,47 @@ public:
 	 * @return 连接ID
 	 */
 	quint64 getConnectionId() const;
+
+	/**
+	 * @brief 设置事件流连接ID（StreamableTransport通过GET /mcp打开的事件流）
+	 * @param nConnectionId 连接ID，0表示没有事件流
+	 */
+	void setEventStreamConnectionId(quint64 nConnectionId);
+
+	/**
+	 * @brief 获取事件流连接ID
+	 * @return 连接ID，0表示没有事件流，通知只能随下一次请求的响应发送
+	 */
+	quint64 getEventStreamConnectionId() const;
+
+	/**
+	 * @brief 刷新最后活跃时间（收到该会话的任意消息时调用）
+	 */
+	void touch();
+
+	/**
+	 * @brief 获取最后活跃时间
+	 * @return 自Epoch起的毫秒数
+	 */
+	qint64 getLastActiveTime() const;
+
+	/**
+	 * @brief 设置会话已确认的列表代数（客户端拉取列表或收到增量通知后更新）
+	 * @param enType 列表类型（ToolsListChanged、ResourcesListChanged、PromptsListChanged）
+	 * @param nGeneration 列表代数
+	 */
+	void setListGeneration(MCPPendingNotificationType enType, quint64 nGeneration);
+
+	/**
+	 * @brief 获取会话已确认的列表代数
+	 * @param enType 列表类型
+	 * @return 列表代数，0表示会话尚未获取过该列表
+	 */
+	quint64 getListGeneration(MCPPendingNotificationType enType) const;
 public:
 	quint64 m_nSseConnectId;
 	quint64 m_nConnectionId;  // 通用连接ID（用于StreamableTransport）
+	quint64 m_nEventStreamConnectionId;  // 事件流连接ID（StreamableTransport的GET /mcp）
 	//
 	QString m_strSessionId;
 	//
@@ -105,7 +155,14 @@ public:
 	//
 	QString m_strProtocolVersion;
 private:
-	QDateTime m_lastTime;
-	QList<MCPPendingNotification> m_pendingNotifications;  // 待发送的通知列表（用于StreamableTransport）
+	qint64 m_nLastActiveTime;                             // 最后活跃时间（毫秒），用于空闲淘汰
+	quint8 m_nPendingListFlags;                           // 待发送的列表变化通知（按类型的位标记）
+	QStringList m_lstPendingUris;                         // 待发送的资源变化URI（插入顺序）
+	QSet<QString> m_setPendingUris;                       // 待发送的资源变化URI（去重索引）
+	int m_nMaxPendingUris;                                // 待发送URI上限，超出后合并为资源列表变化通知
+	bool m_bPendingUrisCollapsed;                         // 待发送URI是否已合并为资源列表变化通知
 	bool m_bIsStreamableTransport;                        // 是否为StreamableTransport
+	quint64 m_nToolsListGeneration;                       // 已确认的工具列表代数
+	quint64 m_nResourcesListGeneration;                   // 已确认的资源列表代数
+	quint64 m_nPromptsListGeneration;                     // 已确认的提示词列表代数
 };
\ No newline at end of file
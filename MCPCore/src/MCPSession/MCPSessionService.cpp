@@ -10,28 +10,278 @@
 #include "MCPLog.h"
 #include "MCPSession.h"
 #include <QDateTime>
+#include <QTimer>
+#include <climits>
 #include "MCPClientMessage.h"
 
+namespace
+{
+    // 会话/连接索引分片数（2的幂，便于取模）
+    const int kShardCount = 16;
+    // 时间轮槽数：空闲超时被均分到各槽，一个会话最多在一圈内到期
+    const int kTimerWheelSlots = 64;
+    // 最小tick间隔，避免超时较短时定时器过于频繁
+    const qint64 kMinTickMs = 1000;
+    // 默认空闲超时：30分钟
+    const qint64 kDefaultIdleTimeoutMs = 30 * 60 * 1000;
+    // 默认每个会话待发送URI上限
+    const int kDefaultMaxPendingUris = 1024;
+}
+
 MCPSessionService::MCPSessionService(QObject* parent)
     : QObject(parent)
+    , m_nLiveSessionCount(0)
+    , m_vecTimerWheel(kTimerWheelSlots)
+    , m_nWheelCursor(0)
+    , m_nTickMs(kMinTickMs)
+    , m_nIdleTimeoutMs(0)
+    , m_nMaxPendingUris(kDefaultMaxPendingUris)
+    , m_pSweepTimer(new QTimer(this))
+    , m_nIdleEvictedCount(0)
+    , m_nDisconnectEvictedCount(0)
 {
+    for (int i = 0; i < kShardCount; ++i)
+    {
+        m_vecSessionShards.append(new SessionShard());
+        m_vecConnectionShards.append(new ConnectionShard());
+    }
+    QObject::connect(m_pSweepTimer, &QTimer::timeout, this, &MCPSessionService::onSweepTimeout);
+    setIdleTimeout(kDefaultIdleTimeoutMs);
 }
 
 MCPSessionService::~MCPSessionService()
 {
+    qDeleteAll(m_vecSessionShards);
+    qDeleteAll(m_vecConnectionShards);
+}
 
+MCPSessionService::SessionShard& MCPSessionService::getSessionShard(const QString& strSessionId) const
+{
+    return *m_vecSessionShards[qHash(strSessionId) & (kShardCount - 1)];
+}
+
+MCPSessionService::ConnectionShard& MCPSessionService::getConnectionShard(quint64 nConnectionId) const
+{
+    return *m_vecConnectionShards[qHash(nConnectionId) & (kShardCount - 1)];
 }
 
 void MCPSessionService::removeSessionBySSEConnectId(quint64 nConnectionId)
 {
+    if (nConnectionId == 0)
+    {
+        return;
+    }
+    QSharedPointer<MCPSession> pSession;
+    {
+        auto& shard = getConnectionShard(nConnectionId);
+        QReadLocker locker(&shard.lock);
+        pSession = shard.dictSseSessions.value(nConnectionId);
+    }
+    if (pSession == nullptr)
+    {
+        return;
+    }
+    if (removeSession(pSession->getSessionId()))
+    {
+        m_nDisconnectEvictedCount.fetchAndAddRelaxed(1);
+        MCP_CORE_LOG_INFO() << "MCPSessionService: SSE连接断开，移除会话:" << pSession->getSessionId();
+    }
+}
+
+void MCPSessionService::setIdleTimeout(qint64 nTimeoutMs)
+{
+    m_nIdleTimeoutMs = qMax<qint64>(0, nTimeoutMs);
+    // 按超时均分到时间轮各槽，保证 当前时间+超时 一定落在一圈之内
+    m_nTickMs = qMax(kMinTickMs, (m_nIdleTimeoutMs + kTimerWheelSlots - 2) / (kTimerWheelSlots - 1));
+    m_pSweepTimer->setInterval(static_cast<int>(qMin<qint64>(m_nTickMs, INT_MAX)));
+    rebuildTimerWheel();
+}
+
+qint64 MCPSessionService::getIdleTimeout() const
+{
+    return m_nIdleTimeoutMs;
+}
+
+void MCPSessionService::setMaxPendingUris(int nMaxUris)
+{
+    m_nMaxPendingUris = qMax(0, nMaxUris);
+}
+
+int MCPSessionService::getMaxPendingUris() const
+{
+    return m_nMaxPendingUris;
+}
+
+QJsonObject MCPSessionService::getStatistics() const
+{
+    quint64 nIdleEvicted = m_nIdleEvictedCount.load();
+    quint64 nDisconnectEvicted = m_nDisconnectEvictedCount.load();
+    QJsonObject json;
+    json["liveSessions"] = m_nLiveSessionCount.load();
+    json["evictedSessions"] = static_cast<double>(nIdleEvicted + nDisconnectEvicted);
+    json["idleEvictedSessions"] = static_cast<double>(nIdleEvicted);
+    json["disconnectEvictedSessions"] = static_cast<double>(nDisconnectEvicted);
+    json["idleTimeoutMs"] = static_cast<double>(m_nIdleTimeoutMs);
+    json["maxPendingUris"] = m_nMaxPendingUris;
+    return json;
+}
+
+void MCPSessionService::addSession(const QSharedPointer<MCPSession>& pSession)
+{
+    pSession->setMaxPendingUris(m_nMaxPendingUris);
+    {
+        auto& shard = getSessionShard(pSession->getSessionId());
+        QWriteLocker locker(&shard.lock);
+        shard.dictSessions.insert(pSession->getSessionId(), pSession);
+    }
+    if (pSession->isStreamableTransport())
+    {
+        quint64 nConnectionId = pSession->getConnectionId();
+        if (nConnectionId > 0)
+        {
+            auto& shard = getConnectionShard(nConnectionId);
+            QWriteLocker locker(&shard.lock);
+            shard.dictStreamableSessions.insert(nConnectionId, pSession);
+        }
+    }
+    else
+    {
+        quint64 nConnectionId = pSession->getSseConnectionId();
+        if (nConnectionId > 0)
+        {
+            auto& shard = getConnectionShard(nConnectionId);
+            QWriteLocker locker(&shard.lock);
+            shard.dictSseSessions.insert(nConnectionId, pSession);
+        }
+    }
+    m_nLiveSessionCount.fetchAndAddRelaxed(1);
+    scheduleSession(pSession);
+}
+
+QSharedPointer<MCPSession> MCPSessionService::removeSession(const QString& strSessionId)
+{
+    // 时间轮中残留的会话ID在扫描到时会因查不到会话而被丢弃，无需在此遍历
+    QSharedPointer<MCPSession> pSession;
+    {
+        auto& shard = getSessionShard(strSessionId);
+        QWriteLocker locker(&shard.lock);
+        pSession = shard.dictSessions.take(strSessionId);
+    }
+    if (pSession == nullptr)
+    {
+        return pSession;
+    }
+
+    // 只移除仍指向该会话的索引项，避免误删复用了连接ID的新会话
+    quint64 nSseConnectionId = pSession->getSseConnectionId();
+    if (nSseConnectionId > 0)
+    {
+        auto& shard = getConnectionShard(nSseConnectionId);
+        QWriteLocker locker(&shard.lock);
+        if (shard.dictSseSessions.value(nSseConnectionId) == pSession)
+        {
+            shard.dictSseSessions.remove(nSseConnectionId);
+        }
+    }
+    quint64 nConnectionId = pSession->getConnectionId();
+    if (nConnectionId > 0)
+    {
+        auto& shard = getConnectionShard(nConnectionId);
+        QWriteLocker locker(&shard.lock);
+        if (shard.dictStreamableSessions.value(nConnectionId) == pSession)
+        {
+            shard.dictStreamableSessions.remove(nConnectionId);
+        }
+    }
+    quint64 nEventStreamConnectionId = pSession->getEventStreamConnectionId();
+    if (nEventStreamConnectionId > 0)
+    {
+        auto& shard = getConnectionShard(nEventStreamConnectionId);
+        QWriteLocker locker(&shard.lock);
+        if (shard.dictEventStreamSessions.value(nEventStreamConnectionId) == pSession)
+        {
+            shard.dictEventStreamSessions.remove(nEventStreamConnectionId);
+        }
+    }
+
+    if (m_nLiveSessionCount.fetchAndAddRelaxed(-1) == 1)
+    {
+        m_pSweepTimer->stop();
+    }
+    emit sessionRemoved(strSessionId);
+    return pSession;
+}
+
+void MCPSessionService::scheduleSession(const QSharedPointer<MCPSession>& pSession)
+{
+    if (m_nIdleTimeoutMs <= 0)
+    {
+        return;
+    }
+    qint64 nDelayMs = pSession->getLastActiveTime() + m_nIdleTimeoutMs - QDateTime::currentMSecsSinceEpoch();
+    qint64 nTicks = (nDelayMs + m_nTickMs - 1) / m_nTickMs;
+    nTicks = qBound<qint64>(1, nTicks, kTimerWheelSlots - 1);
+    int nSlot = static_cast<int>((m_nWheelCursor + nTicks) % kTimerWheelSlots);
+    m_vecTimerWheel[nSlot].insert(pSession->getSessionId());
+    if (!m_pSweepTimer->isActive())
+    {
+        m_pSweepTimer->start();
+    }
+}
 
+void MCPSessionService::rebuildTimerWheel()
+{
+    for (auto& setSlot : m_vecTimerWheel)
+    {
+        setSlot.clear();
+    }
+    if (m_nIdleTimeoutMs <= 0)
+    {
+        m_pSweepTimer->stop();
+        return;
+    }
+    for (const auto& pSession : getAllSessions())
+    {
+        scheduleSession(pSession);
+    }
+}
+
+void MCPSessionService::onSweepTimeout()
+{
+    m_nWheelCursor = (m_nWheelCursor + 1) % kTimerWheelSlots;
+    QSet<QString> setDueSessionIds;
+    setDueSessionIds.swap(m_vecTimerWheel[m_nWheelCursor]);
+
+    qint64 nNow = QDateTime::currentMSecsSinceEpoch();
+    for (const auto& strSessionId : setDueSessionIds)
+    {
+        auto pSession = getSessionBySessionId(strSessionId);
+        if (pSession == nullptr)
+        {
+            continue;
+        }
+        // SSE会话由连接断开移除；连接存活期间只重新入槽。打开了事件流的Streamable会话同理
+        bool bSseAlive = !pSession->isStreamableTransport() && pSession->getSseConnectionId() > 0;
+        bool bEventStreamAlive = pSession->isStreamableTransport() && pSession->getEventStreamConnectionId() > 0;
+        if (!bSseAlive && !bEventStreamAlive && pSession->getLastActiveTime() + m_nIdleTimeoutMs <= nNow)
+        {
+            if (removeSession(strSessionId))
+            {
+                m_nIdleEvictedCount.fetchAndAddRelaxed(1);
+                MCP_CORE_LOG_INFO() << "MCPSessionService: 会话空闲超时，移除会话:" << strSessionId;
+            }
+            continue;
+        }
+        scheduleSession(pSession);
+    }
 }
 
 QSharedPointer<MCPSession> MCPSessionService::getSession(quint64 nConnectionId, const QSharedPointer<MCPClientMessage> pClientMessage)
 {
     auto strSessionId = pClientMessage->getSessionId();
-    if (auto pSession = m_dictSessions.value(strSessionId))
+    if (auto pSession = getSessionBySessionId(strSessionId))
     {
+        pSession->touch();
         return pSession;
     }
     if (strSessionId.isEmpty())
@@ -42,7 +292,7 @@ QSharedPointer<MCPSession> MCPSessionService::getSession(quint64 nConnectionId,
 			auto pSeesion = QSharedPointer<MCPSession>::create();
 			pSeesion->setSseConnectionId(nConnectionId);
 			pSeesion->setTransportType(false);  // SSE传输
-			m_dictSessions[pSeesion->getSessionId()] = pSeesion;
+			addSession(pSeesion);
 			return pSeesion;
 		}
 		else if ((enMsgType & MCPMessageType::StreamableTransport) && (enMsgType & MCPMessageType::Initialize))
@@ -50,7 +300,7 @@ QSharedPointer<MCPSession> MCPSessionService::getSession(quint64 nConnectionId,
 			auto pSeesion = QSharedPointer<MCPSession>::create();
 			pSeesion->setTransportType(true);  // StreamableTransport传输
 			pSeesion->setConnectionId(nConnectionId);  // 存储连接ID
-			m_dictSessions[pSeesion->getSessionId()] = pSeesion;
+			addSession(pSeesion);
 			return pSeesion;
 		}
 		else if (enMsgType & MCPMessageType::Ping)
@@ -65,43 +315,94 @@ QSharedPointer<MCPSession> MCPSessionService::getSession(quint64 nConnectionId,
 QList<quint64> MCPSessionService::getAllActiveConnectionIds() const
 {
     QList<quint64> connectionIds;
-    for (const auto& pSession : m_dictSessions.values())
+    for (auto pShard : m_vecConnectionShards)
     {
-        if (pSession && pSession->getSseConnectionId() > 0)
-        {
-            connectionIds.append(pSession->getSseConnectionId());
-        }
+        QReadLocker locker(&pShard->lock);
+        connectionIds.append(pShard->dictSseSessions.keys());
     }
     return connectionIds;
 }
 
 QSharedPointer<MCPSession> MCPSessionService::getSessionBySessionId(const QString& strSessionId) const
 {
-    return m_dictSessions.value(strSessionId);
+    if (strSessionId.isEmpty())
+    {
+        return QSharedPointer<MCPSession>();
+    }
+    auto& shard = getSessionShard(strSessionId);
+    QReadLocker locker(&shard.lock);
+    return shard.dictSessions.value(strSessionId);
 }
 
 QSharedPointer<MCPSession> MCPSessionService::getSessionByConnectionId(quint64 nConnectionId) const
 {
-    // 首先尝试通过SSE连接ID查找
-    for (const auto& pSession : m_dictSessions.values())
+    auto& shard = getConnectionShard(nConnectionId);
+    QReadLocker locker(&shard.lock);
+    // 首先尝试通过SSE连接ID查找，再检查StreamableTransport的连接ID
+    if (auto pSession = shard.dictSseSessions.value(nConnectionId))
     {
-        if (pSession)
+        return pSession;
+    }
+    return shard.dictStreamableSessions.value(nConnectionId);
+}
+
+QList<QSharedPointer<MCPSession>> MCPSessionService::getAllSessions() const
+{
+    QList<QSharedPointer<MCPSession>> lstSessions;
+    lstSessions.reserve(m_nLiveSessionCount.load());
+    for (auto pShard : m_vecSessionShards)
+    {
+        QReadLocker locker(&pShard->lock);
+        for (auto it = pShard->dictSessions.constBegin(); it != pShard->dictSessions.constEnd(); ++it)
         {
-            if (pSession->getSseConnectionId() == nConnectionId)
-            {
-                return pSession;
-            }
-            // 也检查StreamableTransport的连接ID
-            if (pSession->isStreamableTransport() && pSession->getConnectionId() == nConnectionId)
-            {
-                return pSession;
-            }
+            lstSessions.append(it.value());
         }
     }
-    return QSharedPointer<MCPSession>();
+    return lstSessions;
 }
 
-QList<QSharedPointer<MCPSession>> MCPSessionService::getAllSessions() const
+void MCPSessionService::bindEventStream(const QSharedPointer<MCPSession>& pSession, quint64 nConnectionId)
 {
-    return m_dictSessions.values();
-}
\ No newline at end of file
+    if (pSession == nullptr || nConnectionId == 0)
+    {
+        return;
+    }
+    quint64 nPrevConnectionId = pSession->getEventStreamConnectionId();
+    if (nPrevConnectionId > 0 && nPrevConnectionId != nConnectionId)
+    {
+        auto& shard = getConnectionShard(nPrevConnectionId);
+        QWriteLocker locker(&shard.lock);
+        if (shard.dictEventStreamSessions.value(nPrevConnectionId) == pSession)
+        {
+            shard.dictEventStreamSessions.remove(nPrevConnectionId);
+        }
+        MCP_CORE_LOG_INFO() << "MCPSessionService: 会话" << pSession->getSessionId() << "的事件流已被新连接替换:" << nPrevConnectionId << "->" << nConnectionId;
+    }
+    {
+        auto& shard = getConnectionShard(nConnectionId);
+        QWriteLocker locker(&shard.lock);
+        shard.dictEventStreamSessions.insert(nConnectionId, pSession);
+    }
+    pSession->setEventStreamConnectionId(nConnectionId);
+}
+
+void MCPSessionService::unbindEventStream(quint64 nConnectionId)
+{
+    if (nConnectionId == 0)
+    {
+        return;
+    }
+    QSharedPointer<MCPSession> pSession;
+    {
+        auto& shard = getConnectionShard(nConnectionId);
+        QWriteLocker locker(&shard.lock);
+        pSession = shard.dictEventStreamSessions.take(nConnectionId);
+    }
+    if (pSession != nullptr && pSession->getEventStreamConnectionId() == nConnectionId)
+    {
+        pSession->setEventStreamConnectionId(0);
+        // 事件流断开后重新按空闲时间计时，之后的通知回退到随请求响应发送
+        pSession->touch();
+        MCP_CORE_LOG_INFO() << "MCPSessionService: 会话事件流已断开:" << pSession->getSessionId();
+    }
+}
@@ -1,20 +1,33 @@
 ﻿#pragma once
 #include <QObject>
-#include <QMap>
+#include <QHash>
 #include <QList>
+#include <QSet>
+#include <QVector>
+#include <QAtomicInteger>
+#include <QReadWriteLock>
 #include <QDateTime>
 #include <QString>
+#include <QJsonObject>
 #include "MCPMessage.h"
 #include "MCPSession.h"
 #include "MCPClientMessage.h"
 
+class QTimer;
+
 /**
  * @brief MCP 会话服务
  * 
  * 职责：
  * - Session创建和验证
  * - Session状态维护
- * - 过期清理
+ * - 过期清理（SSE连接断开即移除，空闲超时由时间轮定期淘汰）
+ * - 会话数量统计
+ *
+ * 存储结构：
+ * - 会话按会话ID哈希分片，每个分片有独立的读写锁，多个分发线程查找时互不争用
+ * - SSE连接ID、Streamable连接ID、事件流连接ID到会话的二级索引按连接ID分片，与会话增删同步维护
+ * - 两类分片的锁从不嵌套持有
  */
 class MCPSessionService : public QObject
 {
@@ -24,12 +37,36 @@ public:
     explicit MCPSessionService(QObject* pParent = nullptr);
     virtual ~MCPSessionService();
 public:
+    /**
+     * @brief 移除SSE连接对应的会话（SSE连接断开时调用）
+     * @param nConnectionId SSE连接ID
+     */
     void removeSessionBySSEConnectId(quint64 nConnectionId);
+
+    /**
+     * @brief 设置会话空闲超时（需在服务线程中调用）
+     * @param nTimeoutMs 超时毫秒数，0表示不按空闲时间淘汰
+     */
+    void setIdleTimeout(qint64 nTimeoutMs);
+    qint64 getIdleTimeout() const;
+
+    /**
+     * @brief 设置新建会话的待发送URI上限（见MCPSession::setMaxPendingUris）
+     * @param nMaxUris URI上限，0表示不限制
+     */
+    void setMaxPendingUris(int nMaxUris);
+    int getMaxPendingUris() const;
+
+    /**
+     * @brief 获取会话统计（计数为原子变量，可在任意线程调用）
+     * @return {"liveSessions", "evictedSessions", "idleEvictedSessions", "disconnectEvictedSessions", "idleTimeoutMs", "maxPendingUris"}
+     */
+    QJsonObject getStatistics() const;
 public:
     QSharedPointer<MCPSession> getSession(quint64 nConnectionId, const QSharedPointer<MCPClientMessage> pClientMessage);
     
     /**
-     * @brief 获取所有活跃的连接ID
+     * @brief 获取所有活跃的SSE连接ID
      * @return 连接ID列表
      */
     QList<quint64> getAllActiveConnectionIds() const;
@@ -42,7 +79,7 @@ public:
     QSharedPointer<MCPSession> getSessionBySessionId(const QString& strSessionId) const;
     
     /**
-     * @brief 根据连接ID获取会话（用于StreamableTransport）
+     * @brief 根据连接ID获取会话（先查SSE连接索引，再查Streamable连接索引）
      * @param nConnectionId 连接ID
      * @return 会话指针，如果不存在则返回nullptr
      */
@@ -54,6 +91,66 @@ public:
      */
     QList<QSharedPointer<MCPSession>> getAllSessions() const;
 
+    /**
+     * @brief 绑定Streamable会话的事件流连接（GET /mcp）
+     * @param pSession 会话
+     * @param nConnectionId 事件流所在的连接ID
+     *
+     * 每个会话只保留最新的一条事件流，旧的事件流不再推送通知
+     */
+    void bindEventStream(const QSharedPointer<MCPSession>& pSession, quint64 nConnectionId);
+
+    /**
+     * @brief 解除事件流连接的绑定（连接断开时调用）
+     * @param nConnectionId 连接ID
+     */
+    void unbindEventStream(quint64 nConnectionId);
+
+signals:
+    /**
+     * @brief 会话被移除（连接断开或空闲超时）
+     * @param strSessionId 会话ID
+     */
+    void sessionRemoved(const QString& strSessionId);
+
+private slots:
+    void onSweepTimeout();
+
+private:
+    struct SessionShard
+    {
+        mutable QReadWriteLock lock;
+        QHash<QString, QSharedPointer<MCPSession>> dictSessions;
+    };
+
+    struct ConnectionShard
+    {
+        mutable QReadWriteLock lock;
+        QHash<quint64, QSharedPointer<MCPSession>> dictSseSessions;         // SSE连接ID -> 会话
+        QHash<quint64, QSharedPointer<MCPSession>> dictStreamableSessions;  // Streamable连接ID -> 会话
+        QHash<quint64, QSharedPointer<MCPSession>> dictEventStreamSessions; // 事件流连接ID -> 会话
+    };
+
+private:
+    SessionShard& getSessionShard(const QString& strSessionId) const;
+    ConnectionShard& getConnectionShard(quint64 nConnectionId) const;
+    void addSession(const QSharedPointer<MCPSession>& pSession);
+    QSharedPointer<MCPSession> removeSession(const QString& strSessionId);
+    void scheduleSession(const QSharedPointer<MCPSession>& pSession);
+    void rebuildTimerWheel();
+
 private:
-    QMap<QString, QSharedPointer<MCPSession>> m_dictSessions;
+    QVector<SessionShard*> m_vecSessionShards;
+    QVector<ConnectionShard*> m_vecConnectionShards;
+    QAtomicInteger<int> m_nLiveSessionCount;
+    // 空闲淘汰时间轮（只在服务线程访问）：每个槽保存到期时间落在该槽内的会话ID，
+    // 每个tick只检查当前槽，未到期的会话按最新活跃时间重新入槽
+    QVector<QSet<QString>> m_vecTimerWheel;
+    int m_nWheelCursor;
+    qint64 m_nTickMs;
+    qint64 m_nIdleTimeoutMs;
+    int m_nMaxPendingUris;
+    QTimer* m_pSweepTimer;
+    QAtomicInteger<quint64> m_nIdleEvictedCount;
+    QAtomicInteger<quint64> m_nDisconnectEvictedCount;
 };
@@ -0,0 +1,15 @@
+/**
+ * @file IMCPToolService.cpp
+ * @brief MCP工具服务接口实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "IMCPToolService.h"
+#include "MCPLog/MCPLog.h"
+
+void IMCPToolService::logTypedArgCountMismatch(const QString& strName)
+{
+    MCP_TOOLS_LOG_WARNING() << "IMCPToolService::addTyped: 参数名数量与函数签名不匹配，工具:" << strName;
+}
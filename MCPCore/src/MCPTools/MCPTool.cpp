@@ -9,12 +9,37 @@
 #include "MCPTool.h"
 #include "MCPLog/MCPLog.h"
 #include "Utils/MCPMethodHelper.h"
+#include "MCPToolResultCache.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDateTime>
 #include "nlohmann/json.hpp"
 #include "nlohmann/json-schema.hpp"
+
+namespace
+{
+	// 收集Schema校验错误，校验失败通过返回值传递而不是异常
+	class MCPSchemaErrorCollector : public nlohmann::json_schema::basic_error_handler
+	{
+	public:
+		void error(const nlohmann::json::json_pointer& ptr, const nlohmann::json& instance, const std::string& strMessage) override
+		{
+			if (m_strFirstError.isEmpty())
+			{
+				auto strPath = ptr.to_string();
+				m_strFirstError = QString::fromStdString(strPath.empty() ? strMessage : strPath + ": " + strMessage);
+			}
+			nlohmann::json_schema::basic_error_handler::error(ptr, instance, strMessage);
+		}
+		QString getFirstError() const
+		{
+			return m_strFirstError;
+		}
+	private:
+		QString m_strFirstError;
+	};
+}
 MCPTool::MCPTool(const QString& strName, QObject* pParent)
     : QObject(pParent)
     , m_strName(strName)
@@ -23,6 +48,8 @@ MCPTool::MCPTool(const QString& strName, QObject* pParent)
     , m_audience(QJsonArray())
     , m_priority(0.5)  // 默认优先级为 0.5
     , m_strLastModified("")
+    , m_bSingleFlight(false)
+    , m_bCacheConfigured(false)
 {
     m_strExecMethodName = m_strName;
 	m_strTitle = QString("Tool: %1").arg(m_strName);
@@ -110,6 +137,25 @@ MCPTool* MCPTool::withAnnotations(const QJsonObject& annotations)
         m_strLastModified = annotations["lastModified"].toString();
     }
     
+    static const char* arrHintNames[] = {"readOnlyHint", "destructiveHint", "idempotentHint", "openWorldHint"};
+    for (auto szHintName : arrHintNames)
+    {
+        if (annotations.value(szHintName).isBool())
+        {
+            m_jsonHints[szHintName] = annotations.value(szHintName).toBool();
+        }
+    }
+    
+    // 只读或幂等工具默认启用结果缓存（显式配置优先）
+    if (!m_bCacheConfigured && m_pResultCache == nullptr
+        && (m_jsonHints.value("readOnlyHint").toBool() || m_jsonHints.value("idempotentHint").toBool()))
+    {
+        MCPToolCacheConfig cacheConfig;
+        cacheConfig.bEnabled = true;
+        m_pResultCache = QSharedPointer<MCPToolResultCache>::create(cacheConfig);
+        MCP_TOOLS_LOG_INFO() << "MCPTool: 根据注解启用结果缓存:" << m_strName;
+    }
+    
     return this;
 }
 
@@ -132,6 +178,11 @@ QJsonObject MCPTool::getAnnotations() const
         annotations["lastModified"] = m_strLastModified;
     }
     
+    for (auto it = m_jsonHints.constBegin(); it != m_jsonHints.constEnd(); ++it)
+    {
+        annotations[it.key()] = it.value();
+    }
+    
     return annotations;
 }
 
@@ -173,6 +224,31 @@ MCPTool* MCPTool::updateLastModified()
     return this;
 }
 
+MCPTool* MCPTool::withCache(const MCPToolCacheConfig& cacheConfig)
+{
+    m_bCacheConfigured = true;
+    m_pResultCache = cacheConfig.bEnabled
+        ? QSharedPointer<MCPToolResultCache>::create(cacheConfig)
+        : QSharedPointer<MCPToolResultCache>();
+    return this;
+}
+
+QJsonObject MCPTool::getCacheStatistics() const
+{
+    return (m_pResultCache != nullptr) ? m_pResultCache->getStatistics() : QJsonObject();
+}
+
+MCPTool* MCPTool::withSingleFlight(bool bSingleFlight)
+{
+    m_bSingleFlight = bSingleFlight;
+    return this;
+}
+
+bool MCPTool::isSingleFlight() const
+{
+    return m_bSingleFlight;
+}
+
 void MCPTool::onHandlerDestroyed()
 {
 	MCP_TOOLS_LOG_WARNING() << "MCPTool: Handler已销毁，工具将被注销:" << m_strName;
@@ -185,6 +261,12 @@ MCPTool* MCPTool::withExecHandler(QObject* pExecHandler, const QString& strMetho
     {
 		initSchemaValidator();
 		m_strExecMethodName = strMethodName.isEmpty() ? m_strExecMethodName : strMethodName;
+		// 一次性解析方法及参数转换计划，避免每次调用时重新查找
+		m_pExecPlan = MCPMethodInvokePlan::create(pExecHandler, m_strExecMethodName);
+		if (m_pExecPlan == nullptr)
+		{
+			MCP_TOOLS_LOG_WARNING() << "MCPTool: 无法预编译调用计划，将回退到反射调用:" << m_strName << m_strExecMethodName;
+		}
 		// 监听Handler的销毁信号，当Handler被销毁时通知ToolService
 		QObject::connect(pExecHandler, &QObject::destroyed, this, &MCPTool::onHandlerDestroyed);
     }
@@ -192,7 +274,7 @@ MCPTool* MCPTool::withExecHandler(QObject* pExecHandler, const QString& strMetho
     return this;
 }
 
-MCPTool* MCPTool::withExecFun(std::function<QJsonObject()> execFun)
+MCPTool* MCPTool::withExecFun(std::function<QJsonObject(const QJsonObject&)> execFun)
 {
     m_execFun = execFun;
 	initSchemaValidator();
@@ -222,22 +304,20 @@ void MCPTool::initSchemaValidator()
 	_initValidator(this, m_jsonOutputSchema, "OutputValidator");
 }
 
-bool MCPTool::validateInput(const QJsonObject& inputObject)
+bool MCPTool::validateInput(const QJsonObject& inputObject, QString& strError)
 {
 	if (auto pValidator = (nlohmann::json_schema::json_validator*)property("InputValidator").value<void*>())
 	{
-		try
-		{
-			auto json = pValidator->validate(nlohmann::json::parse(QJsonDocument(inputObject).toJson().constData()));
-			return true;
-		}
-		catch (const std::exception& e)
+		auto jsonInput = nlohmann::json::parse(QJsonDocument(inputObject).toJson().constData(), nullptr, false);
+		MCPSchemaErrorCollector errorCollector;
+		pValidator->validate(jsonInput, errorCollector);
+		if (errorCollector)
 		{
-			MCP_TOOLS_LOG_WARNING() << "输入验证失败: " << e.what();
+			strError = errorCollector.getFirstError();
 			return false;
 		}
 	}
-	return false;
+	return true;
 }
 
 
@@ -260,14 +340,12 @@ bool MCPTool::validateOutput(const QJsonObject& outputObject)
 	}
 	if (auto pValidator = (nlohmann::json_schema::json_validator*)property("OutputValidator").value<void*>())
 	{
-		try
+		auto jsonOutput = nlohmann::json::parse(QJsonDocument(outputObject.value("structuredContent").toObject()).toJson().constData(), nullptr, false);
+		MCPSchemaErrorCollector errorCollector;
+		pValidator->validate(jsonOutput, errorCollector);
+		if (errorCollector)
 		{
-			pValidator->validate(nlohmann::json::parse(QJsonDocument(outputObject.value("structuredContent").toObject()).toJson().constData()));
-			return true;
-		}
-		catch (const std::exception& e)
-		{
-			MCP_TOOLS_LOG_WARNING() << "输出验证失败: " << e.what();
+			MCP_TOOLS_LOG_WARNING() << "输出验证失败: " << errorCollector.getFirstError();
 			return false;
 		}
 	}
@@ -280,17 +358,84 @@ QString MCPTool::getName() const
 }
 
 
-QJsonObject MCPTool::execute(const QJsonObject& jsonCallArguments)
+bool MCPTool::isCacheableResult(const QJsonObject& jsonResult)
+{
+	return !jsonResult.isEmpty()
+		&& !jsonResult.contains("error")
+		&& !jsonResult.value("isError").toBool();
+}
+
+MCPResult<QJsonObject> MCPTool::execute(const QJsonObject& jsonCallArguments)
 {
- 	validateInput(jsonCallArguments);
-	QJsonObject jsonObject =
-		(m_pExecHandler != nullptr)
-		? MCPMethodHelper::syncCallMethod(m_pExecHandler, m_strExecMethodName, jsonCallArguments.toVariantMap()).toJsonObject()
-		: (m_execFun != nullptr) ? m_execFun()
-		: QJsonObject();
+	QByteArray cacheKey;
+	if (m_pResultCache != nullptr)
+	{
+		cacheKey = MCPToolResultCache::canonicalKey(jsonCallArguments);
+		QJsonObject jsonCached;
+		if (m_pResultCache->lookup(cacheKey, jsonCached))
+		{
+			return jsonCached;
+		}
+	}
+	QString strValidateError;
+	if (!validateInput(jsonCallArguments, strValidateError))
+	{
+		MCP_TOOLS_LOG_WARNING() << "输入验证失败:" << m_strName << strValidateError;
+		return MCPError::invalidParams(strValidateError);
+	}
+	auto result = invokeHandler(jsonCallArguments);
+	if (!result)
+	{
+		return result;
+	}
+	const QJsonObject& jsonObject = result.value();
+	// 处理器以 {"error": {code, message, data}} 形式报告错误
+	if (jsonObject.value("error").isObject())
+	{
+		return MCPError::fromJson(jsonObject.value("error").toObject());
+	}
 	validateOutput(jsonObject);
 	//
-	return jsonObject;
+	if (m_pResultCache != nullptr && isCacheableResult(jsonObject))
+	{
+		m_pResultCache->insert(cacheKey, jsonObject);
+	}
+	return result;
+}
+
+MCPResult<QJsonObject> MCPTool::invokeHandler(const QJsonObject& jsonCallArguments)
+{
+	// 处理器是外部代码，其抛出的异常属于处理器缺陷，在此边界统一转换为错误结果
+	try
+	{
+		if (m_pExecHandler != nullptr)
+		{
+			QVariant retValue = (m_pExecPlan != nullptr)
+				? m_pExecPlan->syncInvoke(m_pExecHandler, jsonCallArguments)
+				: MCPMethodHelper::syncCallMethod(m_pExecHandler, m_strExecMethodName, jsonCallArguments.toVariantMap());
+			if (!retValue.isValid())
+			{
+				// 根据 MCP 协议规范，错误消息应该是英文
+				return MCPError::toolExecutionFailed(QString("Failed to invoke handler of tool: %1").arg(m_strName));
+			}
+			return retValue.toJsonObject();
+		}
+		if (m_execFun != nullptr)
+		{
+			return m_execFun(jsonCallArguments);
+		}
+		return MCPError::toolExecutionFailed(QString("No handler bound to tool: %1").arg(m_strName));
+	}
+	catch (const std::exception& e)
+	{
+		MCP_TOOLS_LOG_CRITICAL() << "MCPTool: 工具执行异常 - " << m_strName << ":" << e.what();
+		return MCPError::toolExecutionFailed(QString::fromUtf8(e.what()));
+	}
+	catch (...)
+	{
+		MCP_TOOLS_LOG_CRITICAL() << "MCPTool: 工具执行时发生未知异常 - " << m_strName;
+		return MCPError::toolExecutionFailed("Unknown error");
+	}
 }
 
 
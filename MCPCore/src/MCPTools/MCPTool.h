@@ -12,7 +12,13 @@
 #include <QString>
 #include <QJsonArray>
 #include <QDateTime>
+#include <QSharedPointer>
 #include <functional>
+#include "MCPError/MCPResult.h"
+
+class MCPMethodInvokePlan;
+class MCPToolResultCache;
+struct MCPToolCacheConfig;
 
 /**
  * @brief MCP工具类
@@ -53,6 +59,9 @@ public:
      * - audience: 数组，有效值为 "user" 和 "assistant"
      * - priority: 0.0 到 1.0 的数字，表示重要性
      * - lastModified: ISO 8601 格式的时间戳
+     * - readOnlyHint/destructiveHint/idempotentHint/openWorldHint: 行为提示
+     * 
+     * readOnlyHint 或 idempotentHint 为 true 且未显式配置缓存时，自动启用默认结果缓存。
      */
     MCPTool* withAnnotations(const QJsonObject& annotations);
     
@@ -84,10 +93,36 @@ public:
      * @brief 更新最后修改时间为当前时间
      */
     MCPTool* updateLastModified();
+    
+    /**
+     * @brief 配置结果缓存
+     * @param cacheConfig 缓存配置，bEnabled 为 false 时关闭缓存
+     * 
+     * 显式配置后，annotations 中的 readOnlyHint/idempotentHint 不再影响缓存开关。
+     */
+    MCPTool* withCache(const MCPToolCacheConfig& cacheConfig);
+    
+    /**
+     * @brief 获取结果缓存统计
+     * @return 统计对象，未启用缓存时返回空对象
+     */
+    QJsonObject getCacheStatistics() const;
+    
+    /**
+     * @brief 设置是否合并并发的相同调用（single-flight）
+     * @param bSingleFlight true表示相同参数的并发调用只执行一次
+     */
+    MCPTool* withSingleFlight(bool bSingleFlight);
+    bool isSingleFlight() const;
 
 public:
     QString getName() const;
-    QJsonObject execute(const QJsonObject& jsonCallArguments);
+    /**
+     * @brief 执行工具
+     * @param jsonCallArguments 调用参数
+     * @return 调用结果；输入校验失败、处理器调用失败或处理器返回 {"error": {...}} 时返回错误（不抛出异常）
+     */
+    MCPResult<QJsonObject> execute(const QJsonObject& jsonCallArguments);
     QJsonObject getSchema() const;
     QString toString() const;
     
@@ -104,12 +139,14 @@ private slots:
 	void onHandlerDestroyed();
 private:
 	MCPTool* withExecHandler(QObject* pExecHandler, const QString& strMethodName = QString());
-	MCPTool* withExecFun(std::function<QJsonObject()> execFun);
+	MCPTool* withExecFun(std::function<QJsonObject(const QJsonObject&)> execFun);
 	
 private:
 	void initSchemaValidator();
-	bool validateInput(const QJsonObject& inputObject);
+	bool validateInput(const QJsonObject& inputObject, QString& strError);
 	bool validateOutput(const QJsonObject& outputObject);
+	static bool isCacheableResult(const QJsonObject& jsonResult);
+	MCPResult<QJsonObject> invokeHandler(const QJsonObject& jsonCallArguments);
 	
 private:
 	QString m_strName;
@@ -122,10 +159,16 @@ private:
 	QJsonArray m_audience;        // 目标受众数组，有效值为 "user" 和 "assistant"
 	double m_priority;             // 优先级，范围 0.0 到 1.0
 	QString m_strLastModified;     // 最后修改时间，ISO 8601 格式
+	QJsonObject m_jsonHints;       // 行为提示（readOnlyHint、idempotentHint 等）
+	
+	bool m_bSingleFlight;                               // 是否合并并发的相同调用
+	bool m_bCacheConfigured;                            // 是否显式配置过缓存
+	QSharedPointer<MCPToolResultCache> m_pResultCache;  // 结果缓存（为空表示未启用）
 	
 	QObject* m_pExecHandler;
 	QString m_strExecMethodName;
-	std::function<QJsonObject()> m_execFun;
+	QSharedPointer<MCPMethodInvokePlan> m_pExecPlan;  // 预编译的调用计划（绑定Handler时解析一次）
+	std::function<QJsonObject(const QJsonObject&)> m_execFun;
 	
 private:
 	friend class MCPToolService;
@@ -0,0 +1,110 @@
+/**
+ * @file MCPToolResultCache.cpp
+ * @brief MCP工具结果缓存实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPToolResultCache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QMutexLocker>
+
+// ============================================================================
+// MCPToolCacheConfig 实现
+// ============================================================================
+
+QJsonObject MCPToolCacheConfig::toJson() const
+{
+    QJsonObject json;
+    json["enabled"] = bEnabled;
+    json["ttlMs"] = static_cast<double>(nTtlMs);
+    json["maxBytes"] = nMaxBytes;
+    return json;
+}
+
+MCPToolCacheConfig MCPToolCacheConfig::fromJson(const QJsonObject& json)
+{
+    MCPToolCacheConfig config;
+    config.bEnabled = json.value("enabled").toBool(true);
+    config.nTtlMs = static_cast<qint64>(json.value("ttlMs").toDouble(static_cast<double>(config.nTtlMs)));
+    config.nMaxBytes = json.value("maxBytes").toInt(config.nMaxBytes);
+    return config;
+}
+
+// ============================================================================
+// MCPToolResultCache 实现
+// ============================================================================
+
+MCPToolResultCache::MCPToolResultCache(const MCPToolCacheConfig& cacheConfig)
+    : m_cache(cacheConfig.nMaxBytes)
+    , m_nTtlMs(cacheConfig.nTtlMs)
+    , m_nHits(0)
+    , m_nMisses(0)
+{
+}
+
+MCPToolResultCache::~MCPToolResultCache()
+{
+}
+
+QByteArray MCPToolResultCache::canonicalKey(const QJsonObject& jsonArguments)
+{
+    // QJsonObject 的键本身有序，紧凑序列化即为规范化形式
+    auto canonicalData = QJsonDocument(jsonArguments).toJson(QJsonDocument::Compact);
+    return QCryptographicHash::hash(canonicalData, QCryptographicHash::Sha1);
+}
+
+bool MCPToolResultCache::lookup(const QByteArray& key, QJsonObject& jsonResult)
+{
+    QMutexLocker locker(&m_mutex);
+    CacheEntry* pEntry = m_cache.object(key);
+    if (pEntry == nullptr)
+    {
+        ++m_nMisses;
+        return false;
+    }
+    if (pEntry->nExpireAt <= QDateTime::currentMSecsSinceEpoch())
+    {
+        m_cache.remove(key);
+        ++m_nMisses;
+        return false;
+    }
+    jsonResult = pEntry->jsonResult;
+    ++m_nHits;
+    return true;
+}
+
+void MCPToolResultCache::insert(const QByteArray& key, const QJsonObject& jsonResult)
+{
+    // 以序列化后的大小估算占用字节数
+    int nCost = QJsonDocument(jsonResult).toJson(QJsonDocument::Compact).size() + key.size();
+
+    QMutexLocker locker(&m_mutex);
+    CacheEntry* pEntry = new CacheEntry();
+    pEntry->jsonResult = jsonResult;
+    pEntry->nExpireAt = QDateTime::currentMSecsSinceEpoch() + m_nTtlMs;
+    // 单条结果超过容量时 QCache 会直接删除该对象并返回false
+    m_cache.insert(key, pEntry, nCost);
+}
+
+void MCPToolResultCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.clear();
+}
+
+QJsonObject MCPToolResultCache::getStatistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    QJsonObject json;
+    json["hits"] = static_cast<double>(m_nHits);
+    json["misses"] = static_cast<double>(m_nMisses);
+    json["entries"] = m_cache.count();
+    json["bytes"] = m_cache.totalCost();
+    json["maxBytes"] = m_cache.maxCost();
+    json["ttlMs"] = static_cast<double>(m_nTtlMs);
+    return json;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file MCPToolResultCache.h
+ * @brief MCP工具结果缓存（内部实现）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QByteArray>
+#include <QCache>
+#include <QJsonObject>
+#include <QMutex>
+
+/**
+ * @brief 工具结果缓存配置
+ *
+ * JSON格式（工具配置中的 "cache" 字段）：
+ * {
+ *   "enabled": true,        // 是否启用，默认true
+ *   "ttlMs": 30000,         // 缓存有效期（毫秒）
+ *   "maxBytes": 4194304     // 单个工具缓存的最大字节数
+ * }
+ */
+struct MCPToolCacheConfig
+{
+    bool bEnabled;
+    qint64 nTtlMs;
+    int nMaxBytes;
+
+    MCPToolCacheConfig()
+        : bEnabled(false)
+        , nTtlMs(30000)
+        , nMaxBytes(4 * 1024 * 1024)
+    {
+    }
+
+    QJsonObject toJson() const;
+    static MCPToolCacheConfig fromJson(const QJsonObject& json);
+};
+
+/**
+ * @brief MCP工具结果缓存
+ *
+ * 职责：
+ * - 按参数的规范化哈希缓存只读/幂等工具的调用结果
+ * - 支持TTL过期和按字节数的LRU淘汰
+ * - 统计命中/未命中次数
+ * - 线程安全（工具调用在线程池中并发执行）
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 数值类型添加 n 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPToolResultCache
+{
+public:
+    explicit MCPToolResultCache(const MCPToolCacheConfig& cacheConfig);
+    ~MCPToolResultCache();
+
+public:
+    /**
+     * @brief 计算参数的规范化键
+     * @param jsonArguments 调用参数
+     * @return 参数规范化JSON（键有序、紧凑格式）的SHA-1摘要
+     */
+    static QByteArray canonicalKey(const QJsonObject& jsonArguments);
+
+public:
+    /**
+     * @brief 查找缓存结果
+     * @param key 参数键（canonicalKey的返回值）
+     * @param jsonResult 输出的缓存结果
+     * @return true表示命中且未过期
+     */
+    bool lookup(const QByteArray& key, QJsonObject& jsonResult);
+
+    /**
+     * @brief 写入缓存结果（超过容量时按LRU淘汰）
+     * @param key 参数键
+     * @param jsonResult 调用结果
+     */
+    void insert(const QByteArray& key, const QJsonObject& jsonResult);
+
+    /**
+     * @brief 清空缓存（统计计数保留）
+     */
+    void clear();
+
+    /**
+     * @brief 获取缓存统计
+     * @return {"hits", "misses", "entries", "bytes", "maxBytes", "ttlMs"}
+     */
+    QJsonObject getStatistics() const;
+
+private:
+    struct CacheEntry
+    {
+        QJsonObject jsonResult;
+        qint64 nExpireAt;
+    };
+
+private:
+    mutable QMutex m_mutex;
+    QCache<QByteArray, CacheEntry> m_cache;   // 以字节数作为cost，自动LRU淘汰
+    qint64 m_nTtlMs;
+    quint64 m_nHits;
+    quint64 m_nMisses;
+};
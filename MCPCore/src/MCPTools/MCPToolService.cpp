@@ -9,6 +9,7 @@
 #include "MCPToolService.h"
 #include "MCPLog/MCPLog.h"
 #include "MCPTool.h"
+#include "MCPToolResultCache.h"
 #include "Utils/MCPMethodHelper.h"
 #include "MCPError/MCPError.h"
 #include "Utils/MCPInvokeHelper.h"
@@ -17,6 +18,8 @@
 
 MCPToolService::MCPToolService(QObject* pParent)
     : IMCPToolService(pParent)
+    , m_nUpdateDepth(0)
+    , m_bListChangedPending(false)
 {
 
 }
@@ -45,6 +48,26 @@ bool MCPToolService::add(const QString& strName,
                           const QJsonObject& jsonInputSchema,
                           const QJsonObject& jsonOutputSchema,
                           std::function<QJsonObject()> execFun)
+{
+    if (execFun == nullptr)
+    {
+        MCP_TOOLS_LOG_WARNING() << "执行函数为空，工具:" << strName;
+        return false;
+    }
+    // 无参函数适配为带参数的执行函数
+    std::function<QJsonObject(const QJsonObject&)> execArgsFun = [execFun](const QJsonObject&) -> QJsonObject
+    {
+        return execFun();
+    };
+    return addWithArgs(strName, strTitle, strDescription, jsonInputSchema, jsonOutputSchema, execArgsFun);
+}
+
+bool MCPToolService::addWithArgs(const QString& strName,
+                                 const QString& strTitle,
+                                 const QString& strDescription,
+                                 const QJsonObject& jsonInputSchema,
+                                 const QJsonObject& jsonOutputSchema,
+                                 std::function<QJsonObject(const QJsonObject&)> execFun)
 {
     return MCPInvokeHelper::syncInvokeReturn(this, [this, strName, strTitle, strDescription, jsonInputSchema, jsonOutputSchema, execFun]()
     {
@@ -68,6 +91,71 @@ QJsonArray MCPToolService::list() const
         });
 }
 
+QJsonArray MCPToolService::listPage(const QString& strAfterName, int nPageSize, QString& strLastName) const
+{
+    return MCPInvokeHelper::syncInvokeReturnT<QJsonArray>(const_cast<MCPToolService*>(this), [this, strAfterName, nPageSize, &strLastName]()->QJsonArray
+        {
+            return doListPageImpl(strAfterName, nPageSize, strLastName);
+        });
+}
+
+void MCPToolService::batchUpdate(const std::function<void()>& fun)
+{
+    MCPInvokeHelper::syncInvoke(this, [this, &fun]()
+        {
+            beginUpdate();
+            fun();
+            endUpdate();
+        });
+}
+
+void MCPToolService::beginUpdate()
+{
+    ++m_nUpdateDepth;
+}
+
+void MCPToolService::endUpdate()
+{
+    if (m_nUpdateDepth <= 0 || --m_nUpdateDepth > 0)
+    {
+        return;
+    }
+    if (m_bListChangedPending)
+    {
+        m_bListChangedPending = false;
+        emit toolsListChanged();
+    }
+}
+
+void MCPToolService::notifyListChanged()
+{
+    if (m_nUpdateDepth > 0)
+    {
+        m_bListChangedPending = true;
+        return;
+    }
+    emit toolsListChanged();
+}
+
+quint64 MCPToolService::getListGeneration() const
+{
+    return m_listChangeLog.getGeneration();
+}
+
+bool MCPToolService::getListDelta(quint64 nSinceGeneration, QJsonObject& objDelta) const
+{
+    bool bSuccess = false;
+    MCPInvokeHelper::syncInvoke(const_cast<MCPToolService*>(this), [this, nSinceGeneration, &objDelta, &bSuccess]()
+        {
+            bSuccess = m_listChangeLog.buildDelta(nSinceGeneration, [this](const QString& strName) -> QJsonObject
+                {
+                    MCPTool* pTool = getTool(strName);
+                    return pTool != nullptr ? pTool->getSchema() : QJsonObject();
+                }, objDelta);
+        });
+    return bSuccess;
+}
+
 bool MCPToolService::addFromJson(const QJsonObject& jsonTool, QObject* pSearchRoot)
 {
     return MCPInvokeHelper::syncInvokeReturn(this, [this, jsonTool, pSearchRoot]() -> bool
@@ -78,12 +166,29 @@ bool MCPToolService::addFromJson(const QJsonObject& jsonTool, QObject* pSearchRo
     });
 }
 
+QJsonObject MCPToolService::getCacheStatistics() const
+{
+    return MCPInvokeHelper::syncInvokeReturnT<QJsonObject>(const_cast<MCPToolService*>(this), [this]()->QJsonObject
+        {
+            QJsonObject jsonStatistics;
+            for (auto it = m_dictTools.constBegin(); it != m_dictTools.constEnd(); ++it)
+            {
+                auto jsonToolStatistics = it.value()->getCacheStatistics();
+                if (!jsonToolStatistics.isEmpty())
+                {
+                    jsonStatistics[it.key()] = jsonToolStatistics;
+                }
+            }
+            return jsonStatistics;
+        });
+}
+
 QJsonObject MCPToolService::call(const QString& strMethodName, const QJsonObject& jsonCallArguments)
 {
 	return MCPInvokeHelper::syncInvokeReturnT<QJsonObject>(this, [this, strMethodName, jsonCallArguments]() -> QJsonObject
 		{
-			// 将JSON对象转换为MCPToolConfig
-            return callTool(strMethodName, jsonCallArguments);
+            auto result = callTool(strMethodName, jsonCallArguments);
+            return result ? result.value() : QJsonObject{ {"error", result.error().toJson()} };
 		});
 }
 
@@ -109,6 +214,17 @@ bool MCPToolService::addFromConfig(const MCPToolConfig& toolConfig, const QMap<Q
         pTool->withAnnotations(toolConfig.annotations);
     }
     
+    if (pTool != nullptr && toolConfig.bSingleFlight)
+    {
+        pTool->withSingleFlight(true);
+    }
+    
+    // 如果配置中包含 cache，显式配置结果缓存（优先于注解推断）
+    if (pTool != nullptr && !toolConfig.jsonCache.isEmpty())
+    {
+        pTool->withCache(MCPToolCacheConfig::fromJson(toolConfig.jsonCache));
+    }
+    
     return pTool != nullptr;
 }
 
@@ -149,7 +265,7 @@ MCPTool* MCPToolService::doAddImpl(const QString& strName,
                                    const QString& strDescription,
                                    const QJsonObject& jsonInputSchema,
                                    const QJsonObject& jsonOutputSchema,
-                                   std::function<QJsonObject()> execFun)
+                                   std::function<QJsonObject(const QJsonObject&)> execFun)
 {
     if (execFun == nullptr)
     {
@@ -192,7 +308,8 @@ bool MCPToolService::doRemoveImpl(const QString& strName, bool bEmitSignal)
     MCP_TOOLS_LOG_INFO() << "工具已注销:" << strName;
     if (bEmitSignal)
     {
-        emit toolsListChanged();
+        m_listChangeLog.record(strName, MCPListChangeLog::ChangeType::Removed);
+        notifyListChanged();
     }
     return true;
 }
@@ -209,10 +326,33 @@ QJsonArray MCPToolService::doListImpl() const
     return toolsArray;
 }
 
+QJsonArray MCPToolService::doListPageImpl(const QString& strAfterName, int nPageSize, QString& strLastName) const
+{
+    QJsonArray toolsArray;
+    strLastName.clear();
+    QString strKey;
+
+    // m_dictTools按名称有序，从上一页最后一个名称之后继续
+    auto it = strAfterName.isEmpty() ? m_dictTools.constBegin() : m_dictTools.upperBound(strAfterName);
+    for (; it != m_dictTools.constEnd(); ++it)
+    {
+        if (nPageSize > 0 && toolsArray.size() >= nPageSize)
+        {
+            strLastName = strKey;
+            break;
+        }
+        toolsArray.append(it.value()->getSchema());
+        strKey = it.key();
+    }
+
+    return toolsArray;
+}
+
 bool MCPToolService::registerTool(MCPTool* pTool, QObject* pExecHandler, const QString& strMethodName)
 {
 	// 如果已存在，先删除旧的（覆盖），不发送信号，因为后面注册新对象时会发送
-	if (m_dictTools.contains(pTool->getName()))
+	bool bReplaced = m_dictTools.contains(pTool->getName());
+	if (bReplaced)
 	{
 		MCP_TOOLS_LOG_INFO() << "工具已存在，覆盖旧工具:" << pTool->getName();
 		doRemoveImpl(pTool->getName(), false);
@@ -225,14 +365,16 @@ bool MCPToolService::registerTool(MCPTool* pTool, QObject* pExecHandler, const Q
 	QObject::connect(pTool, &MCPTool::handlerDestroyed, this, &MCPToolService::onHandlerDestroyed);    
 	m_dictTools.insert(pTool->getName(), pTool);
 	MCP_TOOLS_LOG_INFO() << "工具已注册:" << pTool->getName();
-	emit toolsListChanged();
+	m_listChangeLog.record(pTool->getName(), bReplaced ? MCPListChangeLog::ChangeType::Changed : MCPListChangeLog::ChangeType::Added);
+	notifyListChanged();
     return true;
 }
 
-bool MCPToolService::registerTool(MCPTool* pTool, std::function<QJsonObject()> execFun)
+bool MCPToolService::registerTool(MCPTool* pTool, std::function<QJsonObject(const QJsonObject&)> execFun)
 {
 	// 如果已存在，先删除旧的（覆盖），不发送信号，因为后面注册新对象时会发送
-	if (m_dictTools.contains(pTool->getName()))
+	bool bReplaced = m_dictTools.contains(pTool->getName());
+	if (bReplaced)
 	{
 		MCP_TOOLS_LOG_INFO() << "工具已存在，覆盖旧工具:" << pTool->getName();
 		doRemoveImpl(pTool->getName(), false);
@@ -242,21 +384,24 @@ bool MCPToolService::registerTool(MCPTool* pTool, std::function<QJsonObject()> e
 	//
 	m_dictTools.insert(pTool->getName(), pTool);
 	MCP_TOOLS_LOG_INFO() << "工具已注册:" << pTool->getName();
-	emit toolsListChanged();
+	m_listChangeLog.record(pTool->getName(), bReplaced ? MCPListChangeLog::ChangeType::Changed : MCPListChangeLog::ChangeType::Added);
+	notifyListChanged();
 	return true;
 }
 
 bool MCPToolService::registerTool(MCPTool* pTool)
 {
 	// 如果已存在，先删除旧的（覆盖），不发送信号，因为后面注册新对象时会发送
-	if (m_dictTools.contains(pTool->getName()))
+	bool bReplaced = m_dictTools.contains(pTool->getName());
+	if (bReplaced)
 	{
 		MCP_TOOLS_LOG_INFO() << "工具已存在，覆盖旧工具:" << pTool->getName();
 		doRemoveImpl(pTool->getName(), false);
 	}
 	m_dictTools.insert(pTool->getName(), pTool);
 	MCP_TOOLS_LOG_INFO() << "工具已注册:" << pTool->getName();
-	emit toolsListChanged();
+	m_listChangeLog.record(pTool->getName(), bReplaced ? MCPListChangeLog::ChangeType::Changed : MCPListChangeLog::ChangeType::Added);
+	notifyListChanged();
 	return true;
 }
 
@@ -271,34 +416,20 @@ MCPTool* MCPToolService::getTool(const QString& strToolName) const
 	return m_dictTools.value(strToolName, nullptr);
 }
 
-QJsonObject MCPToolService::callTool(const QString& strToolName, const QJsonObject& jsonCallArguments)
+bool MCPToolService::isSingleFlightEnabled(const QString& strToolName) const
+{
+	auto pTool = getTool(strToolName);
+	return pTool != nullptr && pTool->isSingleFlight();
+}
+
+MCPResult<QJsonObject> MCPToolService::callTool(const QString& strToolName, const QJsonObject& jsonCallArguments)
 {
 	auto pTool = getTool(strToolName);
 	if (pTool == nullptr)
 	{
 		MCP_TOOLS_LOG_CRITICAL() << QString("未知工具: %1").arg(strToolName);
 		// 根据 MCP 协议规范，工具不存在的错误消息应该是英文
-		throw MCPError::toolNotFound(strToolName);
-	}
-	try
-	{
-		return pTool->execute(jsonCallArguments);
-	}
-	catch (const MCPError& e)
-	{
-		// 重新抛出MCPError异常
-		throw e;
-	}
-	catch (const std::exception& e)
-	{
-		MCP_TOOLS_LOG_CRITICAL() << "MCPToolService: 工具执行异常 - " << strToolName << ":" << e.what();
-		// 根据 MCP 协议规范，内部错误的错误消息应该是英文
-		throw MCPError::internalError(QString("Tool execution failed: %1").arg(e.what()));
-	}
-	catch (...)
-	{
-		MCP_TOOLS_LOG_CRITICAL() << "MCPToolService: 工具执行时发生未知异常 - " << strToolName;
-		// 根据 MCP 协议规范，内部错误的错误消息应该是英文
-		throw MCPError::internalError("Tool execution failed: Unknown error");
+		return MCPError::toolNotFound(strToolName);
 	}
+	return pTool->execute(jsonCallArguments);
 }
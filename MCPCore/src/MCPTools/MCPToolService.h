@@ -14,9 +14,10 @@
 #include <QString>
 #include <functional>
 #include "IMCPToolService.h"
+#include "MCPError/MCPResult.h"
+#include "Utils/MCPListChangeLog.h"
 
 class MCPTool;
-class MCPError;
 struct MCPToolConfig;
 
 /**
@@ -58,20 +59,65 @@ public:
              const QJsonObject& jsonOutputSchema,
              std::function<QJsonObject()> execFun) override;
     
+    bool addWithArgs(const QString& strName,
+                     const QString& strTitle,
+                     const QString& strDescription,
+                     const QJsonObject& jsonInputSchema,
+                     const QJsonObject& jsonOutputSchema,
+                     std::function<QJsonObject(const QJsonObject&)> execFun) override;
+    
     bool remove(const QString& strName) override;
 
 public:
 	//
     QJsonArray list() const override;
+    //
+    void batchUpdate(const std::function<void()>& fun) override;
     //
 	bool addFromJson(const QJsonObject& jsonTool, QObject* pSearchRoot = nullptr) override;
 	//
+	QJsonObject getCacheStatistics() const override;
+	//
 	QJsonObject call(const QString& strMethodName, const QJsonObject& jsonCallArguments);
 public:
     // 内部方法（供内部使用）
     bool registerTool(MCPTool* pTool, QObject* pExecHandler, const QString& strMethodName = QString());
-    bool registerTool(MCPTool* pTool, std::function<QJsonObject()> execFun);
-    QJsonObject callTool(const QString& strMethodName, const QJsonObject& jsonCallArguments);
+    bool registerTool(MCPTool* pTool, std::function<QJsonObject(const QJsonObject&)> execFun);
+    MCPResult<QJsonObject> callTool(const QString& strMethodName, const QJsonObject& jsonCallArguments);
+    bool isSingleFlightEnabled(const QString& strToolName) const;
+
+    /**
+     * @brief 获取一页工具列表（按工具名称排序的键集分页，翻页期间增删其他条目不会导致重复或遗漏）
+     * @param strAfterName 上一页最后一个工具名称，为空表示从头开始
+     * @param nPageSize 每页条目数，0表示不分页
+     * @param strLastName 输出：还有后续条目时为本页最后一个工具名称，否则为空
+     */
+    QJsonArray listPage(const QString& strAfterName, int nPageSize, QString& strLastName) const;
+
+    /**
+     * @brief 开始批量修改（服务线程内调用，可嵌套）
+     * 
+     * 批量修改期间注册/注销照常记录到变更日志，toolsListChanged信号推迟到最外层endUpdate()时只发送一次
+     */
+    void beginUpdate();
+    
+    /**
+     * @brief 结束批量修改，最外层结束且期间有变化时发送一次列表变化信号
+     */
+    void endUpdate();
+
+    /**
+     * @brief 获取工具列表当前代数（每次注册/覆盖/注销加1）
+     */
+    quint64 getListGeneration() const;
+
+    /**
+     * @brief 获取自指定代数以来的工具列表增量
+     * @param nSinceGeneration 起始代数
+     * @param objDelta 输出：{generation, added, changed, removed}
+     * @return false表示差距过大或代数未知，调用方应退化为不带参数的list_changed
+     */
+    bool getListDelta(quint64 nSinceGeneration, QJsonObject& objDelta) const;
     
 signals:
     /**
@@ -108,7 +154,7 @@ private:
 	                   const QString& strDescription,
 	                   const QJsonObject& jsonInputSchema,
 	                   const QJsonObject& jsonOutputSchema,
-	                   std::function<QJsonObject()> execFun);
+	                   std::function<QJsonObject(const QJsonObject&)> execFun);
 	
 	/**
 	 * @brief 内部方法：实际执行删除工具操作
@@ -122,6 +168,16 @@ private:
 	 */
 	QJsonArray doListImpl() const;
 	
+	/**
+	 * @brief 发送工具列表变化信号（批量修改期间只做标记）
+	 */
+	void notifyListChanged();
+	
+	/**
+	 * @brief 内部方法：实际执行分页获取工具列表操作
+	 */
+	QJsonArray doListPageImpl(const QString& strAfterName, int nPageSize, QString& strLastName) const;
+	
 	/**
 	 * @brief 从配置对象添加工具（内部方法，供MCPServer使用）
 	 * @param toolConfig 工具配置对象
@@ -136,6 +192,9 @@ private:
 	
 private:
     QMap<QString, MCPTool*> m_dictTools;
+    MCPListChangeLog m_listChangeLog;   // 工具列表变更日志（用于增量list_changed）
+    int m_nUpdateDepth;                 // 批量修改嵌套层数
+    bool m_bListChangedPending;         // 批量修改期间列表是否有变化
     
 private:
 	friend class MCPAutoServer;
@@ -9,6 +9,8 @@
 #pragma once
 #include <QObject>
 #include <QSharedPointer>
+#include <QList>
+#include <QJsonObject>
 
 class MCPMessage;
 
@@ -70,6 +72,28 @@ public:
      */
     virtual void sendCloseMessage(quint64 nConnectionId, QSharedPointer<MCPMessage> pMessage) = 0;
     
+    /**
+     * @brief 向多个连接发送同一条消息
+     * @param lstConnectionIds 连接ID列表
+     * @param pMessage 消息对象指针（只序列化一次，各连接共享同一份只读数据）
+     */
+    virtual void broadcastMessage(const QList<quint64>& lstConnectionIds, QSharedPointer<MCPMessage> pMessage) = 0;
+    
+    /**
+     * @brief 设置每个连接的出站队列水位（只影响之后建立的连接）
+     * @param nHighWatermarkBytes 待写字节超过该值后开始排队，0表示不排队
+     * @param nLowWatermarkBytes 待写字节回落到该值后继续写出排队数据
+     * @param nMaxQueuedBytes 排队字节数上限，超出后断开连接，0表示不限制
+     */
+    virtual void setOutboundLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes) = 0;
+    
+    /**
+     * @brief 获取出站队列统计（各连接的队列深度、峰值、合并次数）
+     * 
+     * 可在任意线程调用，连接表和各连接的队列在所属线程内读取
+     */
+    virtual QJsonObject getOutboundStatistics() = 0;
+    
 signals:
     /**
      * @brief 收到消息信号
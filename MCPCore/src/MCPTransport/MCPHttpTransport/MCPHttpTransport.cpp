@@ -14,14 +14,19 @@
 #include <QNetworkInterface>
 #include <QDateTime>
 #include <QJsonDocument>
+#include <QJsonArray>
 #include <QCoreApplication>
 #include "Utils/MCPInvokeHelper.h"
 #include "MCPClientMessage.h"
 #include "impl/MCPHttpRequestData.h"
 #include "impl/MCPHttpConnection.h"
+#include "impl/MCPHttpOutboundQueue.h"
 #include "impl/MCPThreadPool.h"
 MCPHttpTransport::MCPHttpTransport(QObject* pParent)
     : QTcpServer(pParent)
+    , m_nOutboundHighWatermarkBytes(MCPHttpOutboundQueue::kDefaultHighWatermarkBytes)
+    , m_nOutboundLowWatermarkBytes(MCPHttpOutboundQueue::kDefaultLowWatermarkBytes)
+    , m_nOutboundMaxQueuedBytes(MCPHttpOutboundQueue::kDefaultMaxQueuedBytes)
     , m_pThreadPool(new MCPThreadPool(2, this))
 {
 	qRegisterMetaType<QSharedPointer<MCPHttpRequestData>>("QSharedPointer<HttpRequestData>");
@@ -65,6 +70,57 @@ bool MCPHttpTransport::isRunning()
     return isListening();
 }
 
+void MCPHttpTransport::setOutboundLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes)
+{
+	// 只影响之后建立的连接
+	m_nOutboundHighWatermarkBytes = nHighWatermarkBytes;
+	m_nOutboundLowWatermarkBytes = nLowWatermarkBytes;
+	m_nOutboundMaxQueuedBytes = nMaxQueuedBytes;
+}
+
+QJsonObject MCPHttpTransport::getOutboundStatistics()
+{
+	// 连接表属于传输线程，先同步到传输线程遍历；各连接的队列只在连接线程访问，再同步到连接线程读取
+	return MCPInvokeHelper::syncInvokeReturnT<QJsonObject>(this, [this]()
+		{
+			return doGetOutboundStatisticsImpl();
+		});
+}
+
+QJsonObject MCPHttpTransport::doGetOutboundStatisticsImpl()
+{
+	QJsonArray arrConnections;
+	qint64 nTotalQueuedBytes = 0;
+	int nTotalQueuedFrames = 0;
+	int nBackpressuredConnections = 0;
+	for (auto pConnection : m_dictConnections)
+	{
+		QJsonObject objConnection = MCPInvokeHelper::syncInvokeReturnT<QJsonObject>(pConnection, [pConnection]()
+			{
+				return pConnection->getOutboundStatistics();
+			});
+		qint64 nQueuedBytes = static_cast<qint64>(objConnection.value("queuedBytes").toDouble());
+		int nQueuedFrames = objConnection.value("queuedFrames").toInt();
+		nTotalQueuedBytes += nQueuedBytes;
+		nTotalQueuedFrames += nQueuedFrames;
+		if (nQueuedFrames > 0)
+		{
+			++nBackpressuredConnections;
+		}
+		arrConnections.append(objConnection);
+	}
+
+	QJsonObject objStatistics;
+	objStatistics["highWatermarkBytes"] = static_cast<double>(m_nOutboundHighWatermarkBytes);
+	objStatistics["lowWatermarkBytes"] = static_cast<double>(m_nOutboundLowWatermarkBytes);
+	objStatistics["maxQueuedBytes"] = static_cast<double>(m_nOutboundMaxQueuedBytes);
+	objStatistics["totalQueuedBytes"] = static_cast<double>(nTotalQueuedBytes);
+	objStatistics["totalQueuedFrames"] = nTotalQueuedFrames;
+	objStatistics["backpressuredConnections"] = nBackpressuredConnections;
+	objStatistics["connections"] = arrConnections;
+	return objStatistics;
+}
+
 void MCPHttpTransport::sendMessage(quint64 nConnectionId, QSharedPointer<MCPMessage> pResponse)
 {
     if (auto pConnection = m_dictConnections.value(nConnectionId))
@@ -88,6 +144,30 @@ void MCPHttpTransport::sendCloseMessage(quint64 nConnectionId, QSharedPointer<MC
 	}
 }
 
+void MCPHttpTransport::broadcastMessage(const QList<quint64>& lstConnectionIds, QSharedPointer<MCPMessage> pMessage)
+{
+	if (pMessage == nullptr || lstConnectionIds.isEmpty())
+	{
+		return;
+	}
+	// 只序列化和分类一次，QByteArray隐式共享，各连接的写队列引用同一块只读缓冲区
+	const MCPHttpOutboundQueue::Frame frame = MCPHttpOutboundQueue::createFrame(pMessage);
+	int nQueued = 0;
+	for (auto nConnectionId : lstConnectionIds)
+	{
+		if (auto pConnection = m_dictConnections.value(nConnectionId))
+		{
+			// 异步投递到连接所在线程，不阻塞服务线程逐个等待写入
+			MCPInvokeHelper::asynInvoke(pConnection, [pConnection, frame]()
+				{
+					pConnection->sendFrame(frame);
+				});
+			++nQueued;
+		}
+	}
+	MCP_TRANSPORT_LOG_DEBUG() << "广播消息已投递，连接数:" << nQueued << ", 大小:" << frame.data.size();
+}
+
 
 void MCPHttpTransport::incomingConnection(qintptr handle)
 {
@@ -95,6 +175,7 @@ void MCPHttpTransport::incomingConnection(qintptr handle)
     MCPHttpConnection* pConnection = new MCPHttpConnection(handle, nullptr);
 	QObject::connect(pConnection, &MCPHttpConnection::messageReceived, this, &MCPHttpTransport::messageReceived);
 	QObject::connect(pConnection, &MCPHttpConnection::disconnected, this, &MCPHttpTransport::onDisconnected);
+	pConnection->setOutboundLimits(m_nOutboundHighWatermarkBytes, m_nOutboundLowWatermarkBytes, m_nOutboundMaxQueuedBytes);
     m_dictConnections[pConnection->getConnectionId()] = pConnection;
     m_pThreadPool->addWorker(pConnection);
 }
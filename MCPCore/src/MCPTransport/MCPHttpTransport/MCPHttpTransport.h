@@ -2,6 +2,7 @@
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QMap>
+#include <QJsonObject>
 #include "MCPMessage.h"
 #include "MCPServerMessage.h"
 
@@ -13,6 +14,7 @@
  * - 支持POST请求
  * - 管理HTTP连接生命周期
  * - 处理HTTP协议细节
+ * - 为每个连接配置出站队列水位，汇总各连接的队列统计
  * 
  * 编码规范：
  * - 类成员添加 m_ 前缀
@@ -34,6 +36,8 @@ public:
     bool start(quint16 nPort);
     bool stop();
     bool isRunning();
+    void setOutboundLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes);
+    QJsonObject getOutboundStatistics();
 signals:
     void messageReceived(quint64 nConnectionId, const QSharedPointer<MCPMessage>& pMessage);
     void connectionDisconnected(quint64 nConnectionId);
@@ -41,12 +45,17 @@ signals:
 public slots:
     void sendMessage(quint64 nConnectionId, QSharedPointer<MCPMessage> pMessage);
     void sendCloseMessage(quint64 nConnectionId, QSharedPointer<MCPMessage> pMessage);
+    void broadcastMessage(const QList<quint64>& lstConnectionIds, QSharedPointer<MCPMessage> pMessage);
 private slots:
     void onDisconnected();
 private:
 	void incomingConnection(qintptr handle);
+	QJsonObject doGetOutboundStatisticsImpl();
 private:
     QMap<quint64, MCPHttpConnection*> m_dictConnections;
+    qint64 m_nOutboundHighWatermarkBytes;
+    qint64 m_nOutboundLowWatermarkBytes;
+    qint64 m_nOutboundMaxQueuedBytes;
 private:
     MCPThreadPool* m_pThreadPool;
 };
\ No newline at end of file
@@ -56,3 +56,20 @@ void MCPHttpTransportAdapter::sendCloseMessage(quint64 nConnectionId, QSharedPoi
     m_pHttpTransport->sendCloseMessage(nConnectionId, pMessage);
 }
 
+void MCPHttpTransportAdapter::broadcastMessage(const QList<quint64>& lstConnectionIds, QSharedPointer<MCPMessage> pMessage)
+{
+    // 转发调用到内部的HTTP传输对象
+    m_pHttpTransport->broadcastMessage(lstConnectionIds, pMessage);
+}
+
+void MCPHttpTransportAdapter::setOutboundLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes)
+{
+    // 转发调用到内部的HTTP传输对象
+    m_pHttpTransport->setOutboundLimits(nHighWatermarkBytes, nLowWatermarkBytes, nMaxQueuedBytes);
+}
+
+QJsonObject MCPHttpTransportAdapter::getOutboundStatistics()
+{
+    // 转发调用到内部的HTTP传输对象
+    return m_pHttpTransport->getOutboundStatistics();
+}
@@ -44,6 +44,9 @@ public:
     virtual bool isRunning() override;
     virtual void sendMessage(quint64 nConnectionId, QSharedPointer<MCPMessage> pMessage) override;
     virtual void sendCloseMessage(quint64 nConnectionId, QSharedPointer<MCPMessage> pMessage) override;
+    virtual void broadcastMessage(const QList<quint64>& lstConnectionIds, QSharedPointer<MCPMessage> pMessage) override;
+    virtual void setOutboundLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes) override;
+    virtual QJsonObject getOutboundStatistics() override;
     
 private:
     MCPHttpTransport* m_pHttpTransport;
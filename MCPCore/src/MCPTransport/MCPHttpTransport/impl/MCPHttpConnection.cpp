@@ -15,17 +15,21 @@
 #include "MCPHttpRequestData.h"
 #include "MCPHttpRequestParser.h"
 #include "MCPHttpMessageParser.h"
+#include "MCPHttpStreamedResponse.h"
 #include "Utils/MCPInvokeHelper.h"
 static quint64 SERVER_CONNECTION_ID = 1000;
 MCPHttpConnection::MCPHttpConnection(qintptr nSocketDescriptor, QObject* parent)
     : QObject(parent)
     , m_nId(SERVER_CONNECTION_ID++)
     , m_pHttpRequestParser(new MCPHttpRequestParser(this))
+    , m_nBackpressureCount(0)
+    , m_bOverflowDisconnected(false)
 {
     m_pSocket = new QTcpSocket(this);
     m_pSocket->setSocketDescriptor(nSocketDescriptor);
 	QObject::connect(m_pSocket, &QTcpSocket::readyRead, this, &MCPHttpConnection::onReadyRead);
     QObject::connect(m_pSocket, &QTcpSocket::disconnected, this, &MCPHttpConnection::onDisconnected);
+    QObject::connect(m_pSocket, &QTcpSocket::bytesWritten, this, &MCPHttpConnection::onBytesWritten);
     QObject::connect(m_pSocket, static_cast<void (QAbstractSocket::*)(QAbstractSocket::SocketError)>(&QAbstractSocket::error),
 		this, &MCPHttpConnection::onError);
     QObject::connect(m_pHttpRequestParser, &MCPHttpRequestParser::httpRequestReceived, this, &MCPHttpConnection::onHttpRequestReceived);
@@ -45,16 +49,151 @@ quint64 MCPHttpConnection::getConnectionId()
     return m_nId;
 }
 
+void MCPHttpConnection::setOutboundLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes)
+{
+    m_outboundQueue.setLimits(nHighWatermarkBytes, nLowWatermarkBytes, nMaxQueuedBytes);
+}
+
+QJsonObject MCPHttpConnection::getOutboundStatistics() const
+{
+    QJsonObject objStatistics = m_outboundQueue.getStatistics();
+    objStatistics["connectionId"] = static_cast<double>(m_nId);
+    objStatistics["socketPendingBytes"] = static_cast<double>(m_pSocket->bytesToWrite());
+    objStatistics["backpressureCount"] = static_cast<double>(m_nBackpressureCount);
+    objStatistics["overflowDisconnected"] = m_bOverflowDisconnected;
+    objStatistics["streamingResponse"] = (m_pStreamedResponse != nullptr);
+    return objStatistics;
+}
+
 void MCPHttpConnection::sendMessage(QSharedPointer<MCPMessage> pMessage)
 {
-    auto data = pMessage->toData();
+    auto frame = MCPHttpOutboundQueue::createFrame(pMessage);
 	MCP_TRANSPORT_LOG_INFO() << "发送HTTP响应到" << m_pSocket->peerAddress().toString()
-		<< ":" << m_pSocket->peerPort() << ", 大小:" << data.size();
+		<< ":" << m_pSocket->peerPort() << ", 大小:"
+		<< (frame.pStreamedResponse != nullptr ? frame.data.size() + frame.pStreamedResponse->getSizeHint() : frame.data.size());
 
 	// 记录详细的HTTP响应内容
-	MCP_TRANSPORT_LOG_DEBUG().noquote() << "HTTP响应详情:\n" << data;
+	MCP_TRANSPORT_LOG_DEBUG().noquote() << "HTTP响应详情:\n" << frame.data;
+
+	writeFrame(frame);
+}
+
+void MCPHttpConnection::sendFrame(const MCPHttpOutboundQueue::Frame& frame)
+{
+	MCP_TRANSPORT_LOG_DEBUG() << "发送共享数据帧到" << m_pSocket->peerAddress().toString()
+		<< ":" << m_pSocket->peerPort() << ", 大小:" << frame.data.size();
+	writeFrame(frame);
+}
+
+void MCPHttpConnection::writeFrame(const MCPHttpOutboundQueue::Frame& frame)
+{
+    if (m_bOverflowDisconnected)
+    {
+        return;
+    }
+
+    qint64 nHighWatermark = m_outboundQueue.getHighWatermark();
+    if (m_outboundQueue.isEmpty() && m_pStreamedResponse == nullptr
+        && (nHighWatermark <= 0 || m_pSocket->bytesToWrite() < nHighWatermark))
+    {
+        startFrame(frame);
+        return;
+    }
+
+    // 流式响应体写完前，之后的帧按顺序排队
+    if (m_outboundQueue.isEmpty() && m_pStreamedResponse == nullptr)
+    {
+        ++m_nBackpressureCount;
+        MCP_TRANSPORT_LOG_INFO() << "客户端消费过慢，开始排队:" << m_pSocket->peerAddress().toString()
+            << ":" << m_pSocket->peerPort() << ", 待写字节:" << m_pSocket->bytesToWrite();
+    }
+    m_outboundQueue.enqueue(frame);
+
+    if (m_outboundQueue.isOverflowed())
+    {
+        // 通知合并后仍持续积压说明客户端已不再读取，断开连接，由客户端重连后重新同步；
+        // 响应帧不计入上限，单个大响应不会导致断开
+        MCP_TRANSPORT_LOG_WARNING() << "出站队列中的通知超过上限，断开客户端连接:" << m_pSocket->peerAddress().toString()
+            << ":" << m_pSocket->peerPort() << ", 排队字节:" << m_outboundQueue.getQueuedBytes()
+            << ", 排队帧数:" << m_outboundQueue.getQueuedFrames();
+        m_bOverflowDisconnected = true;
+        m_outboundQueue.clear();
+        m_pStreamedResponse.reset();
+        m_pSocket->abort();
+    }
+}
+
+void MCPHttpConnection::startFrame(const MCPHttpOutboundQueue::Frame& frame)
+{
+    m_pSocket->write(frame.data);
+    if (frame.pStreamedResponse != nullptr)
+    {
+        m_pStreamedResponse = frame.pStreamedResponse;
+        writeStreamedResponse();
+    }
+}
+
+void MCPHttpConnection::writeStreamedResponse()
+{
+    // 每次只编码一块，待写字节达到高水位后等bytesWritten再继续，响应数据不会完整出现在内存中；
+    // 高水位为0（不排队）时仍按默认高水位分块，否则会一次编码整个文件
+    qint64 nHighWatermark = m_outboundQueue.getHighWatermark();
+    if (nHighWatermark <= 0)
+    {
+        nHighWatermark = MCPHttpOutboundQueue::kDefaultHighWatermarkBytes;
+    }
+    while (m_pStreamedResponse != nullptr && m_pSocket->bytesToWrite() < nHighWatermark)
+    {
+        QByteArray arrData;
+        if (!m_pStreamedResponse->readNext(arrData))
+        {
+            // 响应头已发出，无法再改为错误响应，只能断开连接让客户端感知响应不完整
+            MCP_TRANSPORT_LOG_WARNING() << "流式响应读取失败，断开客户端连接:" << m_pSocket->peerAddress().toString()
+                << ":" << m_pSocket->peerPort();
+            m_pStreamedResponse.reset();
+            m_outboundQueue.clear();
+            m_pSocket->abort();
+            return;
+        }
+        if (!arrData.isEmpty())
+        {
+            m_pSocket->write(arrData);
+        }
+        if (m_pStreamedResponse->isAtEnd())
+        {
+            m_pStreamedResponse.reset();
+        }
+    }
+}
+
+void MCPHttpConnection::onBytesWritten(qint64 nBytes)
+{
+    Q_UNUSED(nBytes);
+    if (m_pStreamedResponse != nullptr)
+    {
+        writeStreamedResponse();
+        if (m_pStreamedResponse != nullptr)
+        {
+            return;
+        }
+    }
+
+    if (m_outboundQueue.isEmpty() || m_pSocket->bytesToWrite() > m_outboundQueue.getLowWatermark())
+    {
+        return;
+    }
 
-	m_pSocket->write(data);
+    qint64 nHighWatermark = m_outboundQueue.getHighWatermark();
+    while (!m_outboundQueue.isEmpty() && m_pStreamedResponse == nullptr
+        && (nHighWatermark <= 0 || m_pSocket->bytesToWrite() < nHighWatermark))
+    {
+        startFrame(m_outboundQueue.takeFirst());
+    }
+    if (m_outboundQueue.isEmpty())
+    {
+        MCP_TRANSPORT_LOG_DEBUG() << "出站队列已清空:" << m_pSocket->peerAddress().toString()
+            << ":" << m_pSocket->peerPort();
+    }
 }
 
 void MCPHttpConnection::disconnectFromHost()
@@ -3,11 +3,14 @@
 #include <QByteArray>
 #include <QSharedPointer>
 #include <QAbstractSocket>
+#include <QJsonObject>
 #include "MCPMessage.h"
 #include "MCPHttpRequestData.h"
 #include "MCPServerMessage.h"
+#include "MCPHttpOutboundQueue.h"
 class QTcpSocket;
 class MCPHttpRequestParser;
+class MCPHttpStreamedResponse;
 class MCPHttpConnection : public QObject
 {
     Q_OBJECT
@@ -23,10 +26,16 @@ signals:
 public:
     //
     quint64 getConnectionId();
+    // 设置出站队列水位（需在连接线程或移入线程前调用）
+    void setOutboundLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes);
+    // 获取出站队列统计（需在连接线程调用）
+    QJsonObject getOutboundStatistics() const;
     //
 public slots:
 	// 发送数据
 	void sendMessage(QSharedPointer<MCPMessage> pResponse);
+	// 发送已序列化的数据帧（广播时多个连接共享同一份数据）
+	void sendFrame(const MCPHttpOutboundQueue::Frame& frame);
     void disconnectFromHost();
 private slots:
     // 处理就绪读取
@@ -34,11 +43,24 @@ private slots:
     // 处理错误
     void onError(QAbstractSocket::SocketError error);
 	void onDisconnected();
+    // 套接字写出数据后，待写字节回落到低水位时继续写出排队帧
+    void onBytesWritten(qint64 nBytes);
 private slots:
 	void onHttpRequestReceived(QByteArray data, QSharedPointer<MCPHttpRequestData> pRequestData);
+private:
+    // 待写字节低于高水位且无排队时直接写入，否则进入出站队列
+    void writeFrame(const MCPHttpOutboundQueue::Frame& frame);
+    // 写出帧数据，带流式响应体时开始逐块写出
+    void startFrame(const MCPHttpOutboundQueue::Frame& frame);
+    // 逐块写出流式响应体，直到待写字节达到高水位或写完
+    void writeStreamedResponse();
 private:
     quint64 m_nId;
     QTcpSocket* m_pSocket;
+    MCPHttpOutboundQueue m_outboundQueue;
+    quint64 m_nBackpressureCount;       // 进入背压（开始排队）的次数
+    bool m_bOverflowDisconnected;       // 是否因队列超限被断开
+    QSharedPointer<MCPHttpStreamedResponse> m_pStreamedResponse;    // 正在逐块写出的响应体，写完前其他帧排队
 private:
     MCPHttpRequestParser* m_pHttpRequestParser;
 };
@@ -137,6 +137,19 @@ QSharedPointer<MCPClientMessage> MCPHttpMessageParser::genClientMessageFromHttp(
 		pClientMessage->appendType(MCPMessageType::SseTransport | MCPMessageType::Connect);
         return pClientMessage;
     }
+    //2025-03-26/2025-06-18：已初始化的Streamable会话GET /mcp 打开事件流，服务器通过它主动推送通知
+    //https://modelcontextprotocol.io/specification/2025-06-18/basic/transports#listening-for-messages-from-the-server
+    if (strHttpMethod == "GET"
+        && strPath == "/mcp"
+        && strQuerySessionId.isEmpty()
+        && !strMcpSessionId.isEmpty()
+        && (setAcceptTypes.contains("text/event-stream") || setAcceptTypes.contains("*/*")))
+    {
+        //同connect一样模拟成rpc调用，由路由绑定事件流
+        pClientMessage->m_jsonRpc.insert("method", "stream");
+        pClientMessage->appendType(MCPMessageType::StreamableTransport | MCPMessageType::StreamableEventStream | MCPMessageType::Connect);
+        return pClientMessage;
+    }
     //批量操作放弃支持 - 2025-06-18已经明确放弃了
     //https://modelcontextprotocol.io/specification/2025-03-26/basic/transports#streamable-http
     if (strHttpMethod == "POST" && strContentType == "application/json")
@@ -0,0 +1,190 @@
+/**
+ * @file MCPHttpOutboundQueue.cpp
+ * @brief HTTP连接的有界出站队列实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPHttpOutboundQueue.h"
+#include "MCPHttpReplyMessage.h"
+#include "MCPHttpStreamedResponse.h"
+#include "MCPMessage.h"
+
+const qint64 MCPHttpOutboundQueue::kDefaultHighWatermarkBytes;
+const qint64 MCPHttpOutboundQueue::kDefaultLowWatermarkBytes;
+const qint64 MCPHttpOutboundQueue::kDefaultMaxQueuedBytes;
+
+MCPHttpOutboundQueue::MCPHttpOutboundQueue()
+    : m_nHeadSequence(0)
+    , m_nQueuedBytes(0)
+    , m_nQueuedNotificationBytes(0)
+    , m_nHighWatermarkBytes(kDefaultHighWatermarkBytes)
+    , m_nLowWatermarkBytes(kDefaultLowWatermarkBytes)
+    , m_nMaxQueuedBytes(kDefaultMaxQueuedBytes)
+    , m_nPeakQueuedFrames(0)
+    , m_nPeakQueuedBytes(0)
+    , m_nEnqueuedFrames(0)
+    , m_nCoalescedFrames(0)
+{
+}
+
+MCPHttpOutboundQueue::Frame MCPHttpOutboundQueue::createFrame(const QSharedPointer<MCPMessage>& pMessage)
+{
+    Frame frame;
+    frame.enClass = FrameClass::Critical;
+
+    auto pReplyMessage = pMessage.dynamicCast<MCPHttpReplyMessage>();
+    if (pReplyMessage != nullptr)
+    {
+        frame.pStreamedResponse = pReplyMessage->createStreamedResponse(frame.data);
+        if (frame.pStreamedResponse != nullptr)
+        {
+            return frame;
+        }
+    }
+
+    frame.data = pMessage->toData();
+    if (pReplyMessage == nullptr || !pReplyMessage->isPushNotification())
+    {
+        return frame;
+    }
+
+    // 推送通知不由客户端请求驱动，均计入断开阈值；其中可合并的带合并键
+    frame.enClass = FrameClass::Notification;
+    QString strMethod = pReplyMessage->getNotificationMethod();
+    if (strMethod.endsWith("/list_changed"))
+    {
+        frame.enClass = FrameClass::ListChanged;
+        frame.strCoalesceKey = strMethod;
+        frame.coalescedData = pReplyMessage->toBareNotificationData();
+    }
+    else if (strMethod == "notifications/resources/updated")
+    {
+        frame.strCoalesceKey = strMethod + " " + pReplyMessage->getNotificationUri();
+    }
+    return frame;
+}
+
+void MCPHttpOutboundQueue::setLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes)
+{
+    m_nHighWatermarkBytes = qMax<qint64>(0, nHighWatermarkBytes);
+    m_nLowWatermarkBytes = qBound<qint64>(0, nLowWatermarkBytes, m_nHighWatermarkBytes);
+    m_nMaxQueuedBytes = qMax<qint64>(0, nMaxQueuedBytes);
+}
+
+qint64 MCPHttpOutboundQueue::getHighWatermark() const
+{
+    return m_nHighWatermarkBytes;
+}
+
+qint64 MCPHttpOutboundQueue::getLowWatermark() const
+{
+    return m_nLowWatermarkBytes;
+}
+
+qint64 MCPHttpOutboundQueue::getMaxQueuedBytes() const
+{
+    return m_nMaxQueuedBytes;
+}
+
+bool MCPHttpOutboundQueue::enqueue(const Frame& frame)
+{
+    if (!frame.strCoalesceKey.isEmpty())
+    {
+        auto it = m_dictCoalesceIndex.constFind(frame.strCoalesceKey);
+        if (it != m_dictCoalesceIndex.constEnd())
+        {
+            // 原地替换排队帧：list_changed两次增量无法拼接，退化为不带参数的通知让客户端重新拉取；
+            // resources/updated只需最新一条
+            QueuedFrame& queuedFrame = m_lstFrames[static_cast<int>(it.value() - m_nHeadSequence)];
+            const QByteArray& newData = (frame.enClass == FrameClass::ListChanged && !frame.coalescedData.isEmpty())
+                ? frame.coalescedData : frame.data;
+            m_nQueuedBytes += newData.size() - queuedFrame.data.size();
+            m_nQueuedNotificationBytes += newData.size() - queuedFrame.data.size();
+            queuedFrame.data = newData;
+            ++m_nCoalescedFrames;
+            return false;
+        }
+        m_dictCoalesceIndex.insert(frame.strCoalesceKey, m_nHeadSequence + static_cast<quint64>(m_lstFrames.size()));
+    }
+
+    const bool bCritical = (frame.enClass == FrameClass::Critical);
+    m_lstFrames.append(QueuedFrame{ frame.data, frame.strCoalesceKey, frame.pStreamedResponse, bCritical });
+    m_nQueuedBytes += frame.data.size();
+    if (!bCritical)
+    {
+        m_nQueuedNotificationBytes += frame.data.size();
+    }
+    ++m_nEnqueuedFrames;
+    m_nPeakQueuedFrames = qMax(m_nPeakQueuedFrames, m_lstFrames.size());
+    m_nPeakQueuedBytes = qMax(m_nPeakQueuedBytes, m_nQueuedBytes);
+    return true;
+}
+
+MCPHttpOutboundQueue::Frame MCPHttpOutboundQueue::takeFirst()
+{
+    Frame frame;
+    frame.enClass = FrameClass::Critical;
+    if (m_lstFrames.isEmpty())
+    {
+        return frame;
+    }
+
+    QueuedFrame queuedFrame = m_lstFrames.takeFirst();
+    if (!queuedFrame.strCoalesceKey.isEmpty())
+    {
+        m_dictCoalesceIndex.remove(queuedFrame.strCoalesceKey);
+    }
+    ++m_nHeadSequence;
+    m_nQueuedBytes -= queuedFrame.data.size();
+    if (!queuedFrame.bCritical)
+    {
+        m_nQueuedNotificationBytes -= queuedFrame.data.size();
+    }
+    frame.data = queuedFrame.data;
+    frame.pStreamedResponse = queuedFrame.pStreamedResponse;
+    return frame;
+}
+
+bool MCPHttpOutboundQueue::isEmpty() const
+{
+    return m_lstFrames.isEmpty();
+}
+
+bool MCPHttpOutboundQueue::isOverflowed() const
+{
+    return m_nMaxQueuedBytes > 0 && m_nQueuedNotificationBytes > m_nMaxQueuedBytes;
+}
+
+void MCPHttpOutboundQueue::clear()
+{
+    m_nHeadSequence += static_cast<quint64>(m_lstFrames.size());
+    m_lstFrames.clear();
+    m_dictCoalesceIndex.clear();
+    m_nQueuedBytes = 0;
+    m_nQueuedNotificationBytes = 0;
+}
+
+int MCPHttpOutboundQueue::getQueuedFrames() const
+{
+    return m_lstFrames.size();
+}
+
+qint64 MCPHttpOutboundQueue::getQueuedBytes() const
+{
+    return m_nQueuedBytes;
+}
+
+QJsonObject MCPHttpOutboundQueue::getStatistics() const
+{
+    QJsonObject objStatistics;
+    objStatistics["queuedFrames"] = m_lstFrames.size();
+    objStatistics["queuedBytes"] = static_cast<double>(m_nQueuedBytes);
+    objStatistics["queuedNotificationBytes"] = static_cast<double>(m_nQueuedNotificationBytes);
+    objStatistics["peakQueuedFrames"] = m_nPeakQueuedFrames;
+    objStatistics["peakQueuedBytes"] = static_cast<double>(m_nPeakQueuedBytes);
+    objStatistics["enqueuedFrames"] = static_cast<double>(m_nEnqueuedFrames);
+    objStatistics["coalescedFrames"] = static_cast<double>(m_nCoalescedFrames);
+    return objStatistics;
+}
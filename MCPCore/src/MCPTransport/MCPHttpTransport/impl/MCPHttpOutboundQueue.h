@@ -0,0 +1,139 @@
+/**
+ * @file MCPHttpOutboundQueue.h
+ * @brief HTTP连接的有界出站队列（慢消费者背压）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QJsonObject>
+#include <QSharedPointer>
+
+class MCPMessage;
+class MCPHttpStreamedResponse;
+
+/**
+ * @brief HTTP连接的有界出站队列
+ * 
+ * 职责：
+ * - 套接字待写字节超过高水位后，新数据帧先进入本队列，回落到低水位后再继续写入
+ * - 按帧类别合并：list_changed 同一方法只保留一条，resources/updated 同一URI只保留最新一条
+ * - 响应等关键帧不丢弃不合并，也不计入断开阈值（由客户端请求驱动，慢客户端不会无限积压）；
+ *   排队的通知帧字节数超过断开阈值时由连接主动断开
+ * - 大文件响应的帧只含响应头，消息体由连接在写出时逐块编码，不进入队列
+ * - 统计队列深度、峰值和合并次数
+ * 
+ * 线程说明：
+ * - 队列属于连接对象，只在连接所在线程访问，不加锁
+ * 
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPHttpOutboundQueue
+{
+public:
+    /**
+     * @brief 数据帧类别
+     */
+    enum class FrameClass
+    {
+        Critical,       // 响应、连接响应头等，不丢弃不合并
+        Notification,   // 推送到长连接的通知，资源变化通知同一URI只保留最新一条，其余不合并
+        ListChanged     // 列表变化通知，同一方法只保留一条，合并后退化为不带参数的通知
+    };
+
+    /**
+     * @brief 出站数据帧
+     */
+    struct Frame
+    {
+        QByteArray data;            // 已序列化的数据（广播时多个连接共享）
+        FrameClass enClass;         // 帧类别
+        QString strCoalesceKey;     // 合并键，为空表示不合并
+        QByteArray coalescedData;   // ListChanged被合并后使用的帧（不带params）
+        QSharedPointer<MCPHttpStreamedResponse> pStreamedResponse;  // 非空时data只是响应头，消息体在写出data后逐块读取
+    };
+
+    // 默认水位：待写超过1MB开始排队，回落到256KB恢复写入，排队超过16MB断开连接
+    static const qint64 kDefaultHighWatermarkBytes = 1024 * 1024;
+    static const qint64 kDefaultLowWatermarkBytes = 256 * 1024;
+    static const qint64 kDefaultMaxQueuedBytes = 16 * 1024 * 1024;
+
+public:
+    MCPHttpOutboundQueue();
+
+    /**
+     * @brief 根据消息构建数据帧（序列化并分类）
+     * 
+     * 只有推送到长连接（SSE通道、Streamable事件流）的通知参与合并，其余均为关键帧。
+     * 带流式内容的响应只生成响应头，消息体留给连接逐块写出；此类帧带读取状态，不能在连接间共享。
+     */
+    static Frame createFrame(const QSharedPointer<MCPMessage>& pMessage);
+
+public:
+    /**
+     * @brief 设置水位
+     * @param nHighWatermarkBytes 高水位，0表示不排队（直接写入套接字）
+     * @param nLowWatermarkBytes 低水位
+     * @param nMaxQueuedBytes 排队的通知帧字节数上限，超出后断开连接，0表示不限制
+     */
+    void setLimits(qint64 nHighWatermarkBytes, qint64 nLowWatermarkBytes, qint64 nMaxQueuedBytes);
+    qint64 getHighWatermark() const;
+    qint64 getLowWatermark() const;
+    qint64 getMaxQueuedBytes() const;
+
+    /**
+     * @brief 入队（存在相同合并键的排队帧时原地合并）
+     * @return true表示新增一帧，false表示已合并到排队帧
+     */
+    bool enqueue(const Frame& frame);
+
+    /**
+     * @brief 取出队首帧（只有data和pStreamedResponse有效）
+     */
+    Frame takeFirst();
+
+    bool isEmpty() const;
+    // 排队的通知帧（Notification、ListChanged）字节数是否超过上限，关键帧不计入
+    bool isOverflowed() const;
+    void clear();
+
+    int getQueuedFrames() const;
+    qint64 getQueuedBytes() const;
+
+    /**
+     * @brief 获取队列统计
+     * @return {queuedFrames, queuedBytes, queuedNotificationBytes, peakQueuedFrames, peakQueuedBytes, enqueuedFrames, coalescedFrames}
+     */
+    QJsonObject getStatistics() const;
+
+private:
+    struct QueuedFrame
+    {
+        QByteArray data;
+        QString strCoalesceKey;
+        QSharedPointer<MCPHttpStreamedResponse> pStreamedResponse;
+        bool bCritical;
+    };
+
+private:
+    QList<QueuedFrame> m_lstFrames;
+    QHash<QString, quint64> m_dictCoalesceIndex;    // 合并键 -> 帧序号
+    quint64 m_nHeadSequence;                        // 队首帧序号，帧下标 = 序号 - 队首序号
+    qint64 m_nQueuedBytes;
+    qint64 m_nQueuedNotificationBytes;              // 排队的通知帧字节数（用于断开阈值）
+    qint64 m_nHighWatermarkBytes;
+    qint64 m_nLowWatermarkBytes;
+    qint64 m_nMaxQueuedBytes;
+    // 统计
+    int m_nPeakQueuedFrames;
+    qint64 m_nPeakQueuedBytes;
+    quint64 m_nEnqueuedFrames;
+    quint64 m_nCoalescedFrames;
+};
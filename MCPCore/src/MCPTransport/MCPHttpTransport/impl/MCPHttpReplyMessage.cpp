@@ -9,10 +9,13 @@
 #include "MCPHttpReplyMessage.h"
 #include "MCPRouting/MCPContext.h"
 #include "MCPHttpResponseBuilder.h"
+#include "MCPHttpStreamedResponse.h"
+#include "Utils/MCPStreamedBody.h"
 
 MCPHttpReplyMessage::MCPHttpReplyMessage(const QSharedPointer<MCPServerMessage>& pServerMessage, MCPMessageType::Flags flags)
 	: m_pServerMessage(pServerMessage)
 	, m_flags(flags)
+	, m_nHttpStatusCode(0)
 {
 	if (pServerMessage != nullptr)
 	{
@@ -30,8 +33,30 @@ QSharedPointer<MCPHttpReplyMessage> MCPHttpReplyMessage::CreateStreamableAcceptN
 	return QSharedPointer<MCPHttpReplyMessage>::create(QSharedPointer<MCPServerMessage>(), MCPMessageType::StreamableTransport | MCPMessageType::ResponseNotification);
 }
 
+QSharedPointer<MCPHttpReplyMessage> MCPHttpReplyMessage::CreateHttpErrorResponse(int nStatusCode)
+{
+	auto pReplyMessage = QSharedPointer<MCPHttpReplyMessage>::create(QSharedPointer<MCPServerMessage>(), MCPMessageType::StreamableTransport);
+	pReplyMessage->m_nHttpStatusCode = nStatusCode;
+	return pReplyMessage;
+}
+
 QByteArray MCPHttpReplyMessage::toData()
 {
+	if (m_nHttpStatusCode != 0)
+	{
+		return MCPHttpResponseBuilder::buildErrorResponse(m_nHttpStatusCode);
+	}
+
+	// Streamable的GET事件流：打开时只发送响应头，之后每条通知是一个SSE事件
+	if ((m_flags & MCPMessageType::StreamableTransport) && (m_flags & MCPMessageType::StreamableEventStream))
+	{
+		if (m_flags & MCPMessageType::Connect)
+		{
+			return toStreamableEventStreamData();
+		}
+		return toStreamableEventData();
+	}
+
 	if (m_flags & MCPMessageType::Connect)
 	{
 		return toSseConnectResponseData();
@@ -72,6 +97,89 @@ QByteArray MCPHttpReplyMessage::toData()
 	return toAcceptData();
 }
 
+QSharedPointer<MCPHttpStreamedResponse> MCPHttpReplyMessage::createStreamedResponse(QByteArray& arrHead)
+{
+	// 只有resources/read的响应会带流式内容，与toData()中的响应分支对应
+	if (m_nHttpStatusCode != 0 || m_pServerMessage == nullptr || !m_pServerMessage->hasStreamedContents()
+		|| (m_flags & MCPMessageType::StreamableEventStream) || (m_flags & MCPMessageType::Connect)
+		|| !(m_flags & MCPMessageType::Response))
+	{
+		return QSharedPointer<MCPHttpStreamedResponse>();
+	}
+
+	QByteArray arrTail;
+	bool bChunked = false;
+	if (m_flags & MCPMessageType::SseTransport)
+	{
+		// SSE通道：消息数据是一条事件，不需要长度
+		arrHead = MCPHttpResponseBuilder::buildSseMessageResponseHead();
+		arrTail = MCPHttpResponseBuilder::buildSseEventEnd();
+	}
+	else if (m_flags & MCPMessageType::StreamableTransport)
+	{
+		auto pContext = m_pServerMessage->getContext();
+		auto pSession = pContext ? pContext->getSession() : QSharedPointer<MCPSession>();
+		if (pSession == nullptr)
+		{
+			return QSharedPointer<MCPHttpStreamedResponse>();
+		}
+		// 文本内容转义后的长度事先无法确定，按分块编码发送
+		arrHead = MCPHttpResponseBuilder::buildStreamableChunkedResponseHead(pSession);
+		bChunked = true;
+	}
+	else
+	{
+		return QSharedPointer<MCPHttpStreamedResponse>();
+	}
+
+	auto pBody = m_pServerMessage->createStreamedBody();
+	if (pBody == nullptr)
+	{
+		arrHead.clear();
+		return QSharedPointer<MCPHttpStreamedResponse>();
+	}
+	return QSharedPointer<MCPHttpStreamedResponse>::create(pBody, arrTail, bChunked);
+}
+
+bool MCPHttpReplyMessage::isPushNotification() const
+{
+	if (m_pServerMessage == nullptr || !(m_flags & MCPMessageType::RequestNotification))
+	{
+		return false;
+	}
+	return (m_flags & MCPMessageType::SseTransport) || (m_flags & MCPMessageType::StreamableEventStream);
+}
+
+QString MCPHttpReplyMessage::getNotificationMethod() const
+{
+	if (m_pServerMessage == nullptr)
+	{
+		return QString();
+	}
+	return m_pServerMessage->getRpcValue().toObject().value("method").toString();
+}
+
+QString MCPHttpReplyMessage::getNotificationUri() const
+{
+	if (m_pServerMessage == nullptr)
+	{
+		return QString();
+	}
+	return m_pServerMessage->getRpcValue().toObject().value("params").toObject().value("uri").toString();
+}
+
+QByteArray MCPHttpReplyMessage::toBareNotificationData() const
+{
+	if (!isPushNotification())
+	{
+		return QByteArray();
+	}
+	QJsonObject objNotification = m_pServerMessage->getRpcValue().toObject();
+	objNotification.remove("params");
+	auto pBareMessage = QSharedPointer<MCPServerMessage>::create(objNotification, m_flags);
+	return MCPHttpReplyMessage(pBareMessage, m_flags).toData();
+}
+
 QByteArray MCPHttpReplyMessage::toSseConnectResponseData()
 {
 	if (m_pServerMessage == nullptr || m_pServerMessage->getContext() == nullptr)
@@ -154,6 +262,26 @@ QByteArray MCPHttpReplyMessage::toStreamableNotificationData()
 	return MCPHttpResponseBuilder::buildStreamableResponse(rpcResponseData, pSession);
 }
 
+QByteArray MCPHttpReplyMessage::toStreamableEventStreamData()
+{
+	if (m_pServerMessage == nullptr || m_pServerMessage->getContext() == nullptr)
+	{
+		return QByteArray();
+	}
+
+	return MCPHttpResponseBuilder::buildStreamableEventStreamResponse(m_pServerMessage->getContext()->getSession());
+}
+
+QByteArray MCPHttpReplyMessage::toStreamableEventData()
+{
+	if (m_pServerMessage == nullptr)
+	{
+		return QByteArray();
+	}
+
+	return MCPHttpResponseBuilder::buildSseEvent(m_pServerMessage->toData());
+}
+
 QByteArray MCPHttpReplyMessage::toAcceptData()
 {
 	return MCPHttpResponseBuilder::buildAcceptResponse();
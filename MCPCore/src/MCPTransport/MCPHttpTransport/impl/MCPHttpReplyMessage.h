@@ -12,6 +12,8 @@
 #include "MCPRouting/MCPContext.h"
 #include "MCPServerMessage.h"
 
+class MCPHttpStreamedResponse;
+
 class MCPHttpReplyMessage : public MCPServerMessage
 {
 public:
@@ -19,8 +21,20 @@ public:
 public:
 	static QSharedPointer<MCPHttpReplyMessage> CreateSseAcceptNotification();
 	static QSharedPointer<MCPHttpReplyMessage> CreateStreamableAcceptNotification();
+	// 不带消息体的HTTP错误响应（无法按JSON-RPC回复的请求，如事件流GET的会话不存在）
+	static QSharedPointer<MCPHttpReplyMessage> CreateHttpErrorResponse(int nStatusCode);
 public:
 	virtual QByteArray toData() override;
+	// 带大文件流式内容的响应：arrHead输出响应头，消息体由连接边编码边写出；
+	// 不需要流式写出或文件无法打开（已改为错误响应，按toData()发送）时返回空
+	QSharedPointer<MCPHttpStreamedResponse> createStreamedResponse(QByteArray& arrHead);
+public:
+	// 出站队列分类：是否为推送到长连接（SSE通道、Streamable事件流）的服务器通知
+	bool isPushNotification() const;
+	QString getNotificationMethod() const;
+	QString getNotificationUri() const;
+	// 去掉params后的同一通知帧（list_changed合并后使用）
+	QByteArray toBareNotificationData() const;
 private:
 	QByteArray toSseConnectResponseData();
 	QByteArray toSseRequestData();
@@ -29,10 +43,13 @@ private:
 	QByteArray toStreamableConnectData();
 	QByteArray toStreamableRequestData();
 	QByteArray toStreamableNotificationData();
+	QByteArray toStreamableEventStreamData();
+	QByteArray toStreamableEventData();
 private:
 	QByteArray toSseChannelData();
 	QByteArray toAcceptData();
 protected:
 	MCPMessageType::Flags m_flags;
 	QSharedPointer<MCPServerMessage>  m_pServerMessage;
+	int m_nHttpStatusCode;	// 非0时直接回复该HTTP状态码
 };
@@ -27,14 +27,9 @@ QByteArray MCPHttpResponseBuilder::buildSseConnectResponse(const QString& strSes
 QByteArray MCPHttpResponseBuilder::buildSseMessageResponse(const QByteArray& strMessageData)
 {
     QByteArray arrResponse;
-    arrResponse.append(buildSseHeaders());
-    arrResponse.append("\r\n");
-    
-    arrResponse.append("event: message");
-    arrResponse.append("\n");
-    arrResponse.append("data: ");
+    arrResponse.append(buildSseMessageResponseHead());
     arrResponse.append(strMessageData);
-    arrResponse.append("\n\n");
+    arrResponse.append(buildSseEventEnd());
     
     return arrResponse;
 }
@@ -64,6 +59,108 @@ QByteArray MCPHttpResponseBuilder::buildAcceptResponse()
     return arrResponse;
 }
 
+QByteArray MCPHttpResponseBuilder::buildErrorResponse(int nStatusCode)
+{
+    QString strReason;
+    switch (nStatusCode)
+    {
+    case 400:
+        strReason = "Bad Request";
+        break;
+    case 404:
+        strReason = "Not Found";
+        break;
+    default:
+        strReason = "Error";
+        break;
+    }
+    
+    QByteArray arrResponse;
+    arrResponse.append(QString("HTTP/1.1 %1 %2\r\n").arg(nStatusCode).arg(strReason).toUtf8());
+    arrResponse.append("Content-Length: 0\r\n");
+    arrResponse.append("Connection: keep-alive\r\n");
+    arrResponse.append(buildCorsHeaders());
+    arrResponse.append("\r\n");
+    
+    return arrResponse;
+}
+
+QByteArray MCPHttpResponseBuilder::buildStreamableEventStreamResponse(const QSharedPointer<MCPSession>& pSession)
+{
+    QByteArray arrResponse;
+    arrResponse.append(buildSseHeaders());
+    if (pSession)
+    {
+        arrResponse.append(QString("Mcp-Session-Id: %1\r\n").arg(pSession->getSessionId()).toUtf8());
+        if (!pSession->getProtocolVersion().isEmpty())
+        {
+            arrResponse.append(QString("MCP-Protocol-Version: %1\r\n").arg(pSession->getProtocolVersion()).toUtf8());
+        }
+    }
+    arrResponse.append("\r\n");
+    
+    return arrResponse;
+}
+
+QByteArray MCPHttpResponseBuilder::buildSseEvent(const QByteArray& strMessageData)
+{
+    QByteArray arrEvent;
+    arrEvent.append("event: message");
+    arrEvent.append("\n");
+    arrEvent.append("data: ");
+    arrEvent.append(strMessageData);
+    arrEvent.append("\n\n");
+    
+    return arrEvent;
+}
+
+QByteArray MCPHttpResponseBuilder::buildStreamableChunkedResponseHead(const QSharedPointer<MCPSession>& pSession)
+{
+    QString strSessionId = pSession ? pSession->getSessionId() : QString();
+    QString strProtocolVersion = pSession ? pSession->getProtocolVersion() : QString();
+    
+    QByteArray arrResponse;
+    arrResponse.append(buildStreamableHeaders(-1, strSessionId, strProtocolVersion));
+    arrResponse.append("\r\n");
+    
+    return arrResponse;
+}
+
+QByteArray MCPHttpResponseBuilder::buildSseMessageResponseHead()
+{
+    QByteArray arrResponse;
+    arrResponse.append(buildSseHeaders());
+    arrResponse.append("\r\n");
+    
+    arrResponse.append("event: message");
+    arrResponse.append("\n");
+    arrResponse.append("data: ");
+    
+    return arrResponse;
+}
+
+QByteArray MCPHttpResponseBuilder::buildSseEventEnd()
+{
+    return QByteArray("\n\n");
+}
+
+QByteArray MCPHttpResponseBuilder::buildChunk(const QByteArray& arrData)
+{
+    QByteArray arrChunk;
+    arrChunk.reserve(arrData.size() + 16);
+    arrChunk.append(QByteArray::number(arrData.size(), 16));
+    arrChunk.append("\r\n");
+    arrChunk.append(arrData);
+    arrChunk.append("\r\n");
+    
+    return arrChunk;
+}
+
+QByteArray MCPHttpResponseBuilder::buildLastChunk()
+{
+    return QByteArray("0\r\n\r\n");
+}
+
 QByteArray MCPHttpResponseBuilder::buildSseHeaders()
 {
     QByteArray arrHeaders;
@@ -76,12 +173,19 @@ QByteArray MCPHttpResponseBuilder::buildSseHeaders()
     return arrHeaders;
 }
 
-QByteArray MCPHttpResponseBuilder::buildStreamableHeaders(int nContentLength, const QString& strSessionId, const QString& strProtocolVersion)
+QByteArray MCPHttpResponseBuilder::buildStreamableHeaders(qint64 nContentLength, const QString& strSessionId, const QString& strProtocolVersion)
 {
     QByteArray arrHeaders;
     arrHeaders.append("HTTP/1.1 200 OK\r\n");
     arrHeaders.append("Content-Type: application/json\r\n");
-    arrHeaders.append(QString("Content-Length: %1\r\n").arg(nContentLength).toUtf8());
+    if (nContentLength < 0)
+    {
+        arrHeaders.append("Transfer-Encoding: chunked\r\n");
+    }
+    else
+    {
+        arrHeaders.append(QString("Content-Length: %1\r\n").arg(nContentLength).toUtf8());
+    }
     
     if (!strSessionId.isEmpty())
     {
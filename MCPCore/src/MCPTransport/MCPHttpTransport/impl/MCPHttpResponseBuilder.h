@@ -56,6 +56,56 @@ public:
      */
     static QByteArray buildAcceptResponse();
 
+    /**
+     * @brief 构建不带消息体的HTTP错误响应（如 400 Bad Request、404 Not Found）
+     * @param nStatusCode HTTP状态码
+     * @return HTTP响应数据
+     */
+    static QByteArray buildErrorResponse(int nStatusCode);
+
+    /**
+     * @brief 构建Streamable事件流（GET /mcp）的响应头
+     * @param pSession 会话对象（用于获取SessionId和ProtocolVersion）
+     * @return HTTP响应头，之后连接保持打开，逐个写入SSE事件
+     */
+    static QByteArray buildStreamableEventStreamResponse(const QSharedPointer<MCPSession>& pSession);
+
+    /**
+     * @brief 构建单个SSE事件（不含HTTP响应头，用于已打开的事件流）
+     * @param strMessageData 消息数据（JSON格式）
+     * @return SSE事件数据
+     */
+    static QByteArray buildSseEvent(const QByteArray& strMessageData);
+
+    /**
+     * @brief 构建消息数据分块写出的Streamable响应头（Transfer-Encoding: chunked）
+     * @param pSession 会话对象（用于获取SessionId和ProtocolVersion）
+     * @return HTTP响应头，之后以buildChunk()逐块写出消息数据，以buildLastChunk()结束
+     */
+    static QByteArray buildStreamableChunkedResponseHead(const QSharedPointer<MCPSession>& pSession);
+
+    /**
+     * @brief 构建SSE消息响应中消息数据之前的部分
+     * @return 与buildSseMessageResponse()相同的前缀，之后写出消息数据，以buildSseEventEnd()结束
+     */
+    static QByteArray buildSseMessageResponseHead();
+
+    /**
+     * @brief 构建SSE事件的结束标记
+     */
+    static QByteArray buildSseEventEnd();
+
+    /**
+     * @brief 构建一个HTTP分块（chunked编码）
+     * @param arrData 分块数据，不能为空（空分块表示结束）
+     */
+    static QByteArray buildChunk(const QByteArray& arrData);
+
+    /**
+     * @brief 构建HTTP分块编码的结束标记
+     */
+    static QByteArray buildLastChunk();
+
 private:
     /**
      * @brief 构建SSE响应头
@@ -65,12 +115,12 @@ private:
 
     /**
      * @brief 构建Streamable响应头
-     * @param nContentLength 内容长度
+     * @param nContentLength 内容长度，小于0表示分块编码（Transfer-Encoding: chunked）
      * @param strSessionId 会话ID
      * @param strProtocolVersion 协议版本
      * @return Streamable响应头
      */
-    static QByteArray buildStreamableHeaders(int nContentLength, const QString& strSessionId, const QString& strProtocolVersion);
+    static QByteArray buildStreamableHeaders(qint64 nContentLength, const QString& strSessionId, const QString& strProtocolVersion);
 
     /**
      * @brief 构建通用CORS头
@@ -0,0 +1,65 @@
+/**
+ * @file MCPHttpStreamedResponse.cpp
+ * @brief 边编码边写出的HTTP响应体实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPHttpStreamedResponse.h"
+#include "MCPHttpResponseBuilder.h"
+#include "Utils/MCPStreamedBody.h"
+
+MCPHttpStreamedResponse::MCPHttpStreamedResponse(const QSharedPointer<MCPStreamedBody>& pBody, const QByteArray& arrTail, bool bChunked)
+    : m_pBody(pBody)
+    , m_arrTail(arrTail)
+    , m_bChunked(bChunked)
+    , m_bAtEnd(false)
+{
+}
+
+bool MCPHttpStreamedResponse::readNext(QByteArray& arrData)
+{
+    arrData.clear();
+    if (m_bAtEnd)
+    {
+        return true;
+    }
+
+    if (!m_pBody->isAtEnd())
+    {
+        QByteArray arrChunk;
+        if (!m_pBody->readChunk(arrChunk))
+        {
+            m_pBody->close();
+            return false;
+        }
+        // 空分块表示分块编码结束，不能写出
+        if (!arrChunk.isEmpty())
+        {
+            arrData = m_bChunked ? MCPHttpResponseBuilder::buildChunk(arrChunk) : arrChunk;
+        }
+        return true;
+    }
+
+    if (!m_arrTail.isEmpty())
+    {
+        arrData = m_bChunked ? MCPHttpResponseBuilder::buildChunk(m_arrTail) : m_arrTail;
+    }
+    if (m_bChunked)
+    {
+        arrData.append(MCPHttpResponseBuilder::buildLastChunk());
+    }
+    m_bAtEnd = true;
+    return true;
+}
+
+bool MCPHttpStreamedResponse::isAtEnd() const
+{
+    return m_bAtEnd;
+}
+
+qint64 MCPHttpStreamedResponse::getSizeHint() const
+{
+    return m_pBody->getSizeHint() + m_arrTail.size();
+}
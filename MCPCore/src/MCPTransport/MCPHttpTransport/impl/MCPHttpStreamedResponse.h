@@ -0,0 +1,63 @@
+/**
+ * @file MCPHttpStreamedResponse.h
+ * @brief 边编码边写出的HTTP响应体（大文件资源读取）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QByteArray>
+#include <QSharedPointer>
+
+class MCPStreamedBody;
+
+/**
+ * @brief 边编码边写出的HTTP响应体
+ *
+ * 职责：
+ * - 按块读取MCPStreamedBody，按HTTP分块编码（Streamable响应）或原样（SSE通道）封装后交给连接写出
+ * - 连接在套接字待写字节低于高水位时才读取下一块，任意时刻只有少量编码后的数据在内存中
+ *
+ * 使用说明：
+ * - 由MCPHttpReplyMessage::createStreamedResponse()创建，响应头放在出站数据帧的data中
+ * - 对象带读取状态，只属于一个连接，不能在多个连接间共享
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPHttpStreamedResponse
+{
+public:
+    /**
+     * @param pBody 已打开的响应数据
+     * @param arrTail 响应数据之后的结束部分（如SSE事件结束标记）
+     * @param bChunked 是否按HTTP分块编码封装
+     */
+    MCPHttpStreamedResponse(const QSharedPointer<MCPStreamedBody>& pBody, const QByteArray& arrTail, bool bChunked);
+
+public:
+    /**
+     * @brief 读取下一段待写出的数据（已封装，可直接写入套接字）
+     * @return 文件读取失败时返回false，此时响应已不完整，连接只能断开
+     * @note 数据可能为空，以isAtEnd()判断是否结束
+     */
+    bool readNext(QByteArray& arrData);
+
+    /**
+     * @brief 是否已全部读出（包括结束部分）
+     */
+    bool isAtEnd() const;
+
+    /**
+     * @brief 获取响应数据大小的估计值（用于日志）
+     */
+    qint64 getSizeHint() const;
+
+private:
+    QSharedPointer<MCPStreamedBody> m_pBody;
+    QByteArray m_arrTail;
+    bool m_bChunked;
+    bool m_bAtEnd;
+};
@@ -0,0 +1,256 @@
+/**
+ * @file MCPBase64Encoder.cpp
+ * @brief MCP Base64编码器实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPBase64Encoder.h"
+#include <QtGlobal>
+#include <climits>
+
+// SIMD实现只在x86上启用；clang-cl既不支持MSVC的无属性内联函数用法，也不一定带运行时检测库，退化为标量
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+#define MCP_BASE64_SIMD
+#define MCP_BASE64_TARGET_SSSE3
+#define MCP_BASE64_TARGET_AVX2
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(Q_PROCESSOR_X86) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG)) && !defined(Q_CC_MSVC)
+#define MCP_BASE64_SIMD
+#define MCP_BASE64_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define MCP_BASE64_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // QByteArray可容纳的最大长度（分配大小上限为INT_MAX，留出数据头和结尾'\0'的空间）
+    const qint64 kMaxByteArraySize = INT_MAX - 64;
+
+    typedef char* (*EncodeFunc)(const char* pInput, qint64 nInputSize, char* pOutput);
+
+    struct EncoderBackend
+    {
+        EncodeFunc pEncode;
+        const char* szName;
+    };
+
+    const char kBase64Table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    char* encodeScalar(const char* pInput, qint64 nInputSize, char* pOutput)
+    {
+        const uchar* pData = reinterpret_cast<const uchar*>(pInput);
+        const uchar* pEnd = pData + nInputSize;
+        while (pEnd - pData >= 3)
+        {
+            const quint32 nValue = (quint32(pData[0]) << 16) | (quint32(pData[1]) << 8) | quint32(pData[2]);
+            pOutput[0] = kBase64Table[(nValue >> 18) & 0x3F];
+            pOutput[1] = kBase64Table[(nValue >> 12) & 0x3F];
+            pOutput[2] = kBase64Table[(nValue >> 6) & 0x3F];
+            pOutput[3] = kBase64Table[nValue & 0x3F];
+            pData += 3;
+            pOutput += 4;
+        }
+
+        const qint64 nRemain = pEnd - pData;
+        if (nRemain == 1)
+        {
+            const quint32 nValue = quint32(pData[0]) << 16;
+            pOutput[0] = kBase64Table[(nValue >> 18) & 0x3F];
+            pOutput[1] = kBase64Table[(nValue >> 12) & 0x3F];
+            pOutput[2] = '=';
+            pOutput[3] = '=';
+            pOutput += 4;
+        }
+        else if (nRemain == 2)
+        {
+            const quint32 nValue = (quint32(pData[0]) << 16) | (quint32(pData[1]) << 8);
+            pOutput[0] = kBase64Table[(nValue >> 18) & 0x3F];
+            pOutput[1] = kBase64Table[(nValue >> 12) & 0x3F];
+            pOutput[2] = kBase64Table[(nValue >> 6) & 0x3F];
+            pOutput[3] = '=';
+            pOutput += 4;
+        }
+        return pOutput;
+    }
+
+#ifdef MCP_BASE64_SIMD
+    /**
+     * 12字节输入编码为16个字符（W. Muła的pshufb方法）：
+     * 1. 重排字节，使每个32位组按大端顺序含3个输入字节
+     * 2. 用16位乘法代替移位，一次取出每组的4个6位索引
+     * 3. 按索引区间（A-Z、a-z、0-9、+、/）查表得到ASCII偏移量，与索引相加
+     */
+    MCP_BASE64_TARGET_SSSE3 inline __m128i encodeBlockSsse3(__m128i input)
+    {
+        const __m128i shuffled = _mm_shuffle_epi8(input, _mm_set_epi8(
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        const __m128i t0 = _mm_and_si128(shuffled, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(shuffled, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t1, t3);
+
+        // 52..63映射为1..12，0..25映射为13，26..51映射为0
+        __m128i lutIndex = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i lessThan26 = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        lutIndex = _mm_or_si128(lutIndex, _mm_and_si128(lessThan26, _mm_set1_epi8(13)));
+        const __m128i offsetLut = _mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        return _mm_add_epi8(_mm_shuffle_epi8(offsetLut, lutIndex), indices);
+    }
+
+    MCP_BASE64_TARGET_SSSE3 char* encodeSsse3(const char* pInput, qint64 nInputSize, char* pOutput)
+    {
+        // 每次读16字节、只消耗12字节，剩余不足16字节时交给标量实现
+        while (nInputSize >= 16)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), encodeBlockSsse3(input));
+            pInput += 12;
+            nInputSize -= 12;
+            pOutput += 16;
+        }
+        return encodeScalar(pInput, nInputSize, pOutput);
+    }
+
+    MCP_BASE64_TARGET_AVX2 inline __m256i encodeBlockAvx2(__m256i input)
+    {
+        // 与SSSE3版本相同，两个128位通道各处理12字节
+        const __m256i shuffled = _mm256_shuffle_epi8(input, _mm256_set_epi8(
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        const __m256i t0 = _mm256_and_si256(shuffled, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(shuffled, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i lutIndex = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i lessThan26 = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        lutIndex = _mm256_or_si256(lutIndex, _mm256_and_si256(lessThan26, _mm256_set1_epi8(13)));
+        const __m256i offsetLut = _mm256_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        return _mm256_add_epi8(_mm256_shuffle_epi8(offsetLut, lutIndex), indices);
+    }
+
+    MCP_BASE64_TARGET_AVX2 char* encodeAvx2(const char* pInput, qint64 nInputSize, char* pOutput)
+    {
+        // 低通道读[0,16)、高通道读[12,28)，每次消耗24字节，不会读越界
+        while (nInputSize >= 28)
+        {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 12));
+            const __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOutput), encodeBlockAvx2(input));
+            pInput += 24;
+            nInputSize -= 24;
+            pOutput += 32;
+        }
+        return encodeSsse3(pInput, nInputSize, pOutput);
+    }
+#endif
+
+    EncoderBackend detectBackend()
+    {
+        EncoderBackend backend = { encodeScalar, "scalar" };
+#if defined(MCP_BASE64_SIMD) && defined(Q_CC_MSVC)
+        int arrInfo[4];
+        __cpuid(arrInfo, 0);
+        const int nMaxLeaf = arrInfo[0];
+        __cpuid(arrInfo, 1);
+        const bool bSsse3 = (arrInfo[2] & (1 << 9)) != 0;
+        // AVX2还需要操作系统保存YMM寄存器（OSXSAVE且XCR0的SSE/AVX位均已开启）
+        const bool bOsAvx = (arrInfo[2] & (1 << 27)) != 0 && (arrInfo[2] & (1 << 28)) != 0
+            && (_xgetbv(0) & 0x6) == 0x6;
+        bool bAvx2 = false;
+        if (bOsAvx && nMaxLeaf >= 7)
+        {
+            __cpuidex(arrInfo, 7, 0);
+            bAvx2 = (arrInfo[1] & (1 << 5)) != 0;
+        }
+        if (bAvx2)
+        {
+            backend.pEncode = encodeAvx2;
+            backend.szName = "avx2";
+        }
+        else if (bSsse3)
+        {
+            backend.pEncode = encodeSsse3;
+            backend.szName = "ssse3";
+        }
+#elif defined(MCP_BASE64_SIMD)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            backend.pEncode = encodeAvx2;
+            backend.szName = "avx2";
+        }
+        else if (__builtin_cpu_supports("ssse3"))
+        {
+            backend.pEncode = encodeSsse3;
+            backend.szName = "ssse3";
+        }
+#endif
+        return backend;
+    }
+
+    const EncoderBackend& currentBackend()
+    {
+        static const EncoderBackend s_backend = detectBackend();
+        return s_backend;
+    }
+}
+
+qint64 MCPBase64Encoder::encodedSize(qint64 nInputSize)
+{
+    return (nInputSize + 2) / 3 * 4;
+}
+
+char* MCPBase64Encoder::encode(const char* pInput, qint64 nInputSize, char* pOutput)
+{
+    if (nInputSize <= 0)
+    {
+        return pOutput;
+    }
+    return currentBackend().pEncode(pInput, nInputSize, pOutput);
+}
+
+bool MCPBase64Encoder::append(const char* pInput, qint64 nInputSize, QByteArray& arrOutput)
+{
+    if (nInputSize <= 0)
+    {
+        return true;
+    }
+    // QByteArray长度为int，编码结果（输入的4/3）超过上限时不能截断成负数或回绕后再resize
+    const int nOldSize = arrOutput.size();
+    const qint64 nNewSize = nOldSize + encodedSize(nInputSize);
+    if (nNewSize > kMaxByteArraySize)
+    {
+        return false;
+    }
+    arrOutput.resize(static_cast<int>(nNewSize));
+    encode(pInput, nInputSize, arrOutput.data() + nOldSize);
+    return true;
+}
+
+QByteArray MCPBase64Encoder::encode(const QByteArray& arrInput)
+{
+    QByteArray arrOutput;
+    if (!append(arrInput.constData(), arrInput.size(), arrOutput))
+    {
+        return QByteArray();
+    }
+    return arrOutput;
+}
+
+const char* MCPBase64Encoder::getBackendName()
+{
+    return currentBackend().szName;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file MCPBase64Encoder.h
+ * @brief MCP Base64编码器（SIMD加速，写入调用方提供的缓冲区）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QByteArray>
+
+/**
+ * @brief MCP Base64编码器
+ *
+ * 职责：
+ * - 标准Base64编码（RFC 4648，带'='填充），输出与QByteArray::toBase64()逐字节一致
+ * - 运行时检测CPU，依次选用AVX2（每次24字节）、SSSE3（每次12字节）或标量实现
+ * - 直接写入调用方提供的缓冲区，分块编码时不产生中间QByteArray
+ *
+ * 使用说明：
+ * - 调用方按encodedSize()预留输出空间，再调用encode()
+ * - 分块编码时除最后一块外，每块长度必须是3的倍数，否则中间会出现填充字符
+ * - 只依赖QtCore，性能基准程序直接编译本文件
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 指针类型添加 p 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPBase64Encoder
+{
+public:
+    /**
+     * @brief 计算编码后的长度（含填充）
+     */
+    static qint64 encodedSize(qint64 nInputSize);
+
+    /**
+     * @brief 编码到调用方提供的缓冲区
+     * @param pInput 输入数据
+     * @param nInputSize 输入长度
+     * @param pOutput 输出缓冲区，至少encodedSize(nInputSize)字节
+     * @return 写入结束位置（pOutput + encodedSize(nInputSize)）
+     */
+    static char* encode(const char* pInput, qint64 nInputSize, char* pOutput);
+
+    /**
+     * @brief 编码并追加到arrOutput末尾（只扩容一次，原地写入）
+     * @return 追加后超过QByteArray的大小上限时返回false（arrOutput不变）
+     */
+    static bool append(const char* pInput, qint64 nInputSize, QByteArray& arrOutput);
+
+    /**
+     * @brief 编码整个QByteArray
+     * @return 编码结果超过QByteArray的大小上限（输入约1.5GB）时返回空
+     */
+    static QByteArray encode(const QByteArray& arrInput);
+
+    /**
+     * @brief 获取当前使用的实现名称（"avx2"、"ssse3"或"scalar"）
+     */
+    static const char* getBackendName();
+};
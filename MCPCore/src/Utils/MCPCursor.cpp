@@ -0,0 +1,38 @@
+/**
+ * @file MCPCursor.cpp
+ * @brief MCP不透明游标实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPCursor.h"
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+QString MCPCursor::encode(const QJsonObject& objState)
+{
+    QByteArray arrJson = QJsonDocument(objState).toJson(QJsonDocument::Compact);
+    return QString::fromLatin1(arrJson.toBase64(QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
+}
+
+bool MCPCursor::decode(const QString& strCursor, QJsonObject& objState)
+{
+    if (strCursor.isEmpty())
+    {
+        return false;
+    }
+
+    QByteArray arrJson = QByteArray::fromBase64(strCursor.toLatin1(),
+        QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals);
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(arrJson, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject())
+    {
+        return false;
+    }
+
+    objState = doc.object();
+    return true;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file MCPCursor.h
+ * @brief MCP不透明游标（分页和分段读取的续读位置）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QJsonObject>
+
+/**
+ * @brief MCP不透明游标
+ *
+ * 职责：
+ * - 把续读状态（JSON对象）编码为不透明字符串，作为响应中的nextCursor返回给客户端
+ * - 解析客户端回传的cursor参数，格式非法时返回false，由调用方返回Invalid params错误
+ *
+ * 说明：
+ * - 编码格式为紧凑JSON的Base64url（无填充），客户端不应解析或构造游标
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPCursor
+{
+public:
+    /**
+     * @brief 编码游标
+     * @param objState 续读状态
+     * @return 不透明游标字符串
+     */
+    static QString encode(const QJsonObject& objState);
+
+    /**
+     * @brief 解析游标
+     * @param strCursor 客户端回传的游标
+     * @param objState 输出：续读状态
+     * @return 游标合法返回true
+     */
+    static bool decode(const QString& strCursor, QJsonObject& objState);
+};
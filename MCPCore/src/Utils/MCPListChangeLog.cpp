@@ -0,0 +1,144 @@
+/**
+ * @file MCPListChangeLog.cpp
+ * @brief MCP列表变更日志实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPListChangeLog.h"
+#include <QHash>
+#include <QJsonArray>
+#include <QMutexLocker>
+
+const quint64 MCPListChangeLog::kUnknownGeneration;
+
+MCPListChangeLog::MCPListChangeLog(int nCapacity, int nMaxDeltaSize)
+    : m_nGeneration(1)
+    , m_nCapacity(qMax(1, nCapacity))
+    , m_nMaxDeltaSize(qMax(1, nMaxDeltaSize))
+{
+}
+
+quint64 MCPListChangeLog::record(const QString& strKey, ChangeType enType)
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_nGeneration;
+    m_lstEntries.append(ChangeEntry{ m_nGeneration, strKey, enType });
+    while (m_lstEntries.size() > m_nCapacity)
+    {
+        m_lstEntries.removeFirst();
+    }
+    return m_nGeneration;
+}
+
+quint64 MCPListChangeLog::recordReset()
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_nGeneration;
+    m_lstEntries.clear();
+    return m_nGeneration;
+}
+
+quint64 MCPListChangeLog::getGeneration() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_nGeneration;
+}
+
+bool MCPListChangeLog::buildDelta(quint64 nSinceGeneration,
+                                  const std::function<QJsonObject(const QString&)>& entryFun,
+                                  QJsonObject& objDelta) const
+{
+    QStringList lstAdded;
+    QStringList lstRemoved;
+    QStringList lstChanged;
+    quint64 nGeneration = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        nGeneration = m_nGeneration;
+        if (nSinceGeneration == kUnknownGeneration || nSinceGeneration > m_nGeneration)
+        {
+            return false;
+        }
+        if (nSinceGeneration < m_nGeneration)
+        {
+            // 起始代数之后的第一条变更必须仍在保留窗口内
+            if (m_lstEntries.isEmpty() || m_lstEntries.first().nGeneration > nSinceGeneration + 1)
+            {
+                return false;
+            }
+        }
+
+        // 按键合并：首次操作决定变更前是否存在，最后一次操作决定变更后是否存在
+        QHash<QString, QPair<ChangeType, ChangeType>> dictNetChanges;
+        QStringList lstKeyOrder;
+        for (const auto& entry : m_lstEntries)
+        {
+            if (entry.nGeneration <= nSinceGeneration)
+            {
+                continue;
+            }
+            auto it = dictNetChanges.find(entry.strKey);
+            if (it == dictNetChanges.end())
+            {
+                dictNetChanges.insert(entry.strKey, qMakePair(entry.enType, entry.enType));
+                lstKeyOrder.append(entry.strKey);
+            }
+            else
+            {
+                it.value().second = entry.enType;
+            }
+        }
+
+        for (const QString& strKey : lstKeyOrder)
+        {
+            const auto& pairTypes = dictNetChanges[strKey];
+            bool bExistedBefore = pairTypes.first != ChangeType::Added;
+            bool bExistsAfter = pairTypes.second != ChangeType::Removed;
+            if (!bExistedBefore && bExistsAfter)
+            {
+                lstAdded.append(strKey);
+            }
+            else if (bExistedBefore && !bExistsAfter)
+            {
+                lstRemoved.append(strKey);
+            }
+            else if (bExistedBefore && bExistsAfter)
+            {
+                lstChanged.append(strKey);
+            }
+        }
+    }
+
+    if (lstAdded.size() + lstRemoved.size() + lstChanged.size() > m_nMaxDeltaSize)
+    {
+        return false;
+    }
+
+    QJsonArray arrAdded;
+    for (const QString& strKey : lstAdded)
+    {
+        QJsonObject objEntry = entryFun(strKey);
+        if (!objEntry.isEmpty())
+        {
+            arrAdded.append(objEntry);
+        }
+    }
+    QJsonArray arrChanged;
+    for (const QString& strKey : lstChanged)
+    {
+        QJsonObject objEntry = entryFun(strKey);
+        if (!objEntry.isEmpty())
+        {
+            arrChanged.append(objEntry);
+        }
+    }
+
+    objDelta = QJsonObject();
+    objDelta["generation"] = static_cast<qint64>(nGeneration);
+    objDelta["added"] = arrAdded;
+    objDelta["changed"] = arrChanged;
+    objDelta["removed"] = QJsonArray::fromStringList(lstRemoved);
+    return true;
+}
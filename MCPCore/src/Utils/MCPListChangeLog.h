@@ -0,0 +1,104 @@
+/**
+ * @file MCPListChangeLog.h
+ * @brief MCP列表变更日志（用于增量list_changed通知）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <functional>
+
+/**
+ * @brief MCP列表变更日志
+ *
+ * 职责：
+ * - 为工具/资源/提示词列表维护单调递增的代数（generation）
+ * - 记录有限条数的增删改条目，用于计算某代数之后的净变化
+ * - 代数差距超出保留窗口或变化过多时返回失败，由调用方退化为不带参数的list_changed
+ *
+ * 代数约定：
+ * - 初始代数为1，每次record()加1
+ * - 代数0保留为"未知"，表示会话尚未获取过列表
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPListChangeLog
+{
+public:
+    /**
+     * @brief 变更类型
+     */
+    enum class ChangeType
+    {
+        Added,      // 新增条目
+        Removed,    // 删除条目
+        Changed     // 覆盖/修改已有条目
+    };
+
+    static const quint64 kUnknownGeneration = 0;
+
+public:
+    /**
+     * @brief 构造函数
+     * @param nCapacity 保留的变更条目上限，超出后丢弃最旧条目
+     * @param nMaxDeltaSize 单次增量允许的最大条目数，超出时退化为不带参数的通知
+     */
+    explicit MCPListChangeLog(int nCapacity = 256, int nMaxDeltaSize = 64);
+
+public:
+    /**
+     * @brief 记录一次变更
+     * @param strKey 条目键（工具名、资源URI、提示词名）
+     * @param enType 变更类型
+     * @return 记录后的当前代数
+     */
+    quint64 record(const QString& strKey, ChangeType enType);
+
+    /**
+     * @brief 记录一次无法逐条描述的变更（如目录挂载下整棵子树变化）
+     * @return 记录后的当前代数
+     *
+     * 清空保留的变更条目，之前的代数都无法再计算增量，调用方退化为不带参数的list_changed
+     */
+    quint64 recordReset();
+
+    /**
+     * @brief 获取当前代数
+     */
+    quint64 getGeneration() const;
+
+    /**
+     * @brief 构建自指定代数以来的增量
+     * @param nSinceGeneration 起始代数（不包含）
+     * @param entryFun 按键获取条目JSON的回调（仅对added/changed条目调用）
+     * @param objDelta 输出：{generation, added:[...], changed:[...], removed:[key,...]}
+     * @return true表示增量可用；false表示代数未知、超出保留窗口或变化过多
+     */
+    bool buildDelta(quint64 nSinceGeneration,
+                    const std::function<QJsonObject(const QString&)>& entryFun,
+                    QJsonObject& objDelta) const;
+
+private:
+    struct ChangeEntry
+    {
+        quint64 nGeneration;
+        QString strKey;
+        ChangeType enType;
+    };
+
+private:
+    mutable QMutex m_mutex;
+    QList<ChangeEntry> m_lstEntries;    // 按代数递增排列的变更条目
+    quint64 m_nGeneration;              // 当前代数
+    int m_nCapacity;                    // 保留条目上限
+    int m_nMaxDeltaSize;                // 单次增量条目上限
+};
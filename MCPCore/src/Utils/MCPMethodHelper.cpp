@@ -18,6 +18,8 @@
 #include <QMetaMethod>
 #include <QCoreApplication>
 #include <QScopedPointer>
+#include <QVarLengthArray>
+#include <algorithm>
 QVariant MCPMethodHelper::syncCallMethod(QObject* pHandler, const QString& strMethodName, const QVariantList& lstArguments)
 {
 	if (pHandler->thread() == QThread::currentThread())
@@ -170,20 +172,16 @@ QVariant MCPMethodHelper::directCallMethod(QObject* pHandler, const QSharedPoint
 		return QVariant();
 	}
 
-	QVariant returnValue(QMetaType::type(pMetaMethod->typeName()), static_cast<void*>(nullptr));
-	QGenericReturnArgument returnArgument(pMetaMethod->typeName(), const_cast<void*>(returnValue.constData()));
-	pMetaMethod->invoke(pHandler, Qt::DirectConnection, returnArgument,
-		pLstMethodArguments->value(0),
-		pLstMethodArguments->value(1),
-		pLstMethodArguments->value(2),
-		pLstMethodArguments->value(3),
-		pLstMethodArguments->value(4),
-		pLstMethodArguments->value(5),
-		pLstMethodArguments->value(6),
-		pLstMethodArguments->value(7),
-		pLstMethodArguments->value(8),
-		pLstMethodArguments->value(9)
-	);
+	auto nReturnTypeId = QMetaType::type(pMetaMethod->typeName());
+	QVariant returnValue(nReturnTypeId, static_cast<void*>(nullptr));
+	// 通过 metacall 直接调用，参数个数不受 QMetaMethod::invoke 最多10个的限制
+	QVarLengthArray<void*, 16> vecArgv;
+	vecArgv.append((returnValue.isValid() && nReturnTypeId != QMetaType::Void) ? returnValue.data() : nullptr);
+	for (const auto& methodArgument : *pLstMethodArguments)
+	{
+		vecArgv.append(methodArgument.data());
+	}
+	QMetaObject::metacall(pHandler, QMetaObject::InvokeMetaMethod, pMetaMethod->methodIndex(), vecArgv.data());
 	qDebug().noquote() << "MainThread(" << (QThread::currentThread() == QCoreApplication::instance()->thread()) << ") "
 		<< "MCPMethodHelper::directCallMethod: " << pMetaMethod->name() << " = " << returnValue;
 	return returnValue;
@@ -223,3 +221,233 @@ bool MCPMethodHelper::customConvert(QVariant& inputArgument, int nMethodParamete
 	return false;
 }
 
+namespace
+{
+	// 通用转换：JSON -> QVariant -> 目标类型
+	bool convertGeneric(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		outValue = jsonValue.toVariant();
+		if (outValue.userType() == nTypeId)
+		{
+			return true;
+		}
+		return outValue.canConvert(nTypeId) && outValue.convert(nTypeId);
+	}
+
+	bool convertToString(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		if (jsonValue.isString())
+		{
+			outValue = jsonValue.toString();
+			return true;
+		}
+		return convertGeneric(jsonValue, nTypeId, outValue);
+	}
+
+	bool convertToBool(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		if (jsonValue.isBool())
+		{
+			outValue = jsonValue.toBool();
+			return true;
+		}
+		return convertGeneric(jsonValue, nTypeId, outValue);
+	}
+
+	bool convertToInt(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		if (jsonValue.isDouble())
+		{
+			outValue = qRound(jsonValue.toDouble());
+			return true;
+		}
+		return convertGeneric(jsonValue, nTypeId, outValue);
+	}
+
+	bool convertToLongLong(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		if (jsonValue.isDouble())
+		{
+			outValue = qRound64(jsonValue.toDouble());
+			return true;
+		}
+		return convertGeneric(jsonValue, nTypeId, outValue);
+	}
+
+	bool convertToDouble(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		if (jsonValue.isDouble())
+		{
+			outValue = jsonValue.toDouble();
+			return true;
+		}
+		return convertGeneric(jsonValue, nTypeId, outValue);
+	}
+
+	bool convertToJsonObject(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		if (jsonValue.isObject())
+		{
+			outValue = QVariant::fromValue(jsonValue.toObject());
+			return true;
+		}
+		return convertGeneric(jsonValue, nTypeId, outValue);
+	}
+
+	bool convertToJsonArray(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		if (jsonValue.isArray())
+		{
+			outValue = QVariant::fromValue(jsonValue.toArray());
+			return true;
+		}
+		return convertGeneric(jsonValue, nTypeId, outValue);
+	}
+
+	bool convertToJsonValue(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue)
+	{
+		Q_UNUSED(nTypeId);
+		outValue = QVariant::fromValue(jsonValue);
+		return true;
+	}
+}
+
+MCPMethodInvokePlan::MCPMethodInvokePlan()
+	: m_nMethodIndex(-1)
+	, m_nReturnTypeId(QMetaType::UnknownType)
+{
+}
+
+QSharedPointer<MCPMethodInvokePlan> MCPMethodInvokePlan::create(QObject* pHandler, const QString& strMethodName)
+{
+	if (pHandler == nullptr)
+	{
+		return QSharedPointer<MCPMethodInvokePlan>();
+	}
+	auto pMetaMethod = MCPMethodHelper::findMethod(pHandler, strMethodName);
+	if (pMetaMethod == nullptr)
+	{
+		return QSharedPointer<MCPMethodInvokePlan>();
+	}
+	QSharedPointer<MCPMethodInvokePlan> pPlan(new MCPMethodInvokePlan());
+	pPlan->m_metaMethod = *pMetaMethod;
+	pPlan->m_nMethodIndex = pMetaMethod->methodIndex();
+	pPlan->m_nReturnTypeId = pMetaMethod->returnType();
+	if (pPlan->m_nReturnTypeId == QMetaType::UnknownType)
+	{
+		qDebug().noquote() << "MCPMethodInvokePlan::create(return type error): " << pMetaMethod->typeName() << " = false";
+		return QSharedPointer<MCPMethodInvokePlan>();
+	}
+	auto lstParameterNames = pMetaMethod->parameterNames();
+	auto lstParameterTypes = pMetaMethod->parameterTypes();
+	pPlan->m_vecParameters.reserve(lstParameterTypes.size());
+	for (int i = 0; i < lstParameterTypes.size(); ++i)
+	{
+		ParameterPlan parameterPlan;
+		parameterPlan.strName = QString::fromUtf8(lstParameterNames.value(i));
+		parameterPlan.strTypeName = lstParameterTypes[i];
+		parameterPlan.nTypeId = pMetaMethod->parameterType(i);
+		if (parameterPlan.nTypeId == QMetaType::UnknownType)
+		{
+			qDebug().noquote() << "MCPMethodInvokePlan::create(arguments type error): " << parameterPlan.strTypeName << " = false";
+			return QSharedPointer<MCPMethodInvokePlan>();
+		}
+		parameterPlan.pConvertFun = selectConvertFun(parameterPlan.nTypeId);
+		pPlan->m_hashParameterIndex.insert(parameterPlan.strName, i);
+		pPlan->m_vecParameters.append(parameterPlan);
+	}
+	return pPlan;
+}
+
+MCPMethodInvokePlan::ConvertFun MCPMethodInvokePlan::selectConvertFun(int nTypeId)
+{
+	switch (nTypeId)
+	{
+	case QMetaType::QString:
+		return &convertToString;
+	case QMetaType::Bool:
+		return &convertToBool;
+	case QMetaType::Int:
+		return &convertToInt;
+	case QMetaType::LongLong:
+		return &convertToLongLong;
+	case QMetaType::Double:
+		return &convertToDouble;
+	case QMetaType::QJsonObject:
+		return &convertToJsonObject;
+	case QMetaType::QJsonArray:
+		return &convertToJsonArray;
+	case QMetaType::QJsonValue:
+		return &convertToJsonValue;
+	default:
+		return &convertGeneric;
+	}
+}
+
+QVariant MCPMethodInvokePlan::syncInvoke(QObject* pHandler, const QJsonObject& jsonArguments) const
+{
+	if (pHandler->thread() == QThread::currentThread())
+	{
+		return invoke(pHandler, jsonArguments);
+	}
+	QVariant retValue;
+	MCPInvokeHelper::syncInvoke(pHandler, [&]()
+		{
+			retValue = invoke(pHandler, jsonArguments);
+		});
+	return retValue;
+}
+
+QVariant MCPMethodInvokePlan::invoke(QObject* pHandler, const QJsonObject& jsonArguments) const
+{
+	if (pHandler == nullptr || m_nMethodIndex < 0)
+	{
+		return QVariant();
+	}
+	auto nParameterCount = m_vecParameters.size();
+	QVarLengthArray<QVariant, 16> vecValues(nParameterCount);
+	QVarLengthArray<bool, 16> vecAssigned(nParameterCount);
+	std::fill(vecAssigned.begin(), vecAssigned.end(), false);
+	// 按参数名把JSON参数转换到对应下标
+	for (auto it = jsonArguments.constBegin(); it != jsonArguments.constEnd(); ++it)
+	{
+		auto itIndex = m_hashParameterIndex.constFind(it.key());
+		if (itIndex == m_hashParameterIndex.constEnd())
+		{
+			qDebug().noquote() << "MCPMethodInvokePlan::invoke(arguments name error): " << it.key() << " = false";
+			return QVariant();
+		}
+		const auto& parameterPlan = m_vecParameters[itIndex.value()];
+		if (!parameterPlan.pConvertFun(it.value(), parameterPlan.nTypeId, vecValues[itIndex.value()]))
+		{
+			qDebug().noquote() << "MCPMethodInvokePlan::invoke(arguments type error): " << parameterPlan.strTypeName << " = false";
+			return QVariant();
+		}
+		vecAssigned[itIndex.value()] = true;
+	}
+	// 组装 metacall 参数表：argv[0] 为返回值，其余为参数
+	QVariant returnValue(m_nReturnTypeId, static_cast<void*>(nullptr));
+	QVarLengthArray<void*, 17> vecArgv(nParameterCount + 1);
+	vecArgv[0] = (m_nReturnTypeId != QMetaType::Void) ? returnValue.data() : nullptr;
+	for (int i = 0; i < nParameterCount; ++i)
+	{
+		if (!vecAssigned[i])
+		{
+			// 未提供的参数使用类型默认值
+			vecValues[i] = QVariant(m_vecParameters[i].nTypeId, static_cast<void*>(nullptr));
+		}
+		vecArgv[i + 1] = vecValues[i].data();
+	}
+	QMetaObject::metacall(pHandler, QMetaObject::InvokeMetaMethod, m_nMethodIndex, vecArgv.data());
+	return returnValue;
+}
+
+QString MCPMethodInvokePlan::getMethodName() const
+{
+	return QString::fromUtf8(m_metaMethod.name());
+}
+
+int MCPMethodInvokePlan::getParameterCount() const
+{
+	return m_vecParameters.size();
+}
@@ -12,9 +12,14 @@
 #include <QVariant>
 #include <QVariantMap>
 #include <QString>
+#include <QHash>
+#include <QVector>
+#include <QByteArray>
+#include <QMetaMethod>
 
-class QMetaMethod;
 class QObject;
+class QJsonValue;
+class QJsonObject;
 
 /**
  * @brief MCP方法助手类
@@ -45,5 +50,79 @@ private:
 private:
 	static bool customConvert(QVariant& inputArgument, int nMethodParameterType);
 
+private:
+	friend class MCPMethodInvokePlan;
+};
+
+/**
+ * @brief 预编译的方法调用计划
+ * 
+ * 职责：
+ * - 在注册时一次性解析 QMetaMethod 及其参数类型
+ * - 为每个参数预先选定 JSON -> 参数类型的转换函数
+ * - 调用时按计划把 JSON 参数直接转换到栈上缓冲区，再通过 metacall 调用
+ * - 不受 QMetaMethod::invoke 最多10个参数的限制
+ * 
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 指针类型添加 p 前缀
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPMethodInvokePlan
+{
+public:
+	/**
+	 * @brief 参数转换函数
+	 * @param jsonValue 输入的JSON值
+	 * @param nTypeId 目标参数类型ID
+	 * @param outValue 输出的参数值（类型为 nTypeId）
+	 * @return true表示转换成功
+	 */
+	typedef bool (*ConvertFun)(const QJsonValue& jsonValue, int nTypeId, QVariant& outValue);
+
+	/**
+	 * @brief 单个参数的调用计划
+	 */
+	struct ParameterPlan
+	{
+		QString strName;          // 参数名（对应JSON参数名）
+		QByteArray strTypeName;   // 参数类型名
+		int nTypeId;              // 参数类型ID
+		ConvertFun pConvertFun;   // 转换函数
+	};
+
+public:
+	/**
+	 * @brief 为处理器对象的方法创建调用计划
+	 * @param pHandler 处理器对象
+	 * @param strMethodName 方法名称
+	 * @return 调用计划，方法不存在或参数类型未注册时返回空指针
+	 */
+	static QSharedPointer<MCPMethodInvokePlan> create(QObject* pHandler, const QString& strMethodName);
+
+public:
+	/**
+	 * @brief 按计划同步调用方法（跨线程时阻塞等待处理器线程执行完成）
+	 * @param pHandler 处理器对象（必须与创建计划时的对象类型一致）
+	 * @param jsonArguments JSON参数对象（按参数名匹配）
+	 * @return 方法返回值，失败时返回无效的QVariant
+	 */
+	QVariant syncInvoke(QObject* pHandler, const QJsonObject& jsonArguments) const;
+
+	QString getMethodName() const;
+	int getParameterCount() const;
+
+private:
+	MCPMethodInvokePlan();
+	QVariant invoke(QObject* pHandler, const QJsonObject& jsonArguments) const;
+	static ConvertFun selectConvertFun(int nTypeId);
+
+private:
+	QMetaMethod m_metaMethod;
+	int m_nMethodIndex;
+	int m_nReturnTypeId;
+	QVector<ParameterPlan> m_vecParameters;
+	QHash<QString, int> m_hashParameterIndex;   // 参数名 -> 参数下标
 };
 
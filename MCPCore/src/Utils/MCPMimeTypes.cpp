@@ -0,0 +1,211 @@
+/**
+ * @file MCPMimeTypes.cpp
+ * @brief MCP MIME类型工具实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPMimeTypes.h"
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QMimeDatabase>
+#include <QMimeType>
+#include <QList>
+
+namespace
+{
+    // 除text/*外按文本传输的MIME类型（小写）
+    const char* const kTextMimeTypes[] = {
+        "application/json",
+        "application/xml",
+        "application/javascript",
+        "application/x-javascript",
+        "application/ecmascript",
+        "application/x-ecmascript",
+        "application/typescript",
+        "application/x-typescript",
+        "application/x-sh",
+        "application/x-shellscript",
+        "application/x-python",
+        "application/x-c",
+        "application/x-cpp",
+        "application/x-c++",
+        "application/x-csharp",
+        "application/x-java",
+        "application/x-html",
+        "application/x-css",
+        "application/x-sql",
+        "application/x-yaml",
+        "application/x-toml",
+        "application/x-markdown",
+        "application/x-svg+xml",
+        "application/x-json",
+        "application/x-ld+json",
+        "application/x-jsonld",
+        "application/x-rtf",
+        "application/x-rtfd",
+        "application/x-tex",
+        "application/x-latex",
+        "application/x-postscript",
+        "application/x-ps",
+        "application/x-eps"
+    };
+
+    const int kTextMimeTypeCount = sizeof(kTextMimeTypes) / sizeof(kTextMimeTypes[0]);
+
+    // 槽位数取表项数的8倍，随机种子下无冲突的概率约1/8，构建时很快找到可用种子
+    const int kSlotCount = 256;
+
+    const int kMaxCachedSuffixes = 4096;
+
+    /**
+     * FNV-1a哈希，逐字符按ASCII转小写，不生成小写副本
+     */
+    inline quint32 hashMimeType(const QChar* pData, int nSize, quint32 nSeed)
+    {
+        quint32 nHash = 2166136261u ^ nSeed;
+        for (int i = 0; i < nSize; ++i)
+        {
+            ushort ch = pData[i].unicode();
+            if (ch >= 'A' && ch <= 'Z')
+            {
+                ch = ushort(ch + ('a' - 'A'));
+            }
+            nHash = (nHash ^ ch) * 16777619u;
+        }
+        return nHash;
+    }
+
+    /**
+     * 文本MIME类型的完美哈希表：构建时选取使所有表项落入不同槽位的种子，
+     * 查询时只需比较槽位中唯一的候选项
+     */
+    class TextMimeTypeTable
+    {
+    public:
+        TextMimeTypeTable()
+            : m_nSeed(0)
+        {
+            Q_STATIC_ASSERT(kTextMimeTypeCount * 2 <= kSlotCount);
+            for (quint32 nSeed = 0; ; ++nSeed)
+            {
+                if (tryBuild(nSeed))
+                {
+                    m_nSeed = nSeed;
+                    break;
+                }
+            }
+        }
+
+        bool contains(const QString& strMimeType) const
+        {
+            const quint32 nSlot = hashMimeType(strMimeType.constData(), strMimeType.size(), m_nSeed) & (kSlotCount - 1);
+            const int nIndex = m_arrSlots[nSlot];
+            return nIndex >= 0
+                && strMimeType.compare(QLatin1String(kTextMimeTypes[nIndex]), Qt::CaseInsensitive) == 0;
+        }
+
+    private:
+        bool tryBuild(quint32 nSeed)
+        {
+            for (int i = 0; i < kSlotCount; ++i)
+            {
+                m_arrSlots[i] = -1;
+            }
+            for (int i = 0; i < kTextMimeTypeCount; ++i)
+            {
+                const QString strMimeType = QLatin1String(kTextMimeTypes[i]);
+                const quint32 nSlot = hashMimeType(strMimeType.constData(), strMimeType.size(), nSeed) & (kSlotCount - 1);
+                if (m_arrSlots[nSlot] >= 0)
+                {
+                    return false;
+                }
+                m_arrSlots[nSlot] = static_cast<qint8>(i);
+            }
+            return true;
+        }
+
+    private:
+        quint32 m_nSeed;
+        qint8 m_arrSlots[kSlotCount];   // 槽位 -> kTextMimeTypes下标，-1表示空
+    };
+
+    const TextMimeTypeTable& textMimeTypeTable()
+    {
+        static const TextMimeTypeTable s_table;
+        return s_table;
+    }
+
+    struct SuffixMimeCache
+    {
+        QMutex mutex;                               // 资源可能在多个线程中注册
+        QHash<QString, QString> dictMimeTypes;      // 扩展名 -> MIME类型
+    };
+
+    SuffixMimeCache& suffixMimeCache()
+    {
+        static SuffixMimeCache s_cache;
+        return s_cache;
+    }
+
+    const QMimeDatabase& mimeDatabase()
+    {
+        static const QMimeDatabase s_mimeDb;
+        return s_mimeDb;
+    }
+}
+
+bool MCPMimeTypes::isText(const QString& strMimeType)
+{
+    // 以text/开头的都是文本类型
+    if (strMimeType.startsWith(QLatin1String("text/"), Qt::CaseInsensitive))
+    {
+        return true;
+    }
+    return textMimeTypeTable().contains(strMimeType);
+}
+
+QString MCPMimeTypes::mimeTypeForFile(const QString& strFilePath, bool bMatchContent)
+{
+    // 用完整扩展名作为缓存键（"a.tar.gz"与"b.gz"对应的MIME类型不同），
+    // 不转小写：少数扩展名区分大小写（如"*.C"是C++源文件）
+    const QString strSuffix = QFileInfo(strFilePath).completeSuffix();
+    if (!strSuffix.isEmpty())
+    {
+        SuffixMimeCache& cache = suffixMimeCache();
+        {
+            QMutexLocker locker(&cache.mutex);
+            auto it = cache.dictMimeTypes.constFind(strSuffix);
+            if (it != cache.dictMimeTypes.constEnd())
+            {
+                return it.value();
+            }
+        }
+
+        // 扩展名只匹配一种MIME类型时，QMimeDatabase的默认方式也直接采用它，不读取文件内容，可以缓存
+        const QList<QMimeType> lstCandidates = mimeDatabase().mimeTypesForFileName(QLatin1String("x.") + strSuffix);
+        if (lstCandidates.size() == 1 && lstCandidates.first().isValid())
+        {
+            const QString strMimeType = lstCandidates.first().name();
+            QMutexLocker locker(&cache.mutex);
+            if (cache.dictMimeTypes.size() < kMaxCachedSuffixes)
+            {
+                cache.dictMimeTypes.insert(strSuffix, strMimeType);
+            }
+            return strMimeType;
+        }
+    }
+
+    // 无扩展名、扩展名未知或有歧义时需要结合文件内容判断，结果与具体文件有关，不缓存
+    if (!bMatchContent)
+    {
+        // 只按文件名匹配时，未命中返回的是默认类型（application/octet-stream），交给调用方决定
+        QMimeType mimeType = mimeDatabase().mimeTypeForFile(strFilePath, QMimeDatabase::MatchExtension);
+        return mimeType.isValid() && !mimeType.isDefault() ? mimeType.name() : QString();
+    }
+    QMimeType mimeType = mimeDatabase().mimeTypeForFile(strFilePath);
+    return mimeType.isValid() ? mimeType.name() : QString();
+}
@@ -0,0 +1,52 @@
+/**
+ * @file MCPMimeTypes.h
+ * @brief MCP MIME类型工具（文本/二进制判断、按扩展名缓存的MIME推断）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+
+/**
+ * @brief MCP MIME类型工具
+ *
+ * 职责：
+ * - 判断MIME类型是否按文本传输：text/前缀或命中文本类型表，表为首次使用时构建的完美哈希表，
+ *   查询时不分配内存（不生成小写副本），一次哈希加一次比较
+ * - 根据文件路径推断MIME类型：共享同一个QMimeDatabase，按扩展名缓存结果，
+ *   同一扩展名的大量文件注册时只查询一次
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPMimeTypes
+{
+public:
+    /**
+     * @brief 判断MIME类型是否为文本类型（大小写不敏感）
+     * @param strMimeType MIME类型
+     * @return 文本类型返回true，否则按二进制处理
+     */
+    static bool isText(const QString& strMimeType);
+
+    /**
+     * @brief 根据文件路径推断MIME类型
+     * @param strFilePath 文件路径
+     * @param bMatchContent 无法按扩展名确定时是否读取文件内容判断，false时只按文件名匹配
+     * @return MIME类型名称，无法推断时返回空字符串
+     *
+     * 扩展名只对应一种MIME类型时结果按扩展名缓存，不读取文件内容（只按扩展名判断，
+     * 不考虑CMakeLists.txt这类特定文件名的规则）；无扩展名、扩展名未知或对应多种类型时，
+     * 按QMimeDatabase默认方式（可能读取文件内容）逐个推断，不缓存
+     */
+    static QString mimeTypeForFile(const QString& strFilePath, bool bMatchContent = true);
+
+private:
+    // 禁止实例化，所有方法都是静态的
+    MCPMimeTypes() = delete;
+    ~MCPMimeTypes() = delete;
+};
@@ -7,6 +7,8 @@
  */
 
 #include "MCPResourceContentGenerator.h"
+#include "MCPBase64Encoder.h"
+#include "MCPMimeTypes.h"
 #include "MCPLog/MCPLog.h"
 #include <QFile>
 #include <QFileInfo>
@@ -78,53 +80,7 @@ QJsonObject MCPResourceContentGenerator::generateResourceContent(const QString&
 
 bool MCPResourceContentGenerator::isTextMimeType(const QString& strMimeType)
 {
-    // 文本类型MIME类型列表
-    QString strLowerMimeType = strMimeType.toLower();
-    
-    // 以text/开头的都是文本类型
-    if (strLowerMimeType.startsWith("text/"))
-    {
-        return true;
-    }
-    
-    // 常见的文本类型
-    static const QStringList commonTextMimeTypes = {
-        "application/json",
-        "application/xml",
-        "application/javascript",
-        "application/x-javascript",
-        "application/ecmascript",
-        "application/x-ecmascript",
-        "application/typescript",
-        "application/x-typescript",
-        "application/x-sh",
-        "application/x-shellscript",
-        "application/x-python",
-        "application/x-c",
-        "application/x-cpp",
-        "application/x-c++",
-        "application/x-csharp",
-        "application/x-java",
-        "application/x-html",
-        "application/x-css",
-        "application/x-sql",
-        "application/x-yaml",
-        "application/x-toml",
-        "application/x-markdown",
-        "application/x-svg+xml",
-        "application/x-json",
-        "application/x-ld+json",
-        "application/x-jsonld",
-        "application/x-rtf",
-        "application/x-rtfd",
-        "application/x-tex",
-        "application/x-latex",
-        "application/x-postscript",
-        "application/x-ps",
-        "application/x-eps"
-    };
-    
-    return commonTextMimeTypes.contains(strLowerMimeType);
+    return MCPMimeTypes::isText(strMimeType);
 }
 
 QString MCPResourceContentGenerator::readFileAsText(const QString& strFilePath)
@@ -170,7 +126,8 @@ QString MCPResourceContentGenerator::readFileAsBase64(const QString& strFilePath
 
 QString MCPResourceContentGenerator::base64Encode(const QByteArray& data)
 {
-    return QString::fromLatin1(data.toBase64());
+    // SIMD编码（与QByteArray::toBase64()输出一致）
+    return QString::fromLatin1(MCPBase64Encoder::encode(data));
 }
 
 QString MCPResourceContentGenerator::generateUriFromFilePath(const QString& strFilePath)
@@ -0,0 +1,44 @@
+/**
+ * @file MCPResourceUpdatedParams.cpp
+ * @brief notifications/resources/updated 参数构建实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPResourceUpdatedParams.h"
+#include "IMCPResourceService.h"
+
+QJsonObject MCPResourceUpdatedParams::build(IMCPResourceService* pResourceService,
+                                            const QString& strUri,
+                                            const QJsonObject& metadata,
+                                            bool bInlineContent)
+{
+    QJsonObject params;
+    params["uri"] = strUri;
+
+    if (metadata.isEmpty())
+    {
+        QJsonObject resourceData;
+        resourceData["deleted"] = true;
+        params["data"] = resourceData;
+        return params;
+    }
+
+    // 按MCP规范只需要uri，客户端自行调用resources/read获取内容
+    if (!bInlineContent)
+    {
+        return params;
+    }
+
+    // 读取资源内容和元数据（name、description、mimeType）
+    QJsonObject resourceInfo = pResourceService->readResource(strUri);
+    resourceInfo["name"] = metadata["name"];
+    resourceInfo["description"] = metadata["description"];
+    resourceInfo["mimeType"] = metadata["mimeType"];
+
+    QJsonObject resourceData;
+    resourceData["resource"] = resourceInfo;
+    params["data"] = resourceData;
+    return params;
+}
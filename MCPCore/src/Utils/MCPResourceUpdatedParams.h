@@ -0,0 +1,47 @@
+/**
+ * @file MCPResourceUpdatedParams.h
+ * @brief notifications/resources/updated 参数构建（内部实现）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QJsonObject>
+
+class IMCPResourceService;
+
+/**
+ * @brief notifications/resources/updated 参数构建
+ *
+ * 职责：
+ * - 构建资源更新通知的params：默认只携带uri，开启内联内容时读取资源并携带内容和元数据
+ * - 只依赖 IMCPResourceService 公开接口，资源通知处理器和性能基准程序共用同一份实现
+ *
+ * 编码规范：
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPResourceUpdatedParams
+{
+public:
+    /**
+     * @brief 构建资源更新通知参数
+     * @param pResourceService 资源服务
+     * @param strUri 资源URI
+     * @param metadata 资源元数据（name、description、mimeType），为空表示资源已不存在
+     * @param bInlineContent 是否内联资源内容（resourceUpdateInlineContent）
+     * @return 默认为 {"uri"}；内联内容时为 {"uri", "data": {"resource": 内容和元数据}}；
+     *         资源已不存在时为 {"uri", "data": {"deleted": true}}
+     */
+    static QJsonObject build(IMCPResourceService* pResourceService,
+                             const QString& strUri,
+                             const QJsonObject& metadata,
+                             bool bInlineContent);
+
+private:
+    // 禁止实例化，所有方法都是静态的
+    MCPResourceUpdatedParams() = delete;
+    ~MCPResourceUpdatedParams() = delete;
+};
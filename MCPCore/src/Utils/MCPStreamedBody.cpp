@@ -0,0 +1,150 @@
+/**
+ * @file MCPStreamedBody.cpp
+ * @brief 包含大文件流式内容的响应数据实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPStreamedBody.h"
+#include "MCPStreamedFileContent.h"
+#include "MCPLog/MCPLog.h"
+#include <QPair>
+#include <algorithm>
+
+const int MCPStreamedBody::kMaxBufferedBytes;
+
+MCPStreamedBody::MCPStreamedBody(const QByteArray& arrData, const QList<QSharedPointer<MCPStreamedFileContent>>& lstContents)
+    : m_nNextSegment(0)
+    , m_bInContent(false)
+{
+    // 找到各占位符的位置并按出现顺序排列
+    QList<QPair<int, QSharedPointer<MCPStreamedFileContent>>> lstPositions;
+    for (const auto& pContent : lstContents)
+    {
+        if (pContent == nullptr)
+        {
+            continue;
+        }
+        int nIndex = arrData.indexOf(pContent->getPlaceholder());
+        if (nIndex >= 0)
+        {
+            lstPositions.append(qMakePair(nIndex, pContent));
+        }
+    }
+    std::sort(lstPositions.begin(), lstPositions.end(),
+        [](const QPair<int, QSharedPointer<MCPStreamedFileContent>>& left, const QPair<int, QSharedPointer<MCPStreamedFileContent>>& right)
+    {
+        return left.first < right.first;
+    });
+
+    int nCopied = 0;
+    for (const auto& position : lstPositions)
+    {
+        m_lstSegments.append(arrData.mid(nCopied, position.first - nCopied));
+        m_lstContents.append(position.second);
+        nCopied = position.first + position.second->getPlaceholder().size();
+    }
+    m_lstSegments.append(arrData.mid(nCopied));
+}
+
+MCPStreamedBody::~MCPStreamedBody()
+{
+    close();
+}
+
+bool MCPStreamedBody::open()
+{
+    m_nNextSegment = 0;
+    m_bInContent = false;
+    for (const auto& pContent : m_lstContents)
+    {
+        // 只检查能否打开，读到该内容时再重新打开，避免多个大文件同时占用句柄和映射
+        if (!pContent->open())
+        {
+            return false;
+        }
+        pContent->close();
+    }
+    return true;
+}
+
+void MCPStreamedBody::close()
+{
+    for (const auto& pContent : m_lstContents)
+    {
+        pContent->close();
+    }
+}
+
+bool MCPStreamedBody::readChunk(QByteArray& arrOutput)
+{
+    if (m_bInContent)
+    {
+        const auto& pContent = m_lstContents.at(m_nNextSegment - 1);
+        if (!pContent->isAtEnd())
+        {
+            return pContent->readChunk(arrOutput);
+        }
+        m_bInContent = false;
+    }
+
+    if (m_nNextSegment >= m_lstSegments.size())
+    {
+        return true;
+    }
+    arrOutput.append(m_lstSegments.at(m_nNextSegment));
+    ++m_nNextSegment;
+    if (m_nNextSegment <= m_lstContents.size())
+    {
+        // 片段之后是流式内容，文件在open()中检查过，此时才真正打开
+        m_bInContent = true;
+        return m_lstContents.at(m_nNextSegment - 1)->open();
+    }
+    return true;
+}
+
+bool MCPStreamedBody::isAtEnd() const
+{
+    return !m_bInContent && m_nNextSegment >= m_lstSegments.size();
+}
+
+qint64 MCPStreamedBody::getSizeHint() const
+{
+    qint64 nSize = 0;
+    for (const auto& segment : m_lstSegments)
+    {
+        nSize += segment.size();
+    }
+    for (const auto& pContent : m_lstContents)
+    {
+        nSize += pContent->getEncodedSizeHint();
+    }
+    return nSize;
+}
+
+bool MCPStreamedBody::readAll(QByteArray& arrOutput)
+{
+    if (getSizeHint() > kMaxBufferedBytes)
+    {
+        MCP_CORE_LOG_WARNING() << "MCPStreamedBody: 数据过大，无法一次性读入内存，大小:" << getSizeHint();
+        return false;
+    }
+
+    arrOutput.clear();
+    arrOutput.reserve(static_cast<int>(getSizeHint()));
+    if (!open())
+    {
+        return false;
+    }
+    while (!isAtEnd())
+    {
+        // 文本转义后可能超过估计值，每块之后再检查一次
+        if (!readChunk(arrOutput) || arrOutput.size() > kMaxBufferedBytes)
+        {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
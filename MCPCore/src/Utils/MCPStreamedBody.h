@@ -0,0 +1,86 @@
+/**
+ * @file MCPStreamedBody.h
+ * @brief 包含大文件流式内容的响应数据（按块输出）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QByteArray>
+#include <QList>
+#include <QSharedPointer>
+
+class MCPStreamedFileContent;
+
+/**
+ * @brief 包含大文件流式内容的响应数据
+ *
+ * 职责：
+ * - 按占位符把已序列化的响应JSON切成若干片段，与各流式内容交替输出
+ * - 每次只输出一个JSON片段或一块编码后的文件内容，响应数据不在内存中完整出现
+ *
+ * 使用说明：
+ * - 由MCPServerMessage::createStreamedBody()创建，传输层边写边调用readChunk()
+ * - open()时检查所有文件都能打开，此时尚未输出任何数据，失败可改为回复错误；
+ *   文件在读到时才保持打开，读完即关闭，同时只占用一个文件句柄
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPStreamedBody
+{
+public:
+    // readAll()允许的最大数据量，超出后不再一次性读入内存
+    static const int kMaxBufferedBytes = 1024 * 1024 * 1024;
+
+public:
+    /**
+     * @param arrData 已序列化的响应数据（包含占位符）
+     * @param lstContents 流式内容列表（数据中找不到占位符的忽略）
+     */
+    MCPStreamedBody(const QByteArray& arrData, const QList<QSharedPointer<MCPStreamedFileContent>>& lstContents);
+    ~MCPStreamedBody();
+
+public:
+    /**
+     * @brief 检查所有文件都能打开，从头开始输出
+     * @return 任一文件无法打开时返回false
+     */
+    bool open();
+
+    /**
+     * @brief 关闭正在读取的文件（中途放弃输出时调用，析构时自动调用）
+     */
+    void close();
+
+    /**
+     * @brief 读取下一段（一个JSON片段或一块编码后的文件内容），追加到arrOutput
+     * @return 文件读取失败时返回false，此时已输出的数据不完整
+     * @note 追加的数据可能为空（如相邻占位符之间的空片段），以isAtEnd()判断是否结束
+     */
+    bool readChunk(QByteArray& arrOutput);
+
+    /**
+     * @brief 是否已全部输出
+     */
+    bool isAtEnd() const;
+
+    /**
+     * @brief 获取数据大小的估计值（用于日志）
+     */
+    qint64 getSizeHint() const;
+
+    /**
+     * @brief 一次性读取全部数据（不经过分块写出时使用）
+     * @return 文件读取失败或数据超过kMaxBufferedBytes时返回false
+     */
+    bool readAll(QByteArray& arrOutput);
+
+private:
+    QList<QByteArray> m_lstSegments;                                // 占位符两侧的JSON片段，比流式内容多一个
+    QList<QSharedPointer<MCPStreamedFileContent>> m_lstContents;    // 按占位符出现顺序排列
+    int m_nNextSegment;                                             // 下一个输出的JSON片段下标
+    bool m_bInContent;                                              // 正在输出片段m_nNextSegment之前的流式内容
+};
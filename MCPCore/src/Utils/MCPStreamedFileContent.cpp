@@ -0,0 +1,310 @@
+/**
+ * @file MCPStreamedFileContent.cpp
+ * @brief MCP大文件流式内容实现
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#include "MCPStreamedFileContent.h"
+#include "MCPBase64Encoder.h"
+#include "MCPLog/MCPLog.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QUuid>
+#include <cstring>
+
+const int MCPStreamedFileContent::kChunkBytes;
+
+MCPStreamedFileContent::MCPStreamedFileContent(const QString& strFilePath, Encoding enEncoding)
+    : m_strFilePath(strFilePath)
+    , m_enEncoding(enEncoding)
+    , m_placeholder("mcp-streamed-content-" + QUuid::createUuid().toByteArray().mid(1, 36))
+    , m_nFileSize(QFileInfo(strFilePath).size())
+    , m_pMapped(nullptr)
+    , m_nOpenedSize(0)
+    , m_nOffset(0)
+    , m_bSkipBom(false)
+    , m_bAtEnd(false)
+{
+}
+
+MCPStreamedFileContent::~MCPStreamedFileContent()
+{
+    close();
+}
+
+const QByteArray& MCPStreamedFileContent::getPlaceholder() const
+{
+    return m_placeholder;
+}
+
+qint64 MCPStreamedFileContent::getEncodedSizeHint() const
+{
+    if (m_enEncoding == Encoding::Base64)
+    {
+        return (m_nFileSize + 2) / 3 * 4;
+    }
+    return m_nFileSize;
+}
+
+bool MCPStreamedFileContent::open()
+{
+    close();
+    m_pFile.reset(new QFile(m_strFilePath));
+    if (!m_pFile->open(QIODevice::ReadOnly))
+    {
+        MCP_CORE_LOG_WARNING() << "MCPStreamedFileContent: 无法打开文件:" << m_strFilePath
+                               << ", 错误:" << m_pFile->errorString();
+        m_pFile.reset();
+        return false;
+    }
+
+    m_nOpenedSize = m_pFile->size();
+    m_nOffset = 0;
+    m_bSkipBom = (m_enEncoding == Encoding::JsonText);
+    m_bAtEnd = false;
+    // 优先整体映射，由操作系统按页换入；无法映射时（特殊文件系统等）退化为分块读取
+    m_pMapped = m_nOpenedSize > 0 ? reinterpret_cast<const char*>(m_pFile->map(0, m_nOpenedSize)) : nullptr;
+    if (m_nOpenedSize == 0)
+    {
+        close();
+        m_bAtEnd = true;
+    }
+    return true;
+}
+
+void MCPStreamedFileContent::close()
+{
+    if (m_pFile == nullptr)
+    {
+        return;
+    }
+    if (m_pMapped != nullptr)
+    {
+        m_pFile->unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_pMapped)));
+        m_pMapped = nullptr;
+    }
+    m_pFile.reset();
+}
+
+bool MCPStreamedFileContent::readChunk(QByteArray& arrOutput)
+{
+    if (m_bAtEnd)
+    {
+        return true;
+    }
+    if (m_pFile == nullptr)
+    {
+        return false;
+    }
+
+    const char* pChunk = nullptr;
+    qint64 nChunkSize = qMin<qint64>(kChunkBytes, m_nOpenedSize - m_nOffset);
+    QByteArray arrChunk;
+    if (m_pMapped != nullptr)
+    {
+        pChunk = m_pMapped + m_nOffset;
+    }
+    else
+    {
+        arrChunk = m_pFile->read(nChunkSize);
+        if (arrChunk.isEmpty())
+        {
+            // 读取中途失败或文件被截断，不继续输出
+            MCP_CORE_LOG_WARNING() << "MCPStreamedFileContent: 读取文件失败:" << m_strFilePath
+                                   << ", 已读取:" << m_nOffset << "/" << m_nOpenedSize
+                                   << ", 错误:" << m_pFile->errorString();
+            close();
+            return false;
+        }
+        pChunk = arrChunk.constData();
+        nChunkSize = arrChunk.size();
+    }
+
+    if (m_bSkipBom)
+    {
+        // 与QTextStream读取文本时一致，去掉UTF-8 BOM
+        m_bSkipBom = false;
+        if (nChunkSize >= 3 && memcmp(pChunk, "\xEF\xBB\xBF", 3) == 0)
+        {
+            pChunk += 3;
+            nChunkSize -= 3;
+            m_nOffset += 3;
+        }
+    }
+
+    if (m_enEncoding == Encoding::Base64)
+    {
+        if (!appendBase64(pChunk, nChunkSize, arrOutput))
+        {
+            MCP_CORE_LOG_WARNING() << "MCPStreamedFileContent: 编码结果超过缓冲区上限:" << m_strFilePath;
+            close();
+            return false;
+        }
+        m_nOffset += nChunkSize;
+    }
+    else
+    {
+        // 末尾不完整的UTF-8序列留给下一块，分块读取时文件位置退回到未处理的字节
+        const bool bFinal = (m_nOffset + nChunkSize >= m_nOpenedSize) || nChunkSize < 4;
+        const qint64 nConsumed = appendJsonEscaped(pChunk, nChunkSize, bFinal, arrOutput);
+        m_nOffset += nConsumed;
+        if (m_pMapped == nullptr && nConsumed < nChunkSize)
+        {
+            m_pFile->seek(m_nOffset);
+        }
+    }
+
+    if (m_nOffset >= m_nOpenedSize)
+    {
+        // 读完后立即释放文件句柄和映射，不等响应对象销毁
+        close();
+        m_bAtEnd = true;
+    }
+    return true;
+}
+
+bool MCPStreamedFileContent::isAtEnd() const
+{
+    return m_bAtEnd;
+}
+
+bool MCPStreamedFileContent::appendBase64(const char* pData, qint64 nSize, QByteArray& arrOutput)
+{
+    // 输入块是3的倍数（最后一块除外），各块独立编码后直接拼接即为完整的Base64；
+    // 直接编码到输出缓冲区末尾，不产生临时QByteArray
+    return MCPBase64Encoder::append(pData, nSize, arrOutput);
+}
+
+qint64 MCPStreamedFileContent::appendJsonEscaped(const char* pData, qint64 nSize, bool bFinal, QByteArray& arrOutput)
+{
+    static const char kHexDigits[] = "0123456789abcdef";
+    const char* pRunStart = pData;
+    const char* pEnd = pData + nSize;
+    const char* p = pData;
+    while (p < pEnd)
+    {
+        const unsigned char ch = static_cast<unsigned char>(*p);
+        if (ch >= 0x20 && ch < 0x80 && ch != '"' && ch != '\\')
+        {
+            ++p;
+            continue;
+        }
+
+        if (ch >= 0x80)
+        {
+            const int nLength = utf8SequenceLength(reinterpret_cast<const unsigned char*>(p),
+                                                   reinterpret_cast<const unsigned char*>(pEnd));
+            if (nLength > 0)
+            {
+                // 有效的多字节序列原样保留在整段中
+                p += nLength;
+                continue;
+            }
+            if (nLength < 0 && !bFinal)
+            {
+                // 序列跨越块边界，留给下一块
+                break;
+            }
+
+            // 无效字节替换为U+FFFD，从下一个字节继续（与QString::fromUtf8()一致）
+            arrOutput.append(pRunStart, static_cast<int>(p - pRunStart));
+            arrOutput.append("\xEF\xBF\xBD", 3);
+            pRunStart = ++p;
+            continue;
+        }
+
+        // 先整段追加无需转义的字节（包括UTF-8多字节序列）
+        arrOutput.append(pRunStart, static_cast<int>(p - pRunStart));
+        pRunStart = p + 1;
+        switch (ch)
+        {
+        case '"':
+            arrOutput.append("\\\"", 2);
+            break;
+        case '\\':
+            arrOutput.append("\\\\", 2);
+            break;
+        case '\n':
+            arrOutput.append("\\n", 2);
+            break;
+        case '\r':
+            arrOutput.append("\\r", 2);
+            break;
+        case '\t':
+            arrOutput.append("\\t", 2);
+            break;
+        case '\b':
+            arrOutput.append("\\b", 2);
+            break;
+        case '\f':
+            arrOutput.append("\\f", 2);
+            break;
+        default:
+        {
+            const char arrEscape[6] = { '\\', 'u', '0', '0', kHexDigits[ch >> 4], kHexDigits[ch & 0x0F] };
+            arrOutput.append(arrEscape, 6);
+            break;
+        }
+        }
+        ++p;
+    }
+    arrOutput.append(pRunStart, static_cast<int>(p - pRunStart));
+    return p - pData;
+}
+
+int MCPStreamedFileContent::utf8SequenceLength(const unsigned char* pData, const unsigned char* pEnd)
+{
+    // 第二个字节的取值范围随首字节收窄，排除过长编码（E0、F0）、代理项（ED）和超出U+10FFFF的码点（F4）
+    const unsigned char ch = pData[0];
+    int nLength = 0;
+    unsigned char chSecondMin = 0x80;
+    unsigned char chSecondMax = 0xBF;
+    if (ch >= 0xC2 && ch <= 0xDF)
+    {
+        nLength = 2;
+    }
+    else if (ch >= 0xE0 && ch <= 0xEF)
+    {
+        nLength = 3;
+        if (ch == 0xE0)
+        {
+            chSecondMin = 0xA0;
+        }
+        else if (ch == 0xED)
+        {
+            chSecondMax = 0x9F;
+        }
+    }
+    else if (ch >= 0xF0 && ch <= 0xF4)
+    {
+        nLength = 4;
+        if (ch == 0xF0)
+        {
+            chSecondMin = 0x90;
+        }
+        else if (ch == 0xF4)
+        {
+            chSecondMax = 0x8F;
+        }
+    }
+    else
+    {
+        return 0;
+    }
+
+    for (int i = 1; i < nLength; ++i)
+    {
+        if (pData + i >= pEnd)
+        {
+            return -1;
+        }
+        const unsigned char chNext = pData[i];
+        if (chNext < (i == 1 ? chSecondMin : 0x80) || chNext > (i == 1 ? chSecondMax : 0xBF))
+        {
+            return 0;
+        }
+    }
+    return nLength;
+}
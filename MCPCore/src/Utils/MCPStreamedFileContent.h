@@ -0,0 +1,116 @@
+/**
+ * @file MCPStreamedFileContent.h
+ * @brief MCP大文件流式内容（序列化响应时直接写入）
+ * @author zhangheng
+ * @date 2025-01-09
+ * @copyright Copyright (c) 2025 zhangheng. All rights reserved.
+ */
+
+#pragma once
+#include <QString>
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QScopedPointer>
+
+class QFile;
+
+/**
+ * @brief MCP大文件流式内容
+ *
+ * 职责：
+ * - 代替大文件资源的完整内容放入响应JSON，JSON中只保留一个占位字符串
+ * - 发送响应时通过内存映射（mmap）读取文件，每次只编码一块，由传输层边编码边写出
+ * - 二进制文件分块Base64编码，文本文件保持UTF-8字节只做JSON转义，不经过QString；
+ *   无效的UTF-8字节与QString::fromUtf8()一致，逐字节替换为U+FFFD
+ *
+ * 使用说明：
+ * - 由MCPServerMessage::attachStreamedContents()挂到响应消息上，经MCPStreamedBody按块输出
+ * - 编码在发送响应的连接线程中进行，不占用服务线程
+ * - 读取状态保存在对象内，同一时刻只能有一个读取者；open()从头开始重新读取
+ *
+ * 编码规范：
+ * - 类成员添加 m_ 前缀
+ * - 字符串类型添加 str 前缀
+ * - { 和 } 要单独一行
+ */
+class MCPStreamedFileContent
+{
+public:
+    /**
+     * @brief 内容编码方式
+     */
+    enum class Encoding
+    {
+        Base64,     // blob字段：Base64编码
+        JsonText    // text字段：UTF-8原样输出，仅做JSON字符串转义
+    };
+
+    // 每次编码的输入块大小（3的倍数，Base64输出不需要跨块填充）
+    static const int kChunkBytes = 48 * 1024;
+
+public:
+    MCPStreamedFileContent(const QString& strFilePath, Encoding enEncoding);
+    ~MCPStreamedFileContent();
+
+public:
+    /**
+     * @brief 获取占位符（只含ASCII字母数字和'-'，JSON中无需转义）
+     */
+    const QByteArray& getPlaceholder() const;
+
+    /**
+     * @brief 获取编码后大小的估计值（Base64为精确值，文本不计转义）
+     */
+    qint64 getEncodedSizeHint() const;
+
+    /**
+     * @brief 打开文件（优先整体映射），从头开始读取
+     * @return 文件无法打开时返回false
+     */
+    bool open();
+
+    /**
+     * @brief 关闭文件并释放映射（读完最后一块时自动关闭）
+     */
+    void close();
+
+    /**
+     * @brief 读取下一块（最多kChunkBytes字节输入），编码后追加到arrOutput（不含两侧引号）
+     * @return 读取失败（包括读到的内容比文件大小短）时返回false，此时已输出的内容不完整
+     */
+    bool readChunk(QByteArray& arrOutput);
+
+    /**
+     * @brief 是否已读完（未打开时为false）
+     */
+    bool isAtEnd() const;
+
+private:
+    static bool appendBase64(const char* pData, qint64 nSize, QByteArray& arrOutput);
+
+    /**
+     * @brief JSON转义并校验UTF-8后追加
+     * @param bFinal 是否为文件的最后一块，不是时末尾不完整的UTF-8序列留给下一块
+     * @return 已处理的字节数
+     */
+    static qint64 appendJsonEscaped(const char* pData, qint64 nSize, bool bFinal, QByteArray& arrOutput);
+
+    /**
+     * @brief 检查UTF-8多字节序列（拒绝过长编码、代理项和超出U+10FFFF的码点）
+     * @return 有效序列的字节数；无效返回0；数据在序列结束前截断返回-1
+     */
+    static int utf8SequenceLength(const unsigned char* pData, const unsigned char* pEnd);
+
+private:
+    QString m_strFilePath;
+    Encoding m_enEncoding;
+    QByteArray m_placeholder;
+    qint64 m_nFileSize;
+    // 读取状态
+    QScopedPointer<QFile> m_pFile;
+    const char* m_pMapped;      // 整体映射的起始地址，无法映射时为空（分块读取）
+    qint64 m_nOpenedSize;       // 打开时的文件大小
+    qint64 m_nOffset;           // 已处理的字节数
+    bool m_bSkipBom;            // 第一块是否需要去掉UTF-8 BOM
+    bool m_bAtEnd;
+};